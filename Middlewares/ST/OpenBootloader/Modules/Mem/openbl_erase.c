@@ -0,0 +1,170 @@
+/**
+  ******************************************************************************
+  * @file    openbl_erase.c
+  * @author  MCD Application Team
+  * @brief   Provides the external memory erase planner.
+  *          From the ranges of the partitions to be programmed, the planner
+  *          chooses between chip erase and sector erase, based on the
+  *          typical erase durations of the memory, and estimates the erase
+  *          time reported to the host.
+  *          Only the sectors of the ranges are erased, a chip erase is used
+  *          only when the ranges cover the whole memory.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "openbl_erase.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+#define ALIGN_DOWN(addr, size)            (EXT_MEMORY_START_ADDRESS + ((((addr) - EXT_MEMORY_START_ADDRESS) / (size)) * (size)))
+#define ALIGN_UP(addr, size)              ALIGN_DOWN((addr) + (size) - 1U, (size))
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function plans the erase of external memory ranges.
+  * @param  Ranges Pointer to the ranges to be erased, in any order.
+  * @param  Count Number of ranges.
+  * @param  Plan Pointer to the returned erase plan.
+  * @retval SUCCESS if all the ranges are in the external memory else ERROR.
+  */
+ErrorStatus OPENBL_ERASE_Plan(OPENBL_EraseRange_TypeDef *Ranges, uint32_t Count, OPENBL_ErasePlan_TypeDef *Plan)
+{
+  OPENBL_EraseRange_TypeDef range;
+  uint32_t idx;
+  uint32_t pos;
+
+  memset(Plan, 0, sizeof(OPENBL_ErasePlan_TypeDef));
+
+  if (Count > PHASE_LAST_USER)
+  {
+    return ERROR;
+  }
+
+  /* Align the ranges on sectors and sort them by start address */
+  for (idx = 0U; idx < Count; idx++)
+  {
+    if (Ranges[idx].End <= Ranges[idx].Start)
+    {
+      continue;
+    }
+
+    if ((Ranges[idx].Start < EXT_MEMORY_START_ADDRESS) || (Ranges[idx].End > EXT_MEMORY_END_ADDRESS))
+    {
+      return ERROR;
+    }
+
+    range.Start = ALIGN_DOWN(Ranges[idx].Start, SECTOR_SIZE);
+    range.End   = ALIGN_UP(Ranges[idx].End, SECTOR_SIZE);
+
+    for (pos = Plan->RangeCount; (pos > 0U) && (Plan->Range[pos - 1U].Start > range.Start); pos--)
+    {
+      Plan->Range[pos] = Plan->Range[pos - 1U];
+    }
+
+    Plan->Range[pos] = range;
+    Plan->RangeCount++;
+  }
+
+  /* Merge overlapping and adjacent ranges */
+  for (idx = 1U, pos = 0U; idx < Plan->RangeCount; idx++)
+  {
+    if (Plan->Range[idx].Start <= Plan->Range[pos].End)
+    {
+      if (Plan->Range[idx].End > Plan->Range[pos].End)
+      {
+        Plan->Range[pos].End = Plan->Range[idx].End;
+      }
+    }
+    else
+    {
+      Plan->Range[++pos] = Plan->Range[idx];
+    }
+  }
+
+  if (Plan->RangeCount > 0U)
+  {
+    Plan->RangeCount = pos + 1U;
+  }
+
+  /* The external loader erases the ranges sector by sector */
+  for (idx = 0U; idx < Plan->RangeCount; idx++)
+  {
+    Plan->SectorCount += (Plan->Range[idx].End - Plan->Range[idx].Start) / SECTOR_SIZE;
+  }
+
+  Plan->Time = Plan->SectorCount * SECTOR_ERASE_TIME;
+
+  /* Chip erase only if nothing outside the ranges has to be kept */
+  if ((Plan->RangeCount == 1U) && (Plan->Range[0].Start == EXT_MEMORY_START_ADDRESS)
+      && (Plan->Range[0].End == EXT_MEMORY_END_ADDRESS) && (CHIP_ERASE_TIME < Plan->Time))
+  {
+    Plan->ChipErase = true;
+    Plan->Time      = CHIP_ERASE_TIME;
+  }
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  This function executes an erase plan.
+  * @param  Plan Pointer to the erase plan.
+  * @retval None.
+  */
+void OPENBL_ERASE_Execute(OPENBL_ErasePlan_TypeDef *Plan)
+{
+  uint32_t idx;
+
+  if (Plan->ChipErase)
+  {
+    OPENBL_MEM_MassErase(EXT_MEMORY_START_ADDRESS);
+    return;
+  }
+
+  /* Erase end addresses are inclusive, as for the external loaders */
+  for (idx = 0U; idx < Plan->RangeCount; idx++)
+  {
+    OPENBL_MEM_SectorErase(Plan->Range[idx].Start, Plan->Range[idx].Start, Plan->Range[idx].End - 1U);
+  }
+}
+
+/**
+  * @brief  This function checks if an address is erased by an erase plan.
+  * @param  Plan Pointer to the erase plan.
+  * @param  Address The address to be checked.
+  * @retval true if the address is erased by the plan.
+  */
+bool OPENBL_ERASE_IsErased(OPENBL_ErasePlan_TypeDef *Plan, uint32_t Address)
+{
+  uint32_t idx;
+
+  if (Plan->ChipErase)
+  {
+    return true;
+  }
+
+  for (idx = 0U; idx < Plan->RangeCount; idx++)
+  {
+    if ((Address >= Plan->Range[idx].Start) && (Address < Plan->Range[idx].End))
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
@@ -0,0 +1,52 @@
+/**
+  ******************************************************************************
+  * @file    openbl_erase.h
+  * @author  MCD Application Team
+  * @brief   Header for openbl_erase.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef OPENBL_ERASE_H
+#define OPENBL_ERASE_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include "openbl_mem.h"
+#include "openbl_util.h"
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct
+{
+  uint32_t Start;                     /* First address of the range */
+  uint32_t End;                       /* First address after the range */
+} OPENBL_EraseRange_TypeDef;
+
+typedef struct
+{
+  OPENBL_EraseRange_TypeDef Range[PHASE_LAST_USER]; /* Sector aligned, sorted and merged ranges */
+  uint32_t RangeCount;
+  bool     ChipErase;                 /* Whole memory erased at once */
+  uint32_t SectorCount;               /* Number of sectors erased */
+  uint32_t Time;                      /* Estimated erase time in ms */
+} OPENBL_ErasePlan_TypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+ErrorStatus OPENBL_ERASE_Plan(OPENBL_EraseRange_TypeDef *Ranges, uint32_t Count, OPENBL_ErasePlan_TypeDef *Plan);
+void OPENBL_ERASE_Execute(OPENBL_ErasePlan_TypeDef *Plan);
+bool OPENBL_ERASE_IsErased(OPENBL_ErasePlan_TypeDef *Plan, uint32_t Address);
+
+#endif /* OPENBL_ERASE_H */
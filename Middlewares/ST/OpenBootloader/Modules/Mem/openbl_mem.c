@@ -19,6 +19,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "openbl_mem.h"
 #include "openbl_core.h"
+#include "openbl_util.h"
 
 #include "interfaces_conf.h"
 
@@ -28,6 +29,7 @@
 /* Private variables ---------------------------------------------------------*/
 static uint32_t NumberOfMemories = 0;
 static OPENBL_MemoryTypeDef a_MemoriesTable[MEMORIES_SUPPORTED];
+static uint8_t MemReadBlockBuf[MEM_READ_BLOCK_SIZE];
 
 /* Private function prototypes -----------------------------------------------*/
 /* Exported variables --------------------------------------------------------*/
@@ -50,6 +52,7 @@ ErrorStatus OPENBL_MEM_RegisterMemory(OPENBL_MemoryTypeDef *Memory)
     a_MemoriesTable[NumberOfMemories].Type              = Memory->Type;
     a_MemoriesTable[NumberOfMemories].Init              = Memory->Init;
     a_MemoriesTable[NumberOfMemories].Read              = Memory->Read;
+    a_MemoriesTable[NumberOfMemories].ReadBlock         = Memory->ReadBlock;
     a_MemoriesTable[NumberOfMemories].Write             = Memory->Write;
     a_MemoriesTable[NumberOfMemories].JumpToAddress     = Memory->JumpToAddress;
     a_MemoriesTable[NumberOfMemories].MassErase         = Memory->MassErase;
@@ -165,6 +168,176 @@ uint8_t OPENBL_MEM_Read(uint32_t Address, uint32_t MemoryIndex)
   return value;
 }
 
+/**
+  * @brief  This function is used to read a block of data from a given memory.
+  *         Memories without block read operation are read byte per byte.
+  * @param  Address The address where the data will be read.
+  * @param  Data Pointer to the buffer receiving the data.
+  * @param  DataLength The length of the data to be read.
+  * @retval None.
+  */
+void OPENBL_MEM_ReadBlock(uint32_t Address, uint8_t *Data, uint32_t DataLength)
+{
+  uint32_t index;
+  uint32_t counter;
+
+  /* Get the memory index to know from which memory we will read */
+  index = OPENBL_MEM_GetMemoryIndex(Address);
+
+  if (index < NumberOfMemories)
+  {
+    if (a_MemoriesTable[index].ReadBlock != NULL)
+    {
+      a_MemoriesTable[index].ReadBlock(Address, Data, DataLength);
+    }
+    else
+    {
+      for (counter = 0U; counter < DataLength; counter++)
+      {
+        Data[counter] = OPENBL_MEM_Read(Address + counter, index);
+      }
+    }
+  }
+}
+
+/**
+  * @brief  This function computes the CRC-32 of a memory range.
+  *         The range is read back in blocks of MEM_READ_BLOCK_SIZE bytes.
+  * @param  Address The start address of the range.
+  * @param  DataLength The length of the range.
+  * @retval CRC-32 of the range.
+  */
+uint32_t OPENBL_MEM_ComputeCrc32(uint32_t Address, uint32_t DataLength)
+{
+  uint32_t crc = 0U;
+  uint32_t length;
+
+  while (DataLength > 0U)
+  {
+    length = (DataLength > MEM_READ_BLOCK_SIZE) ? MEM_READ_BLOCK_SIZE : DataLength;
+
+    OPENBL_MEM_ReadBlock(Address, MemReadBlockBuf, length);
+    crc = CRC32_Util_Compute(crc, MemReadBlockBuf, length);
+
+    Address    += length;
+    DataLength -= length;
+  }
+
+  return crc;
+}
+
+/**
+  * @brief  This function checks if the received data are a digest record.
+  * @param  pRecord Pointer to the received data.
+  * @param  Length Length of the received data.
+  * @retval SET if the data start with the digest record magic else RESET.
+  */
+FlagStatus OPENBL_MEM_IsDigestRecord(uint8_t *pRecord, uint32_t Length)
+{
+  uint32_t magic;
+
+  if (Length < MEM_DIGEST_RECORD_SIZE)
+  {
+    return RESET;
+  }
+
+  /* The host buffer is not necessarily word aligned */
+  memcpy(&magic, pRecord, sizeof(magic));
+
+  return (magic == MEM_DIGEST_MAGIC) ? SET : RESET;
+}
+
+/**
+  * @brief  This function starts a digest verify from a digest record sent by the host.
+  * @param  Digest Pointer to the digest context.
+  * @param  Address The start address of the range.
+  * @param  pRecord Pointer to the digest record.
+  * @param  Length Length of the received record.
+  * @retval SUCCESS if the record is valid else ERROR.
+  */
+ErrorStatus OPENBL_MEM_DigestStart(OPENBL_MEM_DigestTypeDef *Digest, uint32_t Address, uint8_t *pRecord, uint32_t Length)
+{
+  uint32_t record[MEM_DIGEST_RECORD_SIZE / 4U];
+
+  if (Length < MEM_DIGEST_RECORD_SIZE)
+  {
+    return ERROR;
+  }
+
+  /* The host buffer is not necessarily word aligned */
+  memcpy(record, pRecord, MEM_DIGEST_RECORD_SIZE);
+
+  if ((record[0] != MEM_DIGEST_MAGIC) || (OPENBL_MEM_GetMemoryIndex(Address) != OPENBL_MEM_GetMemoryIndex(Address + record[1] - 1U)))
+  {
+    return ERROR;
+  }
+
+  OPENBL_MEM_DigestInit(Digest, Address, record[1], record[2]);
+
+  return SUCCESS;
+}
+
+/**
+  * @brief  This function starts a digest verify of a memory range.
+  *         Instead of reading back each programmed packet, a running CRC-32 is
+  *         kept over the programmed data and the whole range is read back once
+  *         when its last byte is programmed.
+  * @param  Digest Pointer to the digest context.
+  * @param  Address The start address of the range.
+  * @param  Size The size of the range, 0 to disable the digest verify.
+  * @param  Crc The CRC-32 of the range computed by the host.
+  * @retval None.
+  */
+void OPENBL_MEM_DigestInit(OPENBL_MEM_DigestTypeDef *Digest, uint32_t Address, uint32_t Size, uint32_t Crc)
+{
+  Digest->Address    = Address;
+  Digest->Size       = Size;
+  Digest->Crc        = Crc;
+  Digest->Received   = 0U;
+  Digest->RunningCrc = 0U;
+}
+
+/**
+  * @brief  This function updates a digest verify with programmed data.
+  *         Data must be given in programming order.
+  * @param  Digest Pointer to the digest context.
+  * @param  Data Pointer to the programmed data.
+  * @param  DataLength The length of the programmed data.
+  * @retval MEM_DIGEST_PENDING until the whole range is programmed, then
+  *         MEM_DIGEST_MATCH or MEM_DIGEST_MISMATCH.
+  */
+uint32_t OPENBL_MEM_DigestUpdate(OPENBL_MEM_DigestTypeDef *Digest, uint8_t *Data, uint32_t DataLength)
+{
+  uint32_t status = MEM_DIGEST_PENDING;
+
+  if (DataLength > (Digest->Size - Digest->Received))
+  {
+    DataLength = Digest->Size - Digest->Received;
+  }
+
+  Digest->RunningCrc = CRC32_Util_Compute(Digest->RunningCrc, Data, DataLength);
+  Digest->Received  += DataLength;
+
+  if (Digest->Received == Digest->Size)
+  {
+    /* The received data and the programmed range must both match the host digest */
+    if ((Digest->RunningCrc == Digest->Crc)
+        && (OPENBL_MEM_ComputeCrc32(Digest->Address, Digest->Size) == Digest->Crc))
+    {
+      status = MEM_DIGEST_MATCH;
+    }
+    else
+    {
+      status = MEM_DIGEST_MISMATCH;
+    }
+
+    /* Digest verify done */
+    Digest->Size = 0U;
+  }
+
+  return status;
+}
+
 /**
   * @brief  This function is used to write data in to a given memory.
   * @param  Address The address where that data will be written.
@@ -32,6 +32,7 @@ typedef struct
   uint32_t Type;
   void (*Init)(uint32_t Address);
   uint8_t (*Read)(uint32_t Address);
+  void (*ReadBlock)(uint32_t Address, uint8_t *Data, uint32_t DataLength);
   void (*Write)(uint32_t Address, uint8_t *Data, uint32_t DataLength);
   void (*JumpToAddress)(uint32_t Address);
   void (*MassErase)(uint32_t Address);
@@ -39,7 +40,26 @@ typedef struct
   uint64_t (*Verify)(uint32_t Address, uint32_t DataAddr, uint32_t DataLength, uint32_t missalignement);
 } OPENBL_MemoryTypeDef;
 
+typedef struct
+{
+  uint32_t Address;                   /* Start address of the verified range */
+  uint32_t Size;                      /* Size announced by the host, 0 when digest verify is off */
+  uint32_t Crc;                       /* CRC-32 announced by the host */
+  uint32_t Received;                  /* Number of bytes programmed so far */
+  uint32_t RunningCrc;                /* CRC-32 of the programmed data */
+} OPENBL_MEM_DigestTypeDef;
+
 /* Exported constants --------------------------------------------------------*/
+#define MEM_READ_BLOCK_SIZE               1024U     /* Size of the blocks used to read back a memory range */
+
+#define PHASE_DIGEST                      0xF5U     /* Digest record phase, announces the digest of the next partition */
+#define MEM_DIGEST_MAGIC                  0x31474453U /* "SDG1" digest record magic */
+#define MEM_DIGEST_RECORD_SIZE            12U       /* Digest record: magic, size and CRC-32, little-endian */
+
+#define MEM_DIGEST_PENDING                0x0U      /* Range not fully programmed yet */
+#define MEM_DIGEST_MATCH                  0x1U      /* Programmed range matches the host digest */
+#define MEM_DIGEST_MISMATCH               0x2U      /* Programmed range does not match the host digest */
+
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
 void OPENBL_MEM_JumpToAddress(uint32_t Address);
@@ -47,6 +67,12 @@ void OPENBL_MEM_Write(uint32_t Address, uint8_t *Data, uint32_t DataLength);
 
 void OPENBL_MEM_Init(uint32_t Address);
 uint8_t OPENBL_MEM_Read(uint32_t Address, uint32_t MemoryIndex);
+void OPENBL_MEM_ReadBlock(uint32_t Address, uint8_t *Data, uint32_t DataLength);
+uint32_t OPENBL_MEM_ComputeCrc32(uint32_t Address, uint32_t DataLength);
+FlagStatus OPENBL_MEM_IsDigestRecord(uint8_t *pRecord, uint32_t Length);
+ErrorStatus OPENBL_MEM_DigestStart(OPENBL_MEM_DigestTypeDef *Digest, uint32_t Address, uint8_t *pRecord, uint32_t Length);
+void OPENBL_MEM_DigestInit(OPENBL_MEM_DigestTypeDef *Digest, uint32_t Address, uint32_t Size, uint32_t Crc);
+uint32_t OPENBL_MEM_DigestUpdate(OPENBL_MEM_DigestTypeDef *Digest, uint8_t *Data, uint32_t DataLength);
 uint32_t OPENBL_MEM_GetAddressArea(uint32_t Address);
 uint32_t OPENBL_MEM_GetMemoryIndex(uint32_t Address);
 uint8_t OPENBL_MEM_CheckJumpAddress(uint32_t Address);
@@ -0,0 +1,414 @@
+/**
+  ******************************************************************************
+  * @file    openbl_stream.c
+  * @author  MCD Application Team
+  * @brief   Provides a streaming session writing several partitions from a
+  *          single data flow.
+  *          The host sends a manifest giving the ID and the size of each
+  *          partition, then the partition data back-to-back. Partition
+  *          boundaries are deduced from the manifest sizes and the target
+  *          moves to the next partition by itself, without GetPhase or
+  *          alternate setting switch between partitions.
+  *          When the manifest gives the CRC-32 of each partition, external
+  *          memory partitions are verified once at partition end instead of
+  *          after each data block.
+  *          External memory partitions are all erased when the manifest is
+  *          received, before any data, following the erase planner choice.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "openbl_stream.h"
+#include "openbl_mem.h"
+#include "openbl_erase.h"
+#include "openbl_util.h"
+
+/* External variables --------------------------------------------------------*/
+extern OPENBL_Flashlayout_TypeDef FlashlayoutStruct;
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static OPENBL_StreamManifestEntry_TypeDef stream_entry[PHASE_LAST_USER];
+static uint32_t stream_entry_count = 0U;
+static uint32_t stream_idx = 0U;
+static uint32_t stream_offset = 0U;
+static uint32_t stream_address = 0U;
+static uint8_t stream_state = STREAM_STATE_IDLE;
+static bool stream_digest = false;
+static OPENBL_MEM_DigestTypeDef stream_digest_ctx;
+static OPENBL_ErasePlan_TypeDef stream_erase_plan;
+
+/* Private function prototypes -----------------------------------------------*/
+static int OPENBL_STREAM_GetPartitionAddress(uint32_t Id, uint32_t *Address);
+static int OPENBL_STREAM_Parse(uint8_t *pManifest, uint32_t Size, OPENBL_StreamManifestEntry_TypeDef *pEntry,
+                               uint32_t *pCount, bool *pDigest, OPENBL_ErasePlan_TypeDef *pPlan);
+static int OPENBL_STREAM_NextPartition(void);
+
+/* Exported functions --------------------------------------------------------*/
+
+/**
+  * @brief  This function is used to start a streaming session.
+  * @param  pManifest Pointer to the manifest sent by the host.
+  * @param  Size Size of the received manifest.
+  * @retval STREAM_OK if the manifest is valid, STREAM_ERROR otherwise.
+  */
+int OPENBL_STREAM_Start(uint8_t *pManifest, uint32_t Size)
+{
+  stream_state = STREAM_STATE_ERROR;
+
+  if (OPENBL_STREAM_Parse(pManifest, Size, stream_entry, &stream_entry_count, &stream_digest,
+                          &stream_erase_plan) != STREAM_OK)
+  {
+    stream_entry_count = 0U;
+    return STREAM_ERROR;
+  }
+
+  /* Erase all the external memory partitions ahead of data reception */
+  if (stream_erase_plan.RangeCount > 0U)
+  {
+    OPENBL_MEM_Init(EXT_MEMORY_START_ADDRESS);
+    OPENBL_ERASE_Execute(&stream_erase_plan);
+  }
+
+  stream_idx = 0U;
+  stream_state = STREAM_STATE_ACTIVE;
+
+  return OPENBL_STREAM_NextPartition();
+}
+
+/**
+  * @brief  This function returns the time taken by the start of a streaming
+  *         session, reported to the host before the manifest is processed.
+  * @param  pManifest Pointer to the manifest sent by the host.
+  * @param  Size Size of the received manifest.
+  * @retval Estimated erase time in ms, 0 if the manifest is not valid.
+  */
+uint32_t OPENBL_STREAM_GetStartTime(uint8_t *pManifest, uint32_t Size)
+{
+  OPENBL_StreamManifestEntry_TypeDef entry[PHASE_LAST_USER];
+  OPENBL_ErasePlan_TypeDef plan;
+  uint32_t count;
+  bool digest;
+
+  if (OPENBL_STREAM_Parse(pManifest, Size, entry, &count, &digest, &plan) != STREAM_OK)
+  {
+    return 0U;
+  }
+
+  return plan.Time;
+}
+
+/**
+  * @brief  This function is used to write streamed data.
+  *         A data block may contain the end of a partition and the start of
+  *         the next one(s).
+  * @param  pData Pointer to the received data.
+  * @param  Size Size of the received data.
+  * @retval STREAM_OK if the data are written, STREAM_ERROR otherwise.
+  */
+int OPENBL_STREAM_Write(uint8_t *pData, uint32_t Size)
+{
+  uint32_t chunk;
+  uint32_t address;
+  uint64_t res;
+
+  if (stream_state != STREAM_STATE_ACTIVE)
+  {
+    return STREAM_ERROR;
+  }
+
+  while (Size > 0U)
+  {
+    if (stream_idx >= stream_entry_count)
+    {
+      /* More data than announced in the manifest */
+      stream_state = STREAM_STATE_ERROR;
+      return STREAM_ERROR;
+    }
+
+    chunk = stream_entry[stream_idx].Size - stream_offset;
+    if (chunk > Size)
+    {
+      chunk = Size;
+    }
+
+    address = stream_address + stream_offset;
+
+    if (OPENBL_MEM_GetAddressArea(address) == EXTERNAL_MEMORY_AREA)
+    {
+      /* Partition already erased by the erase plan */
+      OPENBL_MEM_Write(address, pData, chunk);
+
+      if (stream_digest)
+      {
+        /* The whole partition is read back once its last byte is written */
+        if (OPENBL_MEM_DigestUpdate(&stream_digest_ctx, pData, chunk) == MEM_DIGEST_MISMATCH)
+        {
+          stream_state = STREAM_STATE_ERROR;
+          return STREAM_ERROR;
+        }
+      }
+      else
+      {
+        /* Verify data write to memory */
+        res = OPENBL_MEM_Verify(address, (uint32_t)pData, chunk, 0);
+        if (((uint32_t)res != 0U) && ((uint32_t)res < (address + chunk)))
+        {
+          stream_state = STREAM_STATE_ERROR;
+          return STREAM_ERROR;
+        }
+      }
+    }
+    else
+    {
+      OPENBL_MEM_Write(address, pData, chunk);
+    }
+
+    pData += chunk;
+    Size -= chunk;
+    stream_offset += chunk;
+
+    /* Partition boundary reached, move to the next partition */
+    if (stream_offset == stream_entry[stream_idx].Size)
+    {
+      stream_idx++;
+
+      if (OPENBL_STREAM_NextPartition() != STREAM_OK)
+      {
+        return STREAM_ERROR;
+      }
+    }
+  }
+
+  return STREAM_OK;
+}
+
+/**
+  * @brief  This function returns the phase of the partition being streamed.
+  * @retval Partition ID, PHASE_END once the session is complete.
+  */
+uint8_t OPENBL_STREAM_GetPhase(void)
+{
+  if (stream_idx < stream_entry_count)
+  {
+    return (uint8_t)stream_entry[stream_idx].Id;
+  }
+
+  return PHASE_END;
+}
+
+/**
+  * @brief  This function returns the streaming session state.
+  * @retval STREAM_STATE_x value.
+  */
+uint8_t OPENBL_STREAM_GetState(void)
+{
+  return stream_state;
+}
+
+/**
+  * @brief  This function checks if all the partitions of the manifest are received.
+  * @retval true if the streaming session is complete.
+  */
+bool OPENBL_STREAM_IsComplete(void)
+{
+  return (stream_state == STREAM_STATE_DONE);
+}
+
+/**
+  * @brief  This function checks if a partition was received by a complete
+  *         streaming session, it is then skipped by the per partition phases.
+  * @param  Id Partition ID.
+  * @retval true if the partition is part of the completed manifest.
+  */
+bool OPENBL_STREAM_IsStreamed(uint32_t Id)
+{
+  uint32_t idx;
+
+  if (stream_state != STREAM_STATE_DONE)
+  {
+    return false;
+  }
+
+  for (idx = 0U; idx < stream_entry_count; idx++)
+  {
+    if (stream_entry[idx].Id == Id)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  This function gets the destination address of a flashlayout partition.
+  * @param  Id Partition ID.
+  * @param  Address Pointer to the returned destination address.
+  * @retval STREAM_OK if the partition is found and supported.
+  */
+static int OPENBL_STREAM_GetPartitionAddress(uint32_t Id, uint32_t *Address)
+{
+  uint32_t idx;
+
+  /* First flashlayout entry is the running firmware */
+  for (idx = PHASE_FIRST_USER; idx < FlashlayoutStruct.partsize; idx++)
+  {
+    if (FlashlayoutStruct.id[idx] == Id)
+    {
+      /* Only none, nor are supported */
+      if (!strcmp(FlashlayoutStruct.ip[idx], "none"))
+      {
+        *Address = RAM_WRITE_ADDRESS;
+        return STREAM_OK;
+      }
+      else if (!strcmp(FlashlayoutStruct.ip[idx], "nor"))
+      {
+        /* Several nor partitions can be streamed, each at its flashlayout offset */
+        *Address = EXT_MEMORY_START_ADDRESS + FlashlayoutStruct.offset[idx];
+        return STREAM_OK;
+      }
+      else
+      {
+        return STREAM_ERROR;
+      }
+    }
+  }
+
+  return STREAM_ERROR;
+}
+
+/**
+  * @brief  This function parses a manifest and plans the erase of its external
+  *         memory partitions.
+  * @param  pManifest Pointer to the manifest sent by the host.
+  * @param  Size Size of the received manifest.
+  * @param  pEntry Pointer to the returned entries, PHASE_LAST_USER at most.
+  * @param  pCount Pointer to the returned number of entries.
+  * @param  pDigest Pointer to the returned digest mode.
+  * @param  pPlan Pointer to the returned erase plan.
+  * @retval STREAM_OK if the manifest is valid, STREAM_ERROR otherwise.
+  */
+static int OPENBL_STREAM_Parse(uint8_t *pManifest, uint32_t Size, OPENBL_StreamManifestEntry_TypeDef *pEntry,
+                               uint32_t *pCount, bool *pDigest, OPENBL_ErasePlan_TypeDef *pPlan)
+{
+  OPENBL_StreamManifestHeader_TypeDef header;
+  OPENBL_EraseRange_TypeDef ranges[PHASE_LAST_USER];
+  uint32_t range_count = 0U;
+  uint32_t entry_size;
+  uint32_t address;
+  uint32_t idx;
+
+  if (Size < sizeof(header))
+  {
+    return STREAM_ERROR;
+  }
+
+  /* The host buffer is not necessarily word aligned */
+  memcpy(&header, pManifest, sizeof(header));
+
+  if (header.Magic == STREAM_MANIFEST_MAGIC)
+  {
+    *pDigest = false;
+    entry_size = 2U * sizeof(uint32_t);
+  }
+  else if (header.Magic == STREAM_MANIFEST_DIGEST_MAGIC)
+  {
+    *pDigest = true;
+    entry_size = 3U * sizeof(uint32_t);
+  }
+  else
+  {
+    return STREAM_ERROR;
+  }
+
+  if ((header.EntryCount > PHASE_LAST_USER) || ((sizeof(header) + (header.EntryCount * entry_size)) > Size))
+  {
+    return STREAM_ERROR;
+  }
+
+  for (idx = 0U; idx < header.EntryCount; idx++)
+  {
+    pEntry[idx].Crc = 0U;
+    memcpy(&pEntry[idx], pManifest + sizeof(header) + (idx * entry_size), entry_size);
+  }
+
+  /* Check all the partitions fit in their memory before accepting any data */
+  for (idx = 0U; idx < header.EntryCount; idx++)
+  {
+    if (OPENBL_STREAM_GetPartitionAddress(pEntry[idx].Id, &address) != STREAM_OK)
+    {
+      return STREAM_ERROR;
+    }
+
+    if ((pEntry[idx].Size != 0U)
+        && (OPENBL_MEM_GetMemoryIndex(address) != OPENBL_MEM_GetMemoryIndex(address + pEntry[idx].Size - 1U)))
+    {
+      return STREAM_ERROR;
+    }
+
+    if (OPENBL_MEM_GetAddressArea(address) == EXTERNAL_MEMORY_AREA)
+    {
+      ranges[range_count].Start = address;
+      ranges[range_count].End   = address + pEntry[idx].Size;
+      range_count++;
+    }
+  }
+
+  if (OPENBL_ERASE_Plan(ranges, range_count, pPlan) != SUCCESS)
+  {
+    return STREAM_ERROR;
+  }
+
+  *pCount = header.EntryCount;
+
+  return STREAM_OK;
+}
+
+/**
+  * @brief  This function prepares the next non empty partition of the manifest.
+  * @retval STREAM_OK if done.
+  */
+static int OPENBL_STREAM_NextPartition(void)
+{
+  /* Skip empty partitions */
+  while ((stream_idx < stream_entry_count) && (stream_entry[stream_idx].Size == 0U))
+  {
+    stream_idx++;
+  }
+
+  stream_offset = 0U;
+
+  if (stream_idx >= stream_entry_count)
+  {
+    stream_state = STREAM_STATE_DONE;
+    return STREAM_OK;
+  }
+
+  if (OPENBL_STREAM_GetPartitionAddress(stream_entry[stream_idx].Id, &stream_address) != STREAM_OK)
+  {
+    stream_state = STREAM_STATE_ERROR;
+    return STREAM_ERROR;
+  }
+
+  OPENBL_MEM_DigestInit(&stream_digest_ctx, stream_address, stream_entry[stream_idx].Size, stream_entry[stream_idx].Crc);
+
+  /* Init the external memories */
+  OPENBL_MEM_Init(stream_address);
+
+  return STREAM_OK;
+}
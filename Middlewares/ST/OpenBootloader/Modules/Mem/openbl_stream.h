@@ -0,0 +1,66 @@
+/**
+  ******************************************************************************
+  * @file    openbl_stream.h
+  * @author  MCD Application Team
+  * @brief   Header for openbl_stream.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef OPENBL_STREAM_H
+#define OPENBL_STREAM_H
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Exported types ------------------------------------------------------------*/
+/* Streaming session manifest header, all fields little-endian */
+typedef struct
+{
+  uint32_t Magic;                     /* STREAM_MANIFEST_MAGIC */
+  uint32_t EntryCount;                /* Number of entries following the header */
+} OPENBL_StreamManifestHeader_TypeDef;
+
+/* Streaming session manifest entry, one per partition in stream order */
+typedef struct
+{
+  uint32_t Id;                        /* Partition ID, must be present in the flashlayout */
+  uint32_t Size;                      /* Partition size in bytes */
+  uint32_t Crc;                       /* Partition CRC-32, only with STREAM_MANIFEST_DIGEST_MAGIC */
+} OPENBL_StreamManifestEntry_TypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+#define PHASE_STREAM                         0xF3U               /* Streaming session phase */
+#define STREAM_MANIFEST_MAGIC                0x314D5353U         /* "SSM1" manifest magic, entries are {Id, Size} */
+#define STREAM_MANIFEST_DIGEST_MAGIC         0x324D5353U         /* "SSM2" manifest magic, entries are {Id, Size, Crc} */
+
+#define STREAM_OK                            0
+#define STREAM_ERROR                         -1
+
+#define STREAM_STATE_IDLE                    0x0U                /* No streaming session */
+#define STREAM_STATE_ACTIVE                  0x1U                /* Partitions are being received */
+#define STREAM_STATE_DONE                    0x2U                /* All partitions of the manifest received */
+#define STREAM_STATE_ERROR                   0x3U                /* Session aborted on error */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+int OPENBL_STREAM_Start(uint8_t *pManifest, uint32_t Size);
+int OPENBL_STREAM_Write(uint8_t *pData, uint32_t Size);
+uint32_t OPENBL_STREAM_GetStartTime(uint8_t *pManifest, uint32_t Size);
+uint8_t OPENBL_STREAM_GetPhase(void);
+uint8_t OPENBL_STREAM_GetState(void);
+bool OPENBL_STREAM_IsComplete(void);
+bool OPENBL_STREAM_IsStreamed(uint32_t Id);
+
+#endif /* OPENBL_STREAM_H */
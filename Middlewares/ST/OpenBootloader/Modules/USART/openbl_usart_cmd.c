@@ -18,6 +18,8 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "openbl_mem.h"
+#include "openbl_stream.h"
+#include "openbl_erase.h"
 #include "openbl_usart_cmd.h"
 #include "openbootloader_conf.h"
 #include "app_openbootloader.h"
@@ -56,12 +58,16 @@ static uint8_t operation;
 static uint32_t packet_number = 0;
 static bool is_fl = true;
 static uint32_t cur_part = 1;
+static uint32_t stream_packet = 0;
+static OPENBL_MEM_DigestTypeDef Digest;
 static OPENBL_Otp_TypeDef Otp;
 static uint32_t otp_idx_rp = 0;
 static uint32_t otp_idx_wm = 0;
 static bool     otp_write_done = false;
+static uint32_t otp_stats[OTP_STATS_RECORD_SIZE];
+static uint32_t otp_stats_idx = OTP_STATS_RECORD_SIZE;
 #ifdef USE_HASH_OVER_OTP
-static uint32_t hash_sent = 0U;
+static uint32_t hash_idx = 0U;
 #endif /* USE_HASH_OVER_OTP */
 /* Private function prototypes -----------------------------------------------*/
 static void OPENBL_USART_GetCommand(void);
@@ -111,7 +117,7 @@ static void OPENBL_USART_GetCommand(void)
   otp_idx_rp = 0;
 
 #ifdef USE_HASH_OVER_OTP
-  hash_sent = 0;
+  hash_idx = 0;
 #endif /* USE_HASH_OVER_OTP */
 
   const uint8_t a_OPENBL_USART_CommandsList[OPENBL_USART_COMMANDS_NB] =
@@ -200,6 +206,12 @@ static void OPENBL_USART_GetPhase(void)
   }
   else /* Other phase and after flashlayout parsing */
   {
+    /* Partitions already received by a streaming session are skipped */
+    while ((cur_part < FlashlayoutStruct.partsize) && OPENBL_STREAM_IsStreamed(FlashlayoutStruct.id[cur_part]))
+    {
+      cur_part++;
+    }
+
     /* Check if there is available partition */
     if (cur_part < FlashlayoutStruct.partsize)
     {
@@ -225,6 +237,9 @@ static void OPENBL_USART_GetPhase(void)
       /* Go to the next partition */
       cur_part++;
 
+      /* Per packet verify until a digest is announced for this partition */
+      OPENBL_MEM_DigestInit(&Digest, destination, 0U, 0U);
+
       /* Init the external memories */
       OPENBL_MEM_Init(destination);
     }
@@ -319,7 +334,10 @@ static void OPENBL_USART_Download(void)
   uint8_t *ramaddress;
   uint8_t data;
   uint32_t res;
+  int status;
   uint32_t offset = 0;
+  OPENBL_EraseRange_TypeDef range;
+  OPENBL_ErasePlan_TypeDef plan;
 
   OPENBL_USART_SendByte(ACK_BYTE);
 
@@ -362,8 +380,25 @@ static void OPENBL_USART_Download(void)
     }
     else
     {
+      /* If otp read mode record, selects fast shadow or authoritative reload reads,
+         or otp statistics record, resets the programming statistics */
+      if ((operation == PHASE_OTP) && (packet_number == 0)
+          && ((OPENBL_OTP_ReadModeRecord(USART_RAM_Buf, codesize) == OTP_OK)
+              || (OPENBL_OTP_StatsRecord(USART_RAM_Buf, codesize) == OTP_OK)))
+      {
+        /* Nothing to program */
+      }
+      /* If otp delta record, accepted while no full otp structure is being received */
+      else if ((operation == PHASE_OTP) && (otp_idx_wm == 0)
+               && ((status = OPENBL_OTP_DeltaRecord(USART_RAM_Buf, codesize)) != OTP_RECORD_NONE))
+      {
+        if (status != OTP_OK)
+        {
+          OPENBL_USART_SendByte(NACK_BYTE);
+        }
+      }
       /* If otp operation */
-      if (operation == PHASE_OTP)
+      else if (operation == PHASE_OTP)
       {
 
         /* If first otp packet */
@@ -400,19 +435,76 @@ static void OPENBL_USART_Download(void)
         /* Write otp since otp structure is full */
         if (otp_idx_wm == OTP_PART_SIZE)
         {
-          OPENBL_OTP_Write(Otp);
+          OPENBL_OTP_Write(&Otp);
           /* no need to make read write pointers zero as we make them zero at packet_number equal to 0*/
           otp_write_done = true;
 #ifdef USE_HASH_OVER_OTP
-          hash_sent = 0;
+          hash_idx = 0;
 #endif /* USE_HASH_OVER_OTP */
         }
       }
+      /* If pmic refresh record, the next read is done on the bus instead of the cache */
+      else if ((operation == PHASE_PMIC_NVM) && (packet_number == 0)
+               && (OPENBL_PMIC_RefreshRecord(USART_RAM_Buf, codesize) == PMIC_ERROR_NONE))
+      {
+        OPENBL_USART_SendByte(ACK_BYTE);
+      }
       else if (operation == PHASE_PMIC_NVM)
       {
-        OPENBL_PMIC_Write(USART_RAM_Buf);
+        if (OPENBL_PMIC_Write(USART_RAM_Buf) != PMIC_ERROR_NONE)
+        {
+          OPENBL_USART_SendByte(NACK_BYTE);
+        }
+        else
+        {
+          OPENBL_USART_SendByte(ACK_BYTE);
+        }
+      }
+      else if (operation == PHASE_STREAM)
+      {
+        /* First packet of a streaming session is the manifest, next ones are partitions data */
+        if (packet_number == 0)
+        {
+          status = OPENBL_STREAM_Start(USART_RAM_Buf, codesize);
+          stream_packet = 1U;
+        }
+        /* Data packets are written in sequence, an out of order or duplicated packet is rejected */
+        else if (packet_number != stream_packet)
+        {
+          status = STREAM_ERROR;
+        }
+        else
+        {
+          status = OPENBL_STREAM_Write(USART_RAM_Buf, codesize);
+          stream_packet++;
+        }
 
-        OPENBL_USART_SendByte(ACK_BYTE);
+        if (status != STREAM_OK)
+        {
+          OPENBL_USART_SendByte(NACK_BYTE);
+        }
+      }
+      else if (operation == PHASE_DIGEST)
+      {
+        /* Digest of the partition to be downloaded, replaces the per packet verify */
+        if (OPENBL_MEM_DigestStart(&Digest, destination, USART_RAM_Buf, codesize) != SUCCESS)
+        {
+          OPENBL_USART_SendByte(NACK_BYTE);
+        }
+        else if (OPENBL_MEM_GetAddressArea(destination) == EXTERNAL_MEMORY_AREA)
+        {
+          /* Partition size is known, erase it ahead of data reception */
+          range.Start = destination;
+          range.End   = destination + Digest.Size;
+
+          if (OPENBL_ERASE_Plan(&range, 1U, &plan) == SUCCESS)
+          {
+            OPENBL_ERASE_Execute(&plan);
+
+            /* Skip the per packet sector erase */
+            last_sector = ((range.End - 1U - EXT_MEMORY_START_ADDRESS) / SECTOR_SIZE) + 1U;
+          }
+        }
       }
       else /* If normal download operation */
       {
@@ -451,7 +543,15 @@ static void OPENBL_USART_Download(void)
         }
 
         /* If External memory download, verify data write to memory */
-        if (address >= EXT_MEMORY_START_ADDRESS && address <= EXT_MEMORY_END_ADDRESS)
+        if (Digest.Size != 0U)
+        {
+          /* The whole partition is read back once its last packet is written */
+          if (OPENBL_MEM_DigestUpdate(&Digest, (uint8_t *)USART_RAM_Buf, codesize) == MEM_DIGEST_MISMATCH)
+          {
+            OPENBL_USART_SendByte(NACK_BYTE);
+          }
+        }
+        else if (address >= EXT_MEMORY_START_ADDRESS && address <= EXT_MEMORY_END_ADDRESS)
         {
           /* Verify data write to memory */
           res = OPENBL_MEM_Verify(address, (uint32_t)USART_RAM_Buf, codesize, 0);
@@ -483,6 +583,8 @@ static void OPENBL_USART_ReadPartition(void)
   uint8_t partId;
   uint8_t pmic_nvm_reg[MAX_PMIC_NVM_SIZE + PMIC_PROTOCOL_HEADER_SIZE] = {0};
   uint32_t nvm_size;
+  uint32_t otp_first;
+  uint32_t otp_last;
   OPENBL_USART_SendByte(ACK_BYTE);
 
   /* Get partition ID byte */
@@ -522,8 +624,12 @@ static void OPENBL_USART_ReadPartition(void)
           otp_idx_rp = 0;
           otp_idx_wm = 0;
 #ifdef USE_HASH_OVER_OTP
-          hash_sent = 0;
+          hash_idx = 0;
 #endif /* USE_HASH_OVER_OTP */
+
+          /* Statistics of the operations done before this read, sent after the otp */
+          OPENBL_OTP_GetStats(otp_stats);
+          otp_stats_idx = 0;
         }
         OPENBL_USART_SendByte(ACK_BYTE);
 
@@ -550,16 +656,17 @@ static void OPENBL_USART_ReadPartition(void)
 
         OPENBL_USART_SendByte(ACK_BYTE);
 
-        /* Read otp */
-        Otp = OPENBL_OTP_Read();
-
-        /* Calculate Hash over OTP values */
-#ifdef USE_HASH_OVER_OTP
-        OPENBL_Hash_Calculate(&Otp);
-#endif
         /* Check if first otp packet */
         if (offset == 0)
         {
+          /* Read the otp version and global state */
+          OPENBL_OTP_ReadState(&Otp);
+
+#ifdef USE_HASH_OVER_OTP
+          /* Calculate Hash over OTP values, sent after the otp words */
+          OPENBL_Hash_Calculate(&Otp);
+#endif /* USE_HASH_OVER_OTP */
+
           /* Send the otp version */
           OPENBL_USART_SendWord(Otp.Version);
 
@@ -569,52 +676,50 @@ static void OPENBL_USART_ReadPartition(void)
           /* Update codesize */
           codesize -= 2;
         }
-#ifdef USE_HASH_OVER_OTP
-        for (i = 0; i < codesize; i++)
-        {
-          /* Send OTP words until its end and send 0 after to fill */
-          if (otp_idx_rp < OTP_PART_SIZE)
-          {
-            OPENBL_USART_SendWord(Otp.OtpPart[otp_idx_rp]);
-            otp_idx_rp++;
-          }
-          else
-          {
-            /* After OTP words, transfer the 32 bytes of Hash */
-            break;
-          }
-        }
-        /* Transfer 32 hash bytes*/
-        if ((otp_idx_rp >= OTP_PART_SIZE) && (hash_sent == 0))
+
+        /* Read only the otp words sent in this packet */
+        if (otp_idx_rp < OTP_PART_SIZE)
         {
-          for (uint8_t hash_idx = 0; hash_idx < OTP_HASH_SIZE; hash_idx++)
+          otp_first = otp_idx_rp / 2U;
+          otp_last  = (otp_idx_rp + codesize + 1U) / 2U;
+
+          if (otp_last > OTP_VALUE_SIZE)
           {
-            OPENBL_USART_SendByte(Otp.Sha256Hash[hash_idx]);
+            otp_last = OTP_VALUE_SIZE;
           }
-          hash_sent = 1;
-          i += (OTP_HASH_SIZE / 4);
-        }
-        /* Transfer padding bytes */
-        for (uint32_t j = i; j < codesize; j++)
-        {
-          OPENBL_USART_SendWord(0);
+
+          OPENBL_OTP_ReadRange(otp_first, otp_last - otp_first, &Otp);
         }
-#else
+
         /* Send OTP words */
         for (i = 0; i < codesize; i++)
         {
-          /* Send OTP words until its end and send 0 after to fill */
+          /* Send OTP words until their end, the hash, the otp statistics then 0 to fill */
           if (otp_idx_rp < OTP_PART_SIZE)
           {
             OPENBL_USART_SendWord(Otp.OtpPart[otp_idx_rp]);
             otp_idx_rp++;
           }
+#ifdef USE_HASH_OVER_OTP
+          else if (hash_idx < OTP_HASH_SIZE)
+          {
+            OPENBL_USART_SendByte(Otp.Sha256Hash[hash_idx]);
+            OPENBL_USART_SendByte(Otp.Sha256Hash[hash_idx + 1U]);
+            OPENBL_USART_SendByte(Otp.Sha256Hash[hash_idx + 2U]);
+            OPENBL_USART_SendByte(Otp.Sha256Hash[hash_idx + 3U]);
+            hash_idx += 4U;
+          }
+#endif /* USE_HASH_OVER_OTP */
+          else if (otp_stats_idx < OTP_STATS_RECORD_SIZE)
+          {
+            OPENBL_USART_SendWord(otp_stats[otp_stats_idx]);
+            otp_stats_idx++;
+          }
           else
           {
             OPENBL_USART_SendWord(0);
           }
         }
-#endif /* USE_HASH_OVER_OTP */
         break;
 
       case PHASE_PMIC_NVM:
@@ -622,7 +727,13 @@ static void OPENBL_USART_ReadPartition(void)
         data = OPENBL_USART_ReadByte();
         data = OPENBL_USART_ReadByte();
         OPENBL_USART_SendByte(ACK_BYTE);
-        OPENBL_PMIC_Read(pmic_nvm_reg);
+
+        /* A failed bus read is reported instead of the NVM image */
+        if (OPENBL_PMIC_Read(pmic_nvm_reg) != PMIC_ERROR_NONE)
+        {
+          OPENBL_USART_SendByte(NACK_BYTE);
+          break;
+        }
 
         nvm_size = OPENBL_PMIC_Get_NVM_Size();
 
@@ -705,8 +816,8 @@ static uint8_t OPENBL_USART_GetAddress(uint32_t *Address)
         status = NACK_BYTE;
     }
 
-    /* Check if the address is supported */
-    if (*Address == 0xFFFFFFFF)
+    /* Check if the address is supported, streaming session data have no memory address */
+    if ((*Address == 0xFFFFFFFF) || (operation == PHASE_STREAM))
     {
       status = ACK_BYTE;
     }
@@ -19,26 +19,25 @@
 /* Includes ------------------------------------------------------------------*/
 #include "openbl_usb_cmd.h"
 #include "openbl_mem.h"
+#include "openbl_stream.h"
+#include "openbl_erase.h"
 #include "openbootloader_conf.h"
 #include "usb_interface.h"
 #include "openbl_util.h"
 #include "otp_interface.h"
 #include "pmic_interface.h"
 
-#ifdef USE_HASH_OVER_OTP
-#include "hash_interface.h"
-#endif /* USE_HASH_OVER_OTP */
-
 /* External variables --------------------------------------------------------*/
 extern OPENBL_Flashlayout_TypeDef FlashlayoutStruct;
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+#define USB_SESSION_STATUS_MAGIC          0x31545353U   /* "SST1" session status magic */
+
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
-static uint32_t i, otp_idx;
 static uint8_t phase = PHASE_FLASHLAYOUT;
 uint8_t count = 0;
 static uint32_t cur_sector = 0;
@@ -46,7 +45,11 @@ static uint32_t last_sector = 0;
 static uint8_t cur_part = PHASE_FLASHLAYOUT;
 static bool is_start_operation = false;
 uint32_t addr;
-static OPENBL_Otp_TypeDef Otp;
+static uint32_t otp_offset = 0U;
+static OPENBL_MEM_DigestTypeDef Digest;
+static uint32_t upload_size = 0U;
+static uint32_t upload_crc = 0U;
+static uint32_t stream_block = 0U;     /* Blocks received in the streaming session, 0 when none */
 /* Private function prototypes -----------------------------------------------*/
 uint32_t OPENBL_USB_GetAddress(uint8_t Phase);
 uint8_t OPENBL_USB_GetPhase(uint32_t Alt);
@@ -57,39 +60,130 @@ uint8_t OPENBL_USB_GetPhase(uint32_t Alt);
   * @param  pSrc: Pointer to the source buffer. Address to be written to.
   * @param  Alt: USB Alternate.
   * @param  Length: Number of data to be written (in bytes).
-  * @retval None.
+  * @retval DFU_ERROR_NONE, or the DFU status reported to the host on error.
   */
-void OPENBL_USB_Download(uint8_t *pSrc, uint32_t Alt, uint32_t Length, uint32_t BlockNumber)
+uint8_t OPENBL_USB_Download(uint8_t *pSrc, uint32_t Alt, uint32_t Length, uint32_t BlockNumber)
 {
+  int status;
+  uint32_t address;
+  uint64_t res;
+  OPENBL_EraseRange_TypeDef range;
+  OPENBL_ErasePlan_TypeDef plan;
+
+  /* Digest records are sent on the virtual alternate setting */
+  if (OPENBL_USB_GetPhase(Alt) == PHASE_CMD)
+  {
+    /* Other writes on the virtual alternate setting are ignored */
+    if (OPENBL_MEM_IsDigestRecord(pSrc, Length) == RESET)
+    {
+      return DFU_ERROR_NONE;
+    }
+
+    /* Digest of the partition to be downloaded, replaces the per block verify */
+    if (OPENBL_MEM_DigestStart(&Digest, addr, pSrc, Length) != SUCCESS)
+    {
+      return DFU_ERROR_FILE;
+    }
+
+    /* Partition size is known, erase it ahead of data reception */
+    if (OPENBL_MEM_GetAddressArea(addr) == EXTERNAL_MEMORY_AREA)
+    {
+      range.Start = addr;
+      range.End   = addr + Digest.Size;
+
+      if (OPENBL_ERASE_Plan(&range, 1U, &plan) == SUCCESS)
+      {
+        OPENBL_MEM_Init(addr);
+        OPENBL_ERASE_Execute(&plan);
+
+        /* Skip the per block sector erase */
+        last_sector = ((range.End - 1U - EXT_MEMORY_START_ADDRESS) / SECTOR_SIZE) + 1U;
+      }
+    }
+
+    return DFU_ERROR_NONE;
+  }
+
+  /* Streaming session data are routed by alternate setting, not by current phase */
+  if (OPENBL_USB_GetPhase(Alt) == PHASE_STREAM)
+  {
+    /* First block of a streaming session is the manifest, next ones are partitions data.
+       The 16-bit block number wraps every 65536 blocks within an active session */
+    if ((BlockNumber == 0U) && ((stream_block == 0U) || (OPENBL_STREAM_GetState() != STREAM_STATE_ACTIVE)))
+    {
+      stream_block = 0U;
+
+      if (OPENBL_STREAM_Start(pSrc, Length) != STREAM_OK)
+      {
+        return DFU_ERROR_FILE;
+      }
+    }
+    /* Data blocks are written in sequence, a gap or a restart of the session is rejected */
+    else if ((stream_block == 0U) || (BlockNumber != (stream_block & 0xFFFFU)))
+    {
+      stream_block = 0U;
+      return DFU_ERROR_FILE;
+    }
+    else
+    {
+      status = OPENBL_STREAM_Write(pSrc, Length);
+      if (status != STREAM_OK)
+      {
+        stream_block = 0U;
+        return DFU_ERROR_WRITE;
+      }
+    }
+
+    stream_block++;
+
+    return DFU_ERROR_NONE;
+  }
+
   switch (phase)
   {
     case PHASE_OTP:
-      /* Set otp version */
-      Otp.Version = (((uint32_t)pSrc[3] << 24) | ((uint32_t)pSrc[2] << 16) | ((uint32_t)pSrc[1] << 8) | (uint32_t)pSrc[0]);
-
-      /* Set otp global state */
-      Otp.GlobalState = (((uint32_t)pSrc[7] << 24) | ((uint32_t)pSrc[6] << 16) | ((uint32_t)pSrc[5] << 8) | (uint32_t)pSrc[4]);
+      /* Otp read mode record, selects fast shadow or authoritative reload reads,
+         or otp statistics record, resets the programming statistics */
+      if ((BlockNumber == 0) && ((OPENBL_OTP_ReadModeRecord(pSrc, Length) == OTP_OK)
+                                 || (OPENBL_OTP_StatsRecord(pSrc, Length) == OTP_OK)))
+      {
+        break;
+      }
 
+      /* Otp delta record, only the listed words are programmed */
       if (BlockNumber == 0)
       {
-        /* Set otp values and status */
-        for (i = 8, otp_idx = 0; (i < Length && (otp_idx < OTP_PART_SIZE)); i += 4, otp_idx++)
+        status = OPENBL_OTP_DeltaRecord(pSrc, Length);
+
+        if (status == OTP_OK)
         {
-          Otp.OtpPart[otp_idx] = (((uint32_t)pSrc[i + 3] << 24) | ((uint32_t)pSrc[i + 2] << 16) | ((uint32_t)pSrc[i + 1] << 8) | (uint32_t)pSrc[i]);
+          break;
         }
-      }
-      else
-      {
-        for (i = 0, otp_idx = (254 + ((BlockNumber - 1) * 256)); (i < Length && (otp_idx < OTP_PART_SIZE)); i += 4, otp_idx++)
+        else if (status == OTP_RECORD_INVALID)
         {
-          Otp.OtpPart[otp_idx] = (((uint32_t)pSrc[i + 3] << 24) | ((uint32_t)pSrc[i + 2] << 16) | ((uint32_t)pSrc[i + 1] << 8) | (uint32_t)pSrc[i]);
+          return DFU_ERROR_FILE;
         }
+        else if (status != OTP_RECORD_NONE)
+        {
+          /* The plan is rejected against the fuses or a word programming failed */
+          return DFU_ERROR_PROG;
+        }
+      }
+
+      /* Start of the otp image */
+      if (BlockNumber == 0)
+      {
+        otp_offset = 0U;
       }
 
-      /* Write otp */
-      if (otp_idx == OTP_PART_SIZE)
+      /* Program the otp words as soon as they are received */
+      status = OPENBL_OTP_WriteImage(otp_offset, pSrc, Length);
+      otp_offset += Length;
+
+      if (status != OTP_OK)
       {
-        OPENBL_OTP_Write(Otp);
+        /* A fuse programming or lock failed since the start of the image */
+        return DFU_ERROR_PROG;
       }
       break;
 
@@ -99,26 +193,42 @@ void OPENBL_USB_Download(uint8_t *pSrc, uint32_t Alt, uint32_t Length, uint32_t
       break;
 
     case PHASE_0x4:
+      /* Get the block address */
+      address = addr + (BlockNumber * USBD_DFU_XFER_SIZE);
+
       /* Init the external memories */
-      OPENBL_MEM_Init(addr);
+      OPENBL_MEM_Init(address);
 
       /* Get the current sector */
-      cur_sector = ((addr - EXT_MEMORY_START_ADDRESS) / SECTOR_SIZE) + 1;
+      cur_sector = ((address - EXT_MEMORY_START_ADDRESS) / SECTOR_SIZE) + 1;
       if (cur_sector > last_sector)
       {
         /* Erase sector */
-        OPENBL_MEM_SectorErase(addr, addr, (addr + Length));
+        OPENBL_MEM_SectorErase(address, address, (address + Length));
 
         /* Update last sector */
         last_sector = cur_sector;
       }
 
-      /* Verify data write to memory */
-      uint32_t res = OPENBL_MEM_Verify(addr, (uint32_t)pSrc, Length, 0);
-      if ((res != 0) && (res < (addr + Length)))
+      /* Write memory */
+      OPENBL_MEM_Write(address, pSrc, Length);
+
+      if (Digest.Size != 0U)
       {
-        /* Error */
-        while (1) {};
+        /* The whole partition is read back once its last block is written */
+        if (OPENBL_MEM_DigestUpdate(&Digest, pSrc, Length) == MEM_DIGEST_MISMATCH)
+        {
+          return DFU_ERROR_VERIFY;
+        }
+      }
+      else
+      {
+        /* Verify data write to memory */
+        res = OPENBL_MEM_Verify(address, (uint32_t)pSrc, Length, 0);
+        if (((uint32_t)res != 0) && ((uint32_t)res < (address + Length)))
+        {
+          return DFU_ERROR_VERIFY;
+        }
       }
       break;
 
@@ -135,12 +245,34 @@ void OPENBL_USB_Download(uint8_t *pSrc, uint32_t Alt, uint32_t Length, uint32_t
       break;
 
     case PHASE_PMIC_NVM:
-      OPENBL_PMIC_Write(pSrc);
+      /* Pmic refresh record, the next read is done on the bus instead of the cache */
+      if ((BlockNumber == 0) && (OPENBL_PMIC_RefreshRecord(pSrc, Length) == PMIC_ERROR_NONE))
+      {
+        break;
+      }
+
+      /* Report the failure in the DFU status, the host can clear it and retry */
+      switch (OPENBL_PMIC_Write(pSrc))
+      {
+        case PMIC_ERROR_NONE:
+          break;
+
+        case PMIC_ERROR_VERIFY:
+          return DFU_ERROR_VERIFY;
+
+        case PMIC_ERROR_NVM_TIMEOUT:
+          return DFU_ERROR_PROG;
+
+        default:
+          return DFU_ERROR_WRITE;
+      }
       break;
 
     default:
       break;
   }
+
+  return DFU_ERROR_NONE;
 }
 
 /**
@@ -152,10 +284,19 @@ void OPENBL_USB_Download(uint8_t *pSrc, uint32_t Alt, uint32_t Length, uint32_t
   */
 uint8_t *OPENBL_USB_ReadMemory(uint32_t Alt, uint8_t *pDest, uint32_t Length, uint32_t BlockNumber)
 {
+  uint32_t address;
+
   phase = OPENBL_USB_GetPhase(Alt);
   switch (phase)
   {
     case PHASE_CMD:
+      /* Partitions already received by a streaming session are skipped */
+      while ((cur_part != PHASE_FLASHLAYOUT) && (cur_part < FlashlayoutStruct.partsize)
+             && OPENBL_STREAM_IsStreamed(FlashlayoutStruct.id[cur_part]))
+      {
+        cur_part++;
+      }
+
       if (cur_part == PHASE_FLASHLAYOUT) /* Phase flashlayout */
       {
         phase = PHASE_FLASHLAYOUT;
@@ -172,6 +313,9 @@ uint8_t *OPENBL_USB_ReadMemory(uint32_t Alt, uint8_t *pDest, uint32_t Length, ui
       /* Get the phase address */
       addr = OPENBL_USB_GetAddress(phase);
 
+      /* Per block verify until a digest is announced for this partition */
+      OPENBL_MEM_DigestInit(&Digest, addr, 0U, 0U);
+
       /* Get phase command response */
       pDest[0] = phase;
       pDest[1] = (uint8_t)(addr >> 0);
@@ -201,68 +345,61 @@ uint8_t *OPENBL_USB_ReadMemory(uint32_t Alt, uint8_t *pDest, uint32_t Length, ui
       break;
 
     case PHASE_OTP:
-      /* Read otp */
+      /* Start of the otp image */
       if (BlockNumber == 0)
       {
-        Otp = OPENBL_OTP_Read();
-
-        /* Calculate Hash over OTP values only once */
-#ifdef USE_HASH_OVER_OTP
-        OPENBL_Hash_Calculate(&Otp);
-#endif /* USE_HASH_OVER_OTP */
-        /* Get otp version */
-        pDest[0] = (uint8_t)Otp.Version;
-        pDest[1] = (uint8_t)(Otp.Version >> 8);
-        pDest[2] = (uint8_t)(Otp.Version >> 16);
-        pDest[3] = (uint8_t)(Otp.Version >> 24);
-
-        /* Get otp global state */
-        pDest[4] = (uint8_t)Otp.GlobalState;
-        pDest[5] = (uint8_t)(Otp.GlobalState >> 8);
-        pDest[6] = (uint8_t)(Otp.GlobalState >> 16);
-        pDest[7] = (uint8_t)(Otp.GlobalState >> 24);
-
-        /* Get otp values and status */
-        for (i = 8, otp_idx = 0; (i < Length && (otp_idx < OTP_PART_SIZE)); i += 4, otp_idx++)
-        {
-          /* 127 OTP sent for the first 1024 bytes block - */
-          /* BlockNumber == 0 : otp_idx=0..251 - 127 OTP x 8 bytes */
-          pDest[i] = (uint8_t)(Otp.OtpPart[otp_idx]);
-          pDest[i + 1] = (uint8_t)(Otp.OtpPart[otp_idx] >> 8);
-          pDest[i + 2] = (uint8_t)(Otp.OtpPart[otp_idx] >> 16);
-          pDest[i + 3] = (uint8_t)(Otp.OtpPart[otp_idx] >> 24);
-        }
+        otp_offset = 0U;
       }
-      else
-      {
-        for (i = 0, otp_idx = (254 + ((BlockNumber - 1) * 256)); (i < Length && (otp_idx < OTP_PART_SIZE)); i += 4, otp_idx++)
-        {
 
-          /*
-           * BlockNumber == 1 : otp_idx=254..505 - 128 OTP x 8 bytes = 1024 bytes - 8 bytes = 4 byes for OTP value & 4 bytes for status
-           * BlockNumber == 2 : otp_idx=506..761 - 1024 bytes
-           * BlockNumber == 3 : otp_idx=762..767 - 1024 bytes
-           */
-          pDest[i] = (uint8_t)(Otp.OtpPart[otp_idx]);
-          pDest[i + 1] = (uint8_t)(Otp.OtpPart[otp_idx] >> 8);
-          pDest[i + 2] = (uint8_t)(Otp.OtpPart[otp_idx] >> 16);
-          pDest[i + 3] = (uint8_t)(Otp.OtpPart[otp_idx] >> 24);
-        }
-      }
-      /* Send 32 bytes of hash */
-#if defined(USE_HASH_OVER_OTP)
-      if (otp_idx >= OTP_PART_SIZE)
+      /* Read otp */
+      OPENBL_OTP_ReadImage(otp_offset, pDest, Length);
+      otp_offset += Length;
+      break;
+
+    case PHASE_PMIC_NVM:
+      /* The upload has no status, a failed bus read is reported as no PMIC in the header */
+      (void)OPENBL_PMIC_Read(pDest);
+      break;
+
+    case PHASE_0x4:
+      /* Get the block address */
+      address = EXT_MEMORY_START_ADDRESS + (BlockNumber * USBD_DFU_XFER_SIZE);
+
+      /* Start of upload, init the external memories and the digest */
+      if (BlockNumber == 0)
       {
-        for (uint8_t hash_idx = 0; hash_idx < OTP_HASH_SIZE; hash_idx++, i++)
-        {
-          pDest[i] = (uint8_t)(Otp.Sha256Hash[hash_idx]);
-        }
+        OPENBL_MEM_Init(address);
+
+        upload_size = 0U;
+        upload_crc = 0U;
       }
-#endif /* USE_HASH_OVER_OTP */
+
+      /* Read a whole DFU block at once */
+      OPENBL_MEM_ReadBlock(address, pDest, Length);
+
+      /* Digest of the uploaded data, read back through the stream alternate setting */
+      upload_crc = CRC32_Util_Compute(upload_crc, pDest, Length);
+      upload_size += Length;
       break;
 
-    case PHASE_PMIC_NVM:
-      OPENBL_PMIC_Read(pDest);
+    case PHASE_STREAM:
+      /* Session status: magic, stream state, stream phase, uploaded size and digest */
+      pDest[0] = (uint8_t)(USB_SESSION_STATUS_MAGIC);
+      pDest[1] = (uint8_t)(USB_SESSION_STATUS_MAGIC >> 8);
+      pDest[2] = (uint8_t)(USB_SESSION_STATUS_MAGIC >> 16);
+      pDest[3] = (uint8_t)(USB_SESSION_STATUS_MAGIC >> 24);
+      pDest[4] = OPENBL_STREAM_GetState();
+      pDest[5] = OPENBL_STREAM_GetPhase();
+      pDest[6] = 0x00;
+      pDest[7] = 0x00;
+      pDest[8] = (uint8_t)upload_size;
+      pDest[9] = (uint8_t)(upload_size >> 8);
+      pDest[10] = (uint8_t)(upload_size >> 16);
+      pDest[11] = (uint8_t)(upload_size >> 24);
+      pDest[12] = (uint8_t)upload_crc;
+      pDest[13] = (uint8_t)(upload_crc >> 8);
+      pDest[14] = (uint8_t)(upload_crc >> 16);
+      pDest[15] = (uint8_t)(upload_crc >> 24);
       break;
 
     default:
@@ -273,6 +410,71 @@ uint8_t *OPENBL_USB_ReadMemory(uint32_t Alt, uint8_t *pDest, uint32_t Length, ui
   return pDest;
 }
 
+/**
+  * @brief  Expected duration of a download, reported to the host as DFU poll timeout
+  * @param  Alt: USB Alternate.
+  * @param  pSrc: Pointer to the received block, not processed yet.
+  * @param  Length: Number of data received (in bytes).
+  * @param  BlockNumber: Number of the received block.
+  * @retval Duration in ms.
+  */
+uint32_t OPENBL_USB_GetBusyTime(uint32_t Alt, uint8_t *pSrc, uint32_t Length, uint32_t BlockNumber)
+{
+  OPENBL_MEM_DigestTypeDef digest;
+  OPENBL_EraseRange_TypeDef range;
+  OPENBL_ErasePlan_TypeDef plan;
+  uint32_t address;
+  uint32_t ret = 0U;
+
+  switch (OPENBL_USB_GetPhase(Alt))
+  {
+    case PHASE_PMIC_NVM:
+      /* The PMIC NVM is programmed once its partition is received */
+      ret = OPENBL_PMIC_Get_Busy_Time();
+      break;
+
+    case PHASE_STREAM:
+      /* All the external memory partitions are erased when the manifest is received */
+      if (BlockNumber == 0U)
+      {
+        ret = OPENBL_STREAM_GetStartTime(pSrc, Length);
+      }
+      break;
+
+    case PHASE_CMD:
+      /* The partition announced by a digest record is erased at once */
+      if ((OPENBL_MEM_IsDigestRecord(pSrc, Length) == SET)
+          && (OPENBL_MEM_DigestStart(&digest, addr, pSrc, Length) == SUCCESS)
+          && (OPENBL_MEM_GetAddressArea(addr) == EXTERNAL_MEMORY_AREA))
+      {
+        range.Start = addr;
+        range.End   = addr + digest.Size;
+
+        if (OPENBL_ERASE_Plan(&range, 1U, &plan) == SUCCESS)
+        {
+          ret = plan.Time;
+        }
+      }
+      break;
+
+    default:
+      /* External memory partition, a sector is erased when the block starts
+         in a sector not erased yet */
+      if (phase == PHASE_0x4)
+      {
+        address = addr + (BlockNumber * USBD_DFU_XFER_SIZE);
+
+        if ((((address - EXT_MEMORY_START_ADDRESS) / SECTOR_SIZE) + 1U) > last_sector)
+        {
+          ret = SECTOR_ERASE_TIME;
+        }
+      }
+      break;
+  }
+
+  return ret;
+}
+
 /**
   * @brief  Link between USB Alternate and STM32CubeProgrammer phase
   * @param  Alt: USB Alternate.
@@ -308,6 +510,10 @@ uint8_t OPENBL_USB_GetPhase(uint32_t Alt)
       ret = PHASE_PMIC_NVM;
       break;
 
+    case 6:
+      ret = PHASE_STREAM;
+      break;
+
     default:
       ret = PHASE_END;
       break;
@@ -24,6 +24,24 @@
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 static uint32_t part_list_size = 0;
+
+/* Strings referenced by the binary flashlayout codes */
+static char *const flashlayout_bin_opt[8] =
+{
+  "-", "P", "D", "PD", "E", "PE", "DE", "PDE"
+};
+
+static char *const flashlayout_bin_type[] =
+{
+  "Binary", "System", "FileSystem", "RawImage", "ENV"
+};
+
+static char *const flashlayout_bin_ip[] =
+{
+  "none", "nor", "nand", "spi-nand", "mmc0", "mmc1", "mmc2"
+};
+
+static char flashlayout_bin_name[PHASE_LAST_USER][FLASHLAYOUT_BIN_NAME_SIZE + 1U];
 /* Private function prototypes -----------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
 /* Exported functions --------------------------------------------------------*/
@@ -46,6 +64,13 @@ int parse_flash_layout(uint32_t addr, uint32_t size)
   bool is_partition = true;
   uint32_t i = 0;
 
+  /* A binary flashlayout is loaded as is, without text parsing */
+  if ((size >= sizeof(OPENBL_FlashlayoutBinHeader_TypeDef))
+      && (((OPENBL_FlashlayoutBinHeader_TypeDef *)addr)->Magic == FLASHLAYOUT_BIN_MAGIC))
+  {
+    return load_flash_layout_bin(addr, size);
+  }
+
   start = (char *)addr;
   last = start + size;
   *last = '\0'; /* force null terminated string */
@@ -140,6 +165,82 @@ int parse_flash_layout(uint32_t addr, uint32_t size)
   return PARSE_OK;
 }
 
+/**
+  * @brief  This function is used to load a binary flashlayout.
+  *         The binary flashlayout is made of a header followed by fixed size
+  *         entries, one per flashlayout line, in the same order as the TSV.
+  *         The entries are checked against the header CRC before being used.
+  * @param  addr Address of the binary flashlayout.
+  * @param  size Size of the received data.
+  * @retval Status PARSE_OK if PASS.
+  */
+int load_flash_layout_bin(uint32_t addr, uint32_t size)
+{
+  OPENBL_FlashlayoutBinHeader_TypeDef header;
+  OPENBL_FlashlayoutBinEntry_TypeDef entry;
+  const uint8_t *entries = (const uint8_t *)(addr + sizeof(OPENBL_FlashlayoutBinHeader_TypeDef));
+  uint32_t entries_size;
+  uint32_t idx;
+
+  if (size < sizeof(header))
+  {
+    return PARSE_ERROR;
+  }
+
+  /* The host buffer is not necessarily word aligned */
+  memcpy(&header, (const uint8_t *)addr, sizeof(header));
+
+  if ((header.Magic != FLASHLAYOUT_BIN_MAGIC) || (header.Version != FLASHLAYOUT_BIN_VERSION)
+      || (header.EntryCount > PHASE_LAST_USER))
+  {
+    return PARSE_ERROR;
+  }
+
+  entries_size = header.EntryCount * sizeof(OPENBL_FlashlayoutBinEntry_TypeDef);
+
+  if ((sizeof(OPENBL_FlashlayoutBinHeader_TypeDef) + entries_size) > size)
+  {
+    return PARSE_ERROR;
+  }
+
+  if (CRC32_Util_Compute(0U, entries, entries_size) != header.Crc)
+  {
+    return PARSE_ERROR;
+  }
+
+  /* Check all the entries before updating the flashlayout */
+  for (idx = 0U; idx < header.EntryCount; idx++)
+  {
+    memcpy(&entry, &entries[idx * sizeof(entry)], sizeof(entry));
+
+    if ((entry.Opt >= (sizeof(flashlayout_bin_opt) / sizeof(flashlayout_bin_opt[0])))
+        || (entry.Type >= (sizeof(flashlayout_bin_type) / sizeof(flashlayout_bin_type[0])))
+        || (entry.Ip >= (sizeof(flashlayout_bin_ip) / sizeof(flashlayout_bin_ip[0]))))
+    {
+      return PARSE_ERROR;
+    }
+  }
+
+  for (idx = 0U; idx < header.EntryCount; idx++)
+  {
+    memcpy(&entry, &entries[idx * sizeof(entry)], sizeof(entry));
+
+    memcpy(flashlayout_bin_name[idx], entry.Name, FLASHLAYOUT_BIN_NAME_SIZE);
+    flashlayout_bin_name[idx][FLASHLAYOUT_BIN_NAME_SIZE] = '\0';
+
+    FlashlayoutStruct.id[idx]     = entry.Id;
+    FlashlayoutStruct.offset[idx] = entry.Offset;
+    FlashlayoutStruct.opt[idx]    = flashlayout_bin_opt[entry.Opt];
+    FlashlayoutStruct.type[idx]   = flashlayout_bin_type[entry.Type];
+    FlashlayoutStruct.ip[idx]     = flashlayout_bin_ip[entry.Ip];
+    FlashlayoutStruct.name[idx]   = flashlayout_bin_name[idx];
+  }
+
+  FlashlayoutStruct.partsize = header.EntryCount;
+
+  return PARSE_OK;
+}
+
 /**
   * @brief  This function is used to parse the flashlayout id.
   * @retval int: return value
@@ -27,7 +27,10 @@
 #include <stdbool.h>
 #include <limits.h>
 #include <errno.h>
+#include "crc32_util.h"
 /* Exported types ------------------------------------------------------------*/
+#define FLASHLAYOUT_BIN_NAME_SIZE            8U                  /* Binary flashlayout name size */
+
 typedef struct
 {
   char*     opt[0xF];
@@ -39,6 +42,27 @@ typedef struct
   uint32_t  partsize;
 } OPENBL_Flashlayout_TypeDef;
 
+/* Binary flashlayout header, all fields little-endian */
+typedef struct
+{
+  uint32_t  Magic;                    /* FLASHLAYOUT_BIN_MAGIC */
+  uint8_t   Version;                  /* FLASHLAYOUT_BIN_VERSION */
+  uint8_t   EntryCount;               /* Number of entries following the header */
+  uint16_t  Reserved;
+  uint32_t  Crc;                      /* CRC-32 over the entries */
+} OPENBL_FlashlayoutBinHeader_TypeDef;
+
+/* Binary flashlayout entry, one per flashlayout line */
+typedef struct
+{
+  uint8_t   Id;                       /* Partition ID */
+  uint8_t   Opt;                      /* FLASHLAYOUT_BIN_OPT_x flags */
+  uint8_t   Type;                     /* Index in the type name table */
+  uint8_t   Ip;                       /* Index in the ip name table */
+  uint32_t  Offset;                   /* Partition offset */
+  char      Name[FLASHLAYOUT_BIN_NAME_SIZE]; /* Partition name, null padded */
+} OPENBL_FlashlayoutBinEntry_TypeDef;
+
 
 /* Exported constants --------------------------------------------------------*/
 #define PHASE_FLASHLAYOUT                    0x00                /* Flashlayout phase */
@@ -55,6 +79,12 @@ typedef struct
 #define GETPHASE_SIZE                        9
 #define PHASE_CMD                            0xF1
 
+#define FLASHLAYOUT_BIN_MAGIC                0x314C4653U         /* "SFL1" binary flashlayout magic */
+#define FLASHLAYOUT_BIN_VERSION              0x01U               /* Binary flashlayout version */
+#define FLASHLAYOUT_BIN_OPT_P                0x01U               /* Option 'P': partition is programmed */
+#define FLASHLAYOUT_BIN_OPT_D                0x02U               /* Option 'D': partition is deleted */
+#define FLASHLAYOUT_BIN_OPT_E                0x04U               /* Option 'E': partition is empty */
+
 #define BOOT_INTERFACE_SEL_SERIAL_UART       0x5U                /* Boot occurred on UART */
 #define BOOT_INTERFACE_SEL_SERIAL_USB        0x6U                /* Boot occurred on USB */
 #define UART_ID                              0                   /* USB registered as interface ID 0 */
@@ -63,6 +93,7 @@ typedef struct
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions --------------------------------------------------------*/
 int parse_flash_layout(uint32_t addr, uint32_t size);
+int load_flash_layout_bin(uint32_t addr, uint32_t size);
 int parse_name(char *s, uint32_t idx);
 int parse_ip(char *s, uint32_t idx);
 int parse_id(char *s, uint32_t idx);
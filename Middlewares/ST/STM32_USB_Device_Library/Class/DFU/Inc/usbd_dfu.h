@@ -72,17 +72,21 @@ extern "C" {
 #define FSBL_EXT_PARTSIZE               (70*1024)
 #define FSBL_APP_DESC_STR              "@FSBL-APP /0x04/1*64Me"
 #define FSBL_APP_DESC_PARTSIZE          (64*1024*1024)
+#define STREAM_DESC_STR                "@Stream /0xF3/1*64Me"
+#define STREAM_DESC_PARTSIZE            (64*1024*1024)
 
 /*On MP2:368 OTP = (2 * 368 + 2) * 4 bytes = 2952 bytes 
 (for 32 bits word, with M = 0 to 367 (no access to HWKEY and STM32PRVKEY))
-but we keep part size according to M = 0 to 383 i.e 3080 because of compatibilty with open source tools.
-On MP13 = (96*2+2)*4 = 776 bytes*/
+but we keep the otp structure according to M = 0 to 383 i.e 3080 because of compatibilty with open source tools.
+On MP13 = (96*2+2)*4 = 776 bytes.
+The otp structure is followed by the 32 bytes of the otp hash and the 136 bytes
+of the otp statistics record, i.e 3248 bytes on MP2 and 944 bytes on MP13*/
 #if defined (STM32MP257Cxx)
-#define OTP_DESC_STR                   "@OTP /0xF2/1*3080Be"
-#define OTP_DESC_PARTSIZE               (3080)
+#define OTP_DESC_STR                   "@OTP /0xF2/1*3248Be"
+#define OTP_DESC_PARTSIZE               (3248)
 #else
-#define OTP_DESC_STR                   "@OTP /0xF2/1*776Be"
-#define OTP_DESC_PARTSIZE               (776)
+#define OTP_DESC_STR                   "@OTP /0xF2/1*944Be"
+#define OTP_DESC_PARTSIZE               (944)
 #endif /*STM32MP257Cxx*/
 
 
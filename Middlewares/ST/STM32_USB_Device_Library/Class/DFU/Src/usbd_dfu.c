@@ -56,7 +56,7 @@ EndBSPDependencies */
 #include "usbd_dfu.h"
 #include "usbd_ctlreq.h"
 
-extern int8_t pmic_nvm_str;
+extern int8_t *USBD_DFU_GetPmicDescStr(void);
 /** @addtogroup STM32_USB_DEVICE_LIBRARY
   * @{
   */
@@ -209,9 +209,14 @@ __ALIGN_BEGIN static uint8_t USBD_DFU_CfgDesc[USB_DFU_CONFIG_DESC_SIZ] __ALIGN_E
 #endif /* (USBD_DFU_MAX_ITF_NUM > 5) */
 
 #if (USBD_DFU_MAX_ITF_NUM > 6U)
-#error "ERROR: usbd_dfu_core.c: Modify the file to support more descriptors!"
+  /**********  Descriptor of DFU interface 0 Alternate setting 6 **************/
+  USBD_DFU_IF_DESC(6),
 #endif /* (USBD_DFU_MAX_ITF_NUM > 6) */
 
+#if (USBD_DFU_MAX_ITF_NUM > 7U)
+#error "ERROR: usbd_dfu_core.c: Modify the file to support more descriptors!"
+#endif /* (USBD_DFU_MAX_ITF_NUM > 7) */
+
   /******************** DFU Functional Descriptor********************/
   0x09,                                                /* blength = 9 Bytes */
   DFU_DESCRIPTOR_TYPE,                                 /* DFU Functional Descriptor */
@@ -522,6 +527,7 @@ static uint8_t  USBD_DFU_EP0_TxReady(USBD_HandleTypeDef *pdev)
 {
   USBD_DFU_HandleTypeDef *hdfu = (USBD_DFU_HandleTypeDef *)pdev->pClassDataCmsit[pdev->classId];
   USBD_DFU_MediaTypeDef *DfuInterface = (USBD_DFU_MediaTypeDef *)pdev->pUserData[pdev->classId];
+  uint16_t status;
 
   if (hdfu == NULL)
   {
@@ -531,17 +537,23 @@ static uint8_t  USBD_DFU_EP0_TxReady(USBD_HandleTypeDef *pdev)
   if (hdfu->dev_state == DFU_STATE_DNLOAD_BUSY)
   {
     /* Perform the write operation */
-    if (DfuInterface->Write(hdfu->buffer.d8, hdfu->alt_setting, hdfu->wlength, hdfu->wblock_num) != USBD_OK)
-    {
-      return (uint8_t)USBD_FAIL;
-    }
+    status = DfuInterface->Write(hdfu->buffer.d8, hdfu->alt_setting, hdfu->wlength, hdfu->wblock_num);
 
     /* Reset the global length and block number */
     hdfu->wlength = 0U;
     hdfu->wblock_num = 0U;
 
-    /* Update the state machine */
-    hdfu->dev_state =  DFU_STATE_DNLOAD_SYNC;
+    /* Update the state machine, a write error is reported to the host by the
+       next GETSTATUS and cleared by CLRSTATUS */
+    if (status != USBD_OK)
+    {
+      hdfu->dev_state = DFU_STATE_ERROR;
+      hdfu->dev_status[0] = (uint8_t)status;
+    }
+    else
+    {
+      hdfu->dev_state = DFU_STATE_DNLOAD_SYNC;
+    }
 
     hdfu->dev_status[1] = 0U;
     hdfu->dev_status[2] = 0U;
@@ -625,9 +637,13 @@ static uint8_t *USBD_DFU_GetUsrStringDesc(USBD_HandleTypeDef *pdev, uint8_t inde
     {
       USBD_GetString((uint8_t *)OTP_DESC_STR, USBD_StrDesc, length);
     }
+    else if  ((index == (USBD_IDX_INTERFACE_STR + 6)))
+    {
+      USBD_GetString((uint8_t *)USBD_DFU_GetPmicDescStr(), USBD_StrDesc, length);
+    }
     else
     {
-      USBD_GetString((uint8_t *)&pmic_nvm_str, USBD_StrDesc, length);
+      USBD_GetString((uint8_t *)STREAM_DESC_STR, USBD_StrDesc, length);
     }
     return USBD_StrDesc;
   }
@@ -860,6 +876,12 @@ static void DFU_GetStatus(USBD_HandleTypeDef *pdev)
         hdfu->dev_status[2] = 0U;
         hdfu->dev_status[3] = 0U;
         hdfu->dev_status[4] = hdfu->dev_state;
+
+        /* bwPollTimeout = expected duration of the write */
+        if (DfuInterface->GetStatus != NULL)
+        {
+          (void)DfuInterface->GetStatus(hdfu->alt_setting, DFU_MEDIA_PROGRAM, hdfu->dev_status);
+        }
       }
       else  /* (hdfu->wlength==0)*/
       {
@@ -28,6 +28,9 @@
 void Serial_Putchar(char value);
 void Serial_Printf(char *value, int len);
 uint32_t Serial_Scanf(uint32_t value);
+uint32_t Serial_GetLine(char *line, uint32_t size);
+void Serial_Flush(void);
+void Serial_IRQHandler(void);
 void UART_Config(void);
 
 /* Private defines -----------------------------------------------------------*/
@@ -37,6 +40,8 @@ void UART_Config(void);
 #define USARTx_CLK_ENABLE()              __HAL_RCC_USART2_CLK_ENABLE()
 #define USARTx_FORCE_RESET()             __HAL_RCC_USART2_FORCE_RESET()
 #define USARTx_RELEASE_RESET()           __HAL_RCC_USART2_RELEASE_RESET()
+#define USARTx_IRQn                      USART2_IRQn
+#define USARTx_IRQHandler                USART2_IRQHandler
 
 #define MX_UART_INSTANCE        USART2
 #define MX_UART_TX_PIN          GPIO_PIN_4
@@ -51,6 +56,8 @@ void UART_Config(void);
 #define USARTx_CLK_ENABLE()              __HAL_RCC_UART4_CLK_ENABLE()
 #define USARTx_FORCE_RESET()             __HAL_RCC_UART4_FORCE_RESET()
 #define USARTx_RELEASE_RESET()           __HAL_RCC_UART4_RELEASE_RESET()
+#define USARTx_IRQn                      UART4_IRQn
+#define USARTx_IRQHandler                UART4_IRQHandler
 
 #define MX_UART_INSTANCE        UART4
 #define MX_UART_TX_PIN          GPIO_PIN_11
@@ -65,6 +72,8 @@ void UART_Config(void);
 #define USARTx_CLK_ENABLE()              __HAL_RCC_UART4_CLK_ENABLE()
 #define USARTx_FORCE_RESET()             __HAL_RCC_UART4_FORCE_RESET()
 #define USARTx_RELEASE_RESET()           __HAL_RCC_UART4_RELEASE_RESET()
+#define USARTx_IRQn                      UART4_IRQn
+#define USARTx_IRQHandler                UART4_IRQHandler
 
 #define MX_UART_INSTANCE        UART4
 #define MX_UART_TX_PIN          GPIO_PIN_6
@@ -84,4 +93,15 @@ void UART_Config(void);
 #define MX_UART_MODE            UART_MODE_TX_RX
 #define MX_UART_OVERSAMPLING    UART_OVERSAMPLING_16
 
+/* Console baud rate, can be set above MX_UART_BAUDRATE in preprocessor build */
+#ifndef CONSOLE_BAUDRATE
+#define CONSOLE_BAUDRATE        MX_UART_BAUDRATE
+#endif /* CONSOLE_BAUDRATE */
+
+/* Console input and output */
+#define SERIAL_RX_BUFFER_SIZE   1024U /* Received characters ring, power of 2 */
+#define SERIAL_TX_BUFFER_SIZE   4096U /* Characters to transmit ring, power of 2 */
+#define SERIAL_STDOUT_BUFFER_SIZE 256U /* printf line buffer */
+#define SERIAL_IRQ_PRIORITY     8U
+
 #endif /* CONSOLE_UTIL_H */
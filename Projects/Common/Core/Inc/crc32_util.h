@@ -0,0 +1,40 @@
+/**
+  ******************************************************************************
+  * @file    crc32_util.h
+  * @author  MCD Application Team
+  * @brief   Header for crc32_util.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef CRC32_UTIL_H
+#define CRC32_UTIL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+/* Exported constants --------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+uint32_t CRC32_Util_Compute(uint32_t Crc, const uint8_t *pData, uint32_t Size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRC32_UTIL_H */
@@ -38,6 +38,7 @@ extern "C" {
 void HASH_Util_Init(void);
 void HASH_Util_DeInit(void);
 HAL_StatusTypeDef HASH_Util_calculate(Otp_TypeDef *Otp);
+uint8_t HASH_Util_IsValid(void);
 
 #endif /* USE_HASH_OVER_OTP */
 
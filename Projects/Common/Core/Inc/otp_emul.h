@@ -0,0 +1,92 @@
+/**
+  ******************************************************************************
+  * @file    otp_emul.h
+  * @author  MCD Application Team
+  * @brief   Header for otp_emul.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef OTP_EMUL_H
+#define OTP_EMUL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#if defined(USE_OTP_EMULATION)
+#include "main.h"
+#include "otp_util.h"
+#include "otp_model.h"
+
+/* Exported types ------------------------------------------------------------*/
+/* Durations, life cycle and failing fuse of the fuses model, HAL_Delay is
+   used when no delay callback is given */
+typedef OTP_Model_ConfigTypeDef OTP_Emul_ConfigTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+#define OTP_EMUL_NO_ERROR_WORD          OTP_MODEL_NO_ERROR_WORD
+
+/* Exported macro ------------------------------------------------------------*/
+/* The otp utilities use the emulated fuses instead of the BSEC ones */
+#if defined(BSEC_API_CHANGE)
+#define HAL_BSEC_OTP_Read                       OTP_Emul_OTP_Read
+#define HAL_BSEC_OTP_Program                    OTP_Emul_OTP_Program
+#define HAL_BSEC_OTP_Lock                       OTP_Emul_OTP_Lock
+#define HAL_BSEC_OTP_GetState                   OTP_Emul_OTP_GetState
+#define HAL_BSEC_OTP_ReadShadow                 OTP_Emul_OTP_ReadShadow
+#define HAL_BSEC_OTP_GetShadowState             OTP_Emul_OTP_GetShadowState
+#define HAL_BSEC_GetDeviceLifeCycleState        OTP_Emul_GetDeviceLifeCycleState
+#else
+#define HAL_BSEC_OtpRead                        OTP_Emul_OtpRead
+#define HAL_BSEC_OtpProgram                     OTP_Emul_OtpProgram
+#define HAL_BSEC_SetOtpStickyLock               OTP_Emul_SetOtpStickyLock
+#define HAL_BSEC_GetOtpStickyLockStatus         OTP_Emul_GetOtpStickyLockStatus
+#define HAL_BSEC_SetOtpPermanentProgLock        OTP_Emul_SetOtpPermanentProgLock
+#define HAL_BSEC_GetOtpPermanentProgLockStatus  OTP_Emul_GetOtpPermanentProgLockStatus
+#define HAL_BSEC_GetSecurityStatus              OTP_Emul_GetSecurityStatus
+#endif /* BSEC_API_CHANGE */
+
+/* Exported functions ------------------------------------------------------- */
+void OTP_Emul_Config(const OTP_Emul_ConfigTypeDef *pConfig);
+void OTP_Emul_Erase(void);
+void OTP_Emul_Reset(void);
+
+#if defined(BSEC_API_CHANGE)
+HAL_StatusTypeDef OTP_Emul_OTP_Read(BSEC_HandleTypeDef *const pHbsec, uint32_t FuseId, uint32_t *pFuseData);
+HAL_StatusTypeDef OTP_Emul_OTP_Program(BSEC_HandleTypeDef *pHbsec, uint32_t FuseId, uint32_t FuseData, uint32_t Lock);
+HAL_StatusTypeDef OTP_Emul_OTP_Lock(BSEC_HandleTypeDef *pHbsec, uint32_t FuseId, uint32_t Lock);
+HAL_StatusTypeDef OTP_Emul_OTP_GetState(BSEC_HandleTypeDef *const pHbsec, uint32_t FuseId, uint32_t *pState);
+HAL_StatusTypeDef OTP_Emul_OTP_ReadShadow(BSEC_HandleTypeDef *const pHbsec, uint32_t RegId, uint32_t *pRegData);
+HAL_StatusTypeDef OTP_Emul_OTP_GetShadowState(BSEC_HandleTypeDef *const pHbsec, uint32_t RegId, uint32_t *pValidity);
+HAL_StatusTypeDef OTP_Emul_GetDeviceLifeCycleState(BSEC_HandleTypeDef *const pHbsec, uint32_t *pState);
+#else
+HAL_StatusTypeDef OTP_Emul_OtpRead(BSEC_HandleTypeDef *hBsec, uint32_t otpWordIdx, uint32_t *pOtpShadowVal);
+HAL_StatusTypeDef OTP_Emul_OtpProgram(BSEC_HandleTypeDef *hBsec, uint32_t otpWordIdx, uint32_t otpWordValReq);
+HAL_StatusTypeDef OTP_Emul_SetOtpStickyLock(BSEC_HandleTypeDef *hBsec, uint32_t otpWordIdx, uint32_t stickyLockCmd);
+HAL_StatusTypeDef OTP_Emul_GetOtpStickyLockStatus(BSEC_HandleTypeDef *hBsec, uint32_t otpWordIdx,
+                                                  uint32_t *pStickyLockStatus);
+HAL_StatusTypeDef OTP_Emul_SetOtpPermanentProgLock(BSEC_HandleTypeDef *hBsec, uint32_t otpWordIdx);
+HAL_StatusTypeDef OTP_Emul_GetOtpPermanentProgLockStatus(BSEC_HandleTypeDef *hBsec, uint32_t otpWordIdx,
+                                                         uint32_t *pLockStatus);
+HAL_StatusTypeDef OTP_Emul_GetSecurityStatus(BSEC_HandleTypeDef *hBsec, BSEC_ChipSecurityTypeDef *pSecStatus);
+#endif /* BSEC_API_CHANGE */
+
+#endif /* USE_OTP_EMULATION */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OTP_EMUL_H */
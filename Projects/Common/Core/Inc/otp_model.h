@@ -0,0 +1,86 @@
+/**
+  ******************************************************************************
+  * @file    otp_model.h
+  * @author  MCD Application Team
+  * @brief   Header for otp_model.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef OTP_MODEL_H
+#define OTP_MODEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#if defined(USE_OTP_EMULATION)
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+typedef void (*OTP_Model_DelayTypeDef)(uint32_t Delay);
+
+typedef struct
+{
+  uint32_t ProgramDelay;          /* Duration of a fuse programming or permanent lock, in ms */
+  uint32_t ReadDelay;             /* Duration of a fuse reload, in ms */
+  uint32_t Closed;                /* 1 for a closed device life cycle, 0 for an open one */
+  uint32_t ErrorWord;             /* Fuse failing on reload, OTP_MODEL_NO_ERROR_WORD for none */
+  OTP_Model_DelayTypeDef Delay;   /* Waits the given ms, NULL to not wait */
+} OTP_Model_ConfigTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+#if defined (STM32MP257Cxx)
+#define OTP_MODEL_WORD_NUMBER           384U
+#else
+#define OTP_MODEL_WORD_NUMBER           96U
+#endif /* STM32MP257Cxx */
+
+#define OTP_MODEL_NO_ERROR_WORD         0xFFFFFFFFU
+
+/* Locks of a fuse, the sticky ones have the BSEC bit positions */
+#define OTP_MODEL_STICKY_PROG           (1U << 0)    /* Programming sticky lock */
+#define OTP_MODEL_STICKY_WRITE          (1U << 1)    /* Shadow write sticky lock */
+#define OTP_MODEL_STICKY_RELOAD         (1U << 2)    /* Shadow reload sticky lock */
+#define OTP_MODEL_STICKY_MASK           (OTP_MODEL_STICKY_PROG | OTP_MODEL_STICKY_WRITE | OTP_MODEL_STICKY_RELOAD)
+#define OTP_MODEL_PERM                  (1U << 3)    /* Permanent programming lock */
+#define OTP_MODEL_SHADOW_ERROR          (1U << 4)    /* Last reload of the fuse failed */
+
+/* Status of the fuse operations */
+#define OTP_MODEL_OK                    0
+#define OTP_MODEL_PARAM_ERROR           -1           /* Fuse number out of range */
+#define OTP_MODEL_PERM_LOCKED           -2           /* Fuse permanently locked */
+#define OTP_MODEL_STICKY_LOCKED         -3           /* Fuse sticky locked */
+#define OTP_MODEL_PROG_ERROR            -4           /* A blown bit should be cleared */
+#define OTP_MODEL_READ_ERROR            -5           /* Reload of the fuse failed */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void OTP_Model_Config(const OTP_Model_ConfigTypeDef *pConfig);
+void OTP_Model_Erase(void);
+void OTP_Model_Reset(void);
+int OTP_Model_Read(uint32_t Word, uint32_t *pValue);
+int OTP_Model_ReadShadow(uint32_t Word, uint32_t *pValue);
+int OTP_Model_Program(uint32_t Word, uint32_t Value);
+int OTP_Model_Lock(uint32_t Word, uint32_t Lock);
+int OTP_Model_GetLock(uint32_t Word, uint32_t *pLock);
+uint32_t OTP_Model_IsClosed(void);
+
+#endif /* USE_OTP_EMULATION */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OTP_MODEL_H */
@@ -43,6 +43,45 @@ typedef struct
 #endif /* USE_HASH_OVER_OTP */
 } Otp_TypeDef;
 
+typedef struct
+{
+  uint32_t ProgramCount;  /* Words with bits to be blown */
+  uint32_t LockCount;     /* Words with lock bits to be set */
+  uint32_t SkipCount;     /* Words already in the requested state */
+  uint32_t ErrorCount;    /* Words which cannot reach the requested state */
+  uint32_t FirstError;    /* First word which cannot reach the requested state */
+} Otp_PlanTypeDef;
+
+typedef struct
+{
+  uint32_t Ticks;        /* Duration of the last otp read, in ms */
+  uint32_t ShadowCount;  /* Number of fuses served from their shadow register */
+  uint32_t ReloadCount;  /* Number of fuses reloaded from the otp array */
+} Otp_ReadStatsTypeDef;
+
+#define OTP_OP_PROGRAM        (0U)  /* Fuse programming, with its permanent lock on STM32MP25xx */
+#define OTP_OP_STICKY_LOCK    (1U)  /* Sticky lock setting */
+#define OTP_OP_PERM_LOCK      (2U)  /* Permanent programming lock, STM32MP13xx and STM32MP15xx */
+#define OTP_OP_READ           (3U)  /* Fuse read */
+#define OTP_OP_NUMBER         (4U)
+#define OTP_PROG_FAIL_MAX     (8U)
+typedef struct
+{
+  uint32_t Count;     /* Number of operations */
+  uint32_t Min;       /* Shortest operation, in us */
+  uint32_t Max;       /* Longest operation, in us */
+  uint32_t Total;     /* Cumulated duration of the operations, in us */
+  uint32_t Errors;    /* Number of failed operations */
+  uint32_t Timeouts;  /* Number of operations failed on a BSEC timeout */
+} Otp_OpStatsTypeDef;
+
+typedef struct
+{
+  Otp_OpStatsTypeDef Op[OTP_OP_NUMBER];  /* Statistics of each operation type */
+  uint32_t FailCount;                    /* Number of failing fuses */
+  uint32_t FailWord[OTP_PROG_FAIL_MAX];  /* First failing fuses */
+} Otp_ProgStatsTypeDef;
+
 /* Exported constants --------------------------------------------------------*/
 #if defined (STM32MP257Cxx)
 #define OTP_PART_SIZE                   (2 * 384)
@@ -53,7 +92,7 @@ typedef struct
 #else
 #define OTP_PART_SIZE                   (2 * 96)
 #define OTP_VALUE_SIZE                  96
-#define OPENBL_OTP_VERSION              (2)  /* This version does not support hash */
+#define OPENBL_OTP_VERSION              (3)  /* This version supports hash, sent after the otp words */
 #define OTP_HASH_PART_SIZE        OTP_PART_SIZE
 #endif
 
@@ -80,14 +119,37 @@ typedef struct
 #define OTP_HARDWARE_KEY_SET_POS        31
 #define OTP_ERROR                       -1
 #define OTP_OK                          0
+#define OTP_READ_RELOAD                 0U           /* Authoritative read, every fuse is reloaded */
+#define OTP_READ_SHADOW                 1U           /* Fast read from the valid shadow registers */
+#define OTP_READ_MODE_MAGIC             0x314D4F53U  /* "SOM1" otp read mode record */
+#define OTP_DELTA_MAGIC                 0x31444F53U  /* "SOD1" otp delta record */
+#define OTP_DELTA_HEADER_SIZE           12U          /* Magic, flags and entries number */
+#define OTP_DELTA_ENTRY_SIZE            12U          /* Word, value and status */
+#define OTP_DELTA_COMMIT                (1U << 0)    /* Program the cached words after this record */
+#define OTP_STATS_MAGIC                 0x31534F53U  /* "SOS1" otp programming statistics record */
+#define OTP_STATS_OP_SIZE               6U           /* Count, min, average, max, errors and timeouts */
+#define OTP_STATS_RECORD_SIZE           (2U + (OTP_OP_NUMBER * OTP_STATS_OP_SIZE) + OTP_PROG_FAIL_MAX) /* In words */
 
 
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
 void OTP_Util_Init(void);
 void OTP_Util_DeInit(void);
-int OTP_Util_Write(Otp_TypeDef Otp);
-Otp_TypeDef OTP_Util_Read(void);
+int OTP_Util_Write(const Otp_TypeDef *pOtp);
+int OTP_Util_WriteWord(uint32_t word, uint32_t value, uint32_t stat);
+void OTP_Util_Read(Otp_TypeDef *pOtp);
+void OTP_Util_ReadState(Otp_TypeDef *pOtp);
+int OTP_Util_ReadRange(uint32_t first, uint32_t count, Otp_TypeDef *pOtp);
+void OTP_Util_SetReadMode(uint32_t mode);
+uint32_t OTP_Util_GetReadMode(void);
+void OTP_Util_GetReadStats(Otp_ReadStatsTypeDef *pStats);
+void OTP_Util_CacheReset(void);
+int OTP_Util_CacheSet(uint32_t word, uint32_t value, uint32_t stat);
+int OTP_Util_CacheDiff(Otp_PlanTypeDef *pPlan);
+int OTP_Util_CacheApply(Otp_PlanTypeDef *pPlan);
+uint32_t OTP_Util_GetGeneration(void);
+void OTP_Util_GetProgStats(Otp_ProgStatsTypeDef *pStats);
+void OTP_Util_ResetProgStats(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,73 @@
+/**
+  ******************************************************************************
+  * @file    pmic_emul.h
+  * @author  GPM Application Team
+  * @brief   Header for pmic_emul.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef PMIC_EMUL_H
+#define PMIC_EMUL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#if defined(USE_PMIC_EMULATION)
+#include "main.h"
+#include "pmic_util.h"
+#include "pmic_model.h"
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct
+{
+  uint32_t Type;          /* Emulated PMIC, pmic_types, PMIC_MAX for no PMIC on the bus */
+  uint32_t ProgramDelay;  /* Duration of the NVM programming, in ms */
+  uint32_t NackCount;     /* Number of next transfers not acknowledged */
+} PMIC_Emul_ConfigTypeDef;
+
+typedef PMIC_Model_StatsTypeDef PMIC_Emul_StatsTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+/* Exported macro ------------------------------------------------------------*/
+/* The pmic utilities use the emulated PMIC instead of the I2C bus */
+#define HAL_I2C_Init                    PMIC_Emul_I2C_Init
+#define HAL_I2C_Mem_Read                PMIC_Emul_I2C_Mem_Read
+#define HAL_I2C_Mem_Write               PMIC_Emul_I2C_Mem_Write
+#define HAL_I2C_GetError                PMIC_Emul_I2C_GetError
+
+/* Exported functions ------------------------------------------------------- */
+void PMIC_Emul_Config(const PMIC_Emul_ConfigTypeDef *pConfig);
+void PMIC_Emul_Erase(void);
+void PMIC_Emul_Reset(void);
+void PMIC_Emul_GetStats(PMIC_Emul_StatsTypeDef *pStats);
+void PMIC_Emul_ResetStats(void);
+uint32_t PMIC_Emul_GetTime(void);
+void PMIC_Emul_Delay(uint32_t Delay);
+
+HAL_StatusTypeDef PMIC_Emul_I2C_Init(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef PMIC_Emul_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                         uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef PMIC_Emul_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                          uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+uint32_t PMIC_Emul_I2C_GetError(I2C_HandleTypeDef *hi2c);
+
+#endif /* USE_PMIC_EMULATION */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PMIC_EMUL_H */
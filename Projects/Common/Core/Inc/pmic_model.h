@@ -0,0 +1,88 @@
+/**
+  ******************************************************************************
+  * @file    pmic_model.h
+  * @author  GPM Application Team
+  * @brief   Header for pmic_model.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef PMIC_MODEL_H
+#define PMIC_MODEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#if defined(USE_PMIC_EMULATION)
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+typedef uint32_t (*PMIC_Model_TimeTypeDef)(void);
+
+typedef struct
+{
+  uint32_t Type;                /* Modeled PMIC, PMIC_MODEL_NONE for no PMIC on the bus */
+  uint32_t ProgramDelay;        /* Duration of the NVM programming, in ms */
+  uint32_t NackCount;           /* Number of next transfers not acknowledged */
+  PMIC_Model_TimeTypeDef Time;  /* Returns the current time in us, NULL for instant programming */
+} PMIC_Model_ConfigTypeDef;
+
+typedef struct
+{
+  uint32_t ReadCount;     /* Number of read transfers */
+  uint32_t WriteCount;    /* Number of write transfers */
+  uint32_t ReadBytes;     /* Number of registers read */
+  uint32_t WriteBytes;    /* Number of registers written */
+  uint32_t NackCount;     /* Number of transfers not acknowledged */
+  uint32_t ProgCount;     /* Number of NVM programmings */
+  uint32_t BusyPolls;     /* Number of NVM status reads while busy */
+} PMIC_Model_StatsTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+/* Modeled PMICs */
+#define PMIC_MODEL_STPMIC25             0U
+#define PMIC_MODEL_STPMIC1              1U
+#define PMIC_MODEL_NONE                 2U
+
+#define PMIC_MODEL_I2C_ADDRESS          0x66U  /* 7-bit address 0x33, shifted */
+#define PMIC_MODEL_REG_NUMBER           256U
+#define PMIC_MODEL_PRODUCT_ID_ADDR      0x00U  /* Product ID register */
+#define PMIC_MODEL_NVM_BUSY_MSK         0x01U  /* NVM status register busy bit */
+#define PMIC_MODEL_NVM_CMD_MSK          0x03U
+#define PMIC_MODEL_NVM_CMD_PROGRAM      0x01U  /* Shadow registers programmed in NVM */
+#define PMIC_MODEL_NVM_CMD_READ         0x02U  /* Shadow registers reloaded from NVM */
+
+/* Status of the transfers */
+#define PMIC_MODEL_OK                   0
+#define PMIC_MODEL_NACK                 -1     /* Address not acknowledged */
+#define PMIC_MODEL_PARAM_ERROR          -2     /* Registers out of the map */
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void PMIC_Model_Config(const PMIC_Model_ConfigTypeDef *pConfig);
+void PMIC_Model_Erase(void);
+void PMIC_Model_Reset(void);
+int PMIC_Model_Read(uint16_t DevAddress, uint16_t Reg, uint8_t *pData, uint16_t Size);
+int PMIC_Model_Write(uint16_t DevAddress, uint16_t Reg, const uint8_t *pData, uint16_t Size);
+void PMIC_Model_GetStats(PMIC_Model_StatsTypeDef *pStats);
+void PMIC_Model_ResetStats(void);
+
+#endif /* USE_PMIC_EMULATION */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PMIC_MODEL_H */
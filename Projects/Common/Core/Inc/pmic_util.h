@@ -30,6 +30,7 @@ extern "C" {
 
 
 /* Exported types ------------------------------------------------------------*/
+#define MAX_PMIC_NVM_SIZE            64
 
 typedef enum
 {
@@ -37,6 +38,14 @@ typedef enum
   PMIC_SHADOW_READ,
 } pmic_nvm_ops_t;
 
+typedef enum
+{
+  PMIC_I2C_STANDARD,                     /* Standard-mode, 100 kHz */
+  PMIC_I2C_FAST,                         /* Fast-mode, 400 kHz */
+  PMIC_I2C_FAST_PLUS,                    /* Fast-mode Plus, 1 MHz */
+  PMIC_I2C_SPEED_NUMBER,
+} pmic_i2c_speed_t;
+
 typedef struct __attribute__ ((aligned (4)))
 {
   int8_t     Supported;
@@ -46,8 +55,30 @@ typedef struct __attribute__ ((aligned (4)))
   uint8_t    NVMStartAddress;
   uint8_t    NVMSRRegisterAddr;
   uint8_t    NVMCRRegisterAddr;
+  uint8_t    AutoIncrement;     /* 1 if the register address is incremented during a multi-byte access */
+  uint8_t    MaxSpeed;          /* Fastest I2C bus speed supported, pmic_i2c_speed_t */
 } pmic_data_t;
 
+typedef struct
+{
+  uint8_t    DirtyCount;        /* Number of registers which differed from the requested values */
+  uint8_t    WriteCount;        /* Number of I2C write transactions */
+  uint64_t   DirtyMap;          /* Bit n set if NVM register n was written */
+  uint64_t   ErrorMap;          /* Bit n set if NVM register n does not hold its requested value */
+  uint32_t   ProgTime;          /* Duration of the NVM programming, in ms */
+} pmic_write_result_t;
+
+typedef struct
+{
+  bool         BusReady;                 /* I2C instance and pins are configured */
+  uint8_t      BusSpeed;                 /* Current I2C bus speed, pmic_i2c_speed_t */
+  uint32_t     BusFreq;                  /* SCL frequency of the current bus speed, in kHz */
+  uint32_t     Status;                   /* Result of the last PMIC detection */
+  pmic_data_t  Pmic;                     /* Detected PMIC */
+  bool         NVMValid;                 /* NVM holds the PMIC NVM content */
+  uint8_t      NVM[MAX_PMIC_NVM_SIZE];   /* Last read or programmed NVM shadow registers */
+} pmic_context_t;
+
 /* Exported constants --------------------------------------------------------*/
 
 typedef enum
@@ -66,8 +97,12 @@ typedef enum
 #define OWN_I2C_SLAVE_ADDRESS       0x33
 #define PMIC_NVM_BUSY_MSK           0x01
 #define PMIC_I2C_ADDRESS        ((0x33U & 0x7FU) << 1) /* NVM Default   */
-#define PMIC_SR_REG_TIMEOUT        1000U
-#define MAX_PMIC_NVM_SIZE            64
+#define PMIC_SR_REG_TIMEOUT        1000U  /* Max NVM programming duration, in ms */
+#define PMIC_NVM_POLL_MIN_US       500U   /* First wait between two NVM status reads, in us */
+#define PMIC_NVM_POLL_MAX_US       8000U  /* Longest wait between two NVM status reads, in us */
+#define PMIC_NVM_PROG_TIME         50U    /* NVM programming duration until it is measured, in ms */
+#define PMIC_I2C_RECOVERY_PULSES   9U     /* SCL pulses to release a slave holding SDA low */
+#define PMIC_I2C_RECOVERY_HALF_US  5U     /* SCL half period of the bus recovery, 100 kHz */
 #if defined (STM32MP157Cxx)
 #define BUS_I2C_INSTANCE                      I2C4
 #define BUS_I2C_CLK_ENABLE()                  __HAL_RCC_I2C4_CLK_ENABLE()
@@ -77,6 +112,8 @@ typedef enum
 #define BUS_I2C_SDA_GPIO_CLK_ENABLE()         __HAL_RCC_GPIOZ_CLK_ENABLE()
 #define BUS_I2C_SDA_GPIO_CLK_DISABLE()        __HAL_RCC_GPIOZ_CLK_DISABLE()
 
+#define BUS_I2C_PERIPHCLK                     RCC_PERIPHCLK_I2C46
+
 #define BUS_I2C_FORCE_RESET()                 __HAL_RCC_I2C4_FORCE_RESET()
 #define BUS_I2C_RELEASE_RESET()               __HAL_RCC_I2C4_RELEASE_RESET()
 
@@ -92,7 +129,7 @@ typedef enum
 #define BUS_I2C_EV_IRQn                       I2C4_EV_IRQn
 #define BUS_I2C_ER_IRQn                       I2C4_ER_IRQn
 
-/* I2C TIMING Register define when I2C clock source is SYSCLK */
+/* I2C TIMING Register define when the kernel clock frequency is unknown */
 /* I2C TIMING is calculated from Bus clock (HSI) = 64 MHz */
 
 #ifndef BUS_I2Cx_TIMING
@@ -108,6 +145,8 @@ typedef enum
 #define BUS_I2C_SDA_GPIO_CLK_ENABLE()         __HAL_RCC_GPIOB_CLK_ENABLE()
 #define BUS_I2C_SDA_GPIO_CLK_DISABLE()        __HAL_RCC_GPIOB_CLK_DISABLE()
 
+#define BUS_I2C_PERIPHCLK                     RCC_PERIPHCLK_I2C4
+
 #define BUS_I2C_FORCE_RESET()                 __HAL_RCC_I2C4_FORCE_RESET()
 #define BUS_I2C_RELEASE_RESET()               __HAL_RCC_I2C4_RELEASE_RESET()
 
@@ -123,7 +162,7 @@ typedef enum
 #define BUS_I2C_EV_IRQn                       I2C4_EV_IRQn
 #define BUS_I2C_ER_IRQn                       I2C4_ER_IRQn
 
-/* I2C TIMING Register define when I2C clock source is SYSCLK */
+/* I2C TIMING Register define when the kernel clock frequency is unknown */
 /* I2C TIMING is calculated from Bus clock (HSI) = 64 MHz */
 
 #ifndef BUS_I2Cx_TIMING
@@ -138,6 +177,8 @@ typedef enum
 #define BUS_I2C_SDA_GPIO_CLK_ENABLE()         __HAL_RCC_GPIOD_CLK_ENABLE()
 #define BUS_I2C_SDA_GPIO_CLK_DISABLE()        __HAL_RCC_GPIOD_CLK_DISABLE()
 
+#define BUS_I2C_PERIPHCLK                     RCC_PERIPHCLK_I2C7
+
 #define BUS_I2C_FORCE_RESET()                 __HAL_RCC_I2C7_FORCE_RESET()
 #define BUS_I2C_RELEASE_RESET()               __HAL_RCC_I2C7_RELEASE_RESET()
 
@@ -153,7 +194,7 @@ typedef enum
 #define BUS_I2C_EV_IRQn                       I2C7_EV_IRQn
 #define BUS_I2C_ER_IRQn                       I2C7_ER_IRQn
 
-/* I2C TIMING Register define when I2C clock source is SYSCLK */
+/* I2C TIMING Register define when the kernel clock frequency is unknown */
 /* I2C TIMING is calculated from Bus clock (HSI) = 64 MHz */
 
 #ifndef BUS_I2Cx_TIMING
@@ -168,15 +209,22 @@ typedef enum
 #define PMIC_ERROR_NO_PMIC                     0x01U
 #define PMIC_ERROR_INVALID_PMIC                0x02U
 #define PMIC_ERROR_INVALID_ARG                 0x03U
+#define PMIC_ERROR_I2C                         0x04U
+#define PMIC_ERROR_NVM_TIMEOUT                 0x05U
+#define PMIC_ERROR_VERIFY                      0x06U  /* Shadow registers read back differ, NVM not programmed */
 
 #define PMIC_PROTOCOL_VERSION                  1U
 #define PMIC_PROTOCOL_HEADER_SIZE              8 /* Bytes */
 
 /* Exported functions ------------------------------------------------------- */
 void PMIC_Util_Init(void);
-void PMIC_Util_ReadWrite(uint8_t *addr, pmic_nvm_ops_t ops, pmic_data_t * pmic_data);
+uint32_t PMIC_Util_ReadWrite(uint8_t *addr, pmic_nvm_ops_t ops, pmic_data_t * pmic_data);
 uint32_t PMIC_Util_Detect_PMIC(pmic_data_t * pmic_detected);
 uint8_t PMIC_Util_GetNVMID(void);
+pmic_context_t *PMIC_Util_GetContext(void);
+pmic_context_t *PMIC_Util_Redetect(void);
+void PMIC_Util_GetWriteResult(pmic_write_result_t *result);
+uint32_t PMIC_Util_GetProgTime(void);
 
 #ifdef __cplusplus
 }
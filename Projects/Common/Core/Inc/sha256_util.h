@@ -0,0 +1,54 @@
+/**
+  ******************************************************************************
+  * @file    sha256_util.h
+  * @author  MCD Application Team
+  * @brief   Header for sha256_util.c module
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef SHA256_UTIL_H
+#define SHA256_UTIL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct
+{
+  uint32_t State[8];    /* Intermediate hash value */
+  uint32_t Block[16];   /* Message block being filled, as big-endian words */
+  uint32_t Index;       /* Number of bytes in the message block */
+  uint64_t Length;      /* Total message length in bytes */
+} SHA256_Util_ContextTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+#define SHA256_DIGEST_SIZE              32U
+#define SHA256_BLOCK_SIZE               64U
+
+/* Exported macro ------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------- */
+void SHA256_Util_Init(SHA256_Util_ContextTypeDef *pCtx);
+void SHA256_Util_Update(SHA256_Util_ContextTypeDef *pCtx, const uint8_t *pData, uint32_t Size);
+void SHA256_Util_UpdateWord(SHA256_Util_ContextTypeDef *pCtx, uint32_t Word);
+void SHA256_Util_Final(SHA256_Util_ContextTypeDef *pCtx, uint8_t *pDigest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHA256_UTIL_H */
@@ -19,16 +19,48 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "console_util.h"
+#include <stdbool.h>
 #include <stdio.h>
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
-#define HAL_TIMEOUT_VALUE   HAL_MAX_DELAY
+#define SERIAL_CHAR_BELL      0x07U
+#define SERIAL_CHAR_BACKSPACE 0x08U
+#define SERIAL_CHAR_LF        0x0AU
+#define SERIAL_CHAR_CR        0x0DU
+#define SERIAL_CHAR_CANCEL    0x18U
+#define SERIAL_CHAR_DELETE    0x7FU
 
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /* UART handler declaration, used for logging */
 UART_HandleTypeDef huart;
+
+#ifndef __TERMINAL_IO__
+/* Received characters, filled by the UART interrupt and emptied by the console */
+static uint8_t rx_buffer[SERIAL_RX_BUFFER_SIZE];
+static volatile uint32_t rx_head = 0U;
+static volatile uint32_t rx_tail = 0U;
+#endif /* __TERMINAL_IO__ */
+
+#ifndef __TERMINAL_IO__
+/* Characters to transmit, emptied by the UART interrupt */
+static uint8_t tx_buffer[SERIAL_TX_BUFFER_SIZE];
+static volatile uint32_t tx_head = 0U;
+static volatile uint32_t tx_tail = 0U;
+static bool tx_ready = false;
+
+/* printf output is given to the ring a line at a time */
+static char stdout_buffer[SERIAL_STDOUT_BUFFER_SIZE];
+#endif /* __TERMINAL_IO__ */
+
+/* Line terminated by a CR, a following LF is not a new entry */
+static bool rx_last_cr = false;
+
 /* Private function prototypes -----------------------------------------------*/
+static uint8_t Serial_GetChar(void);
+#ifndef __TERMINAL_IO__
+static void Serial_Write(const char *data, uint32_t len);
+#endif /* __TERMINAL_IO__ */
 /* Exported variables --------------------------------------------------------*/
 /* Exported functions --------------------------------------------------------*/
 
@@ -46,10 +78,10 @@ void UART_Config(void)
                       BE CAREFUL : Program 7 data bits + 1 parity bit in PC HyperTerminal
       - Stop Bit    = One Stop bit
       - Parity      = parity none
-      - BaudRate    = 115200 baud
+      - BaudRate    = CONSOLE_BAUDRATE, 115200 baud by default
       - Hardware flow control disabled (RTS and CTS signals) */
   huart.Instance        = USARTx;
-  huart.Init.BaudRate   = MX_UART_BAUDRATE;
+  huart.Init.BaudRate   = CONSOLE_BAUDRATE;
   huart.Init.WordLength = MX_UART_WORDLENGTH;
   huart.Init.StopBits   = MX_UART_STOPBITS;
   huart.Init.Parity     = MX_UART_PARITY;
@@ -94,6 +126,230 @@ void UART_Config(void)
     Error_Handler();
   }
 
+#ifndef __TERMINAL_IO__
+  /* Characters are received under interrupt, none is lost while the console
+     is busy printing or programming */
+  rx_head = 0U;
+  rx_tail = 0U;
+  __HAL_UART_ENABLE_IT(&huart, UART_IT_RXFNE);
+
+  /* Characters are transmitted under interrupt, the TX FIFO not full
+     interrupt is enabled while the ring is not empty */
+  tx_head = 0U;
+  tx_tail = 0U;
+  tx_ready = true;
+  (void)setvbuf(stdout, stdout_buffer, _IOLBF, SERIAL_STDOUT_BUFFER_SIZE);
+
+#if defined(CORE_CA7)
+  IRQ_SetPriority((IRQn_ID_t)USARTx_IRQn, SERIAL_IRQ_PRIORITY);
+  IRQ_Enable((IRQn_ID_t)USARTx_IRQn);
+#else
+  GIC_SetPriority(USARTx_IRQn, SERIAL_IRQ_PRIORITY);
+  GIC_EnableIRQ(USARTx_IRQn);
+#endif /* CORE_CA7 */
+#endif /* __TERMINAL_IO__ */
+}
+
+/**
+  * @brief  Handle the console UART interrupt: move the received characters
+  *         from the RX FIFO to the ring buffer, they are dropped when it is full,
+  *         and fill the TX FIFO from the characters to transmit.
+  * @param  None
+  * @retval None
+  */
+void Serial_IRQHandler(void)
+{
+#ifndef __TERMINAL_IO__
+  uint8_t data;
+
+  /* Overrun and line errors are not reported to the console */
+  __HAL_UART_CLEAR_FLAG(&huart, UART_CLEAR_OREF | UART_CLEAR_NEF | UART_CLEAR_FEF | UART_CLEAR_PEF);
+
+  while (__HAL_UART_GET_FLAG(&huart, UART_FLAG_RXFNE) != 0U)
+  {
+    data = (uint8_t)(huart.Instance->RDR & 0xFFU);
+
+    if ((rx_head - rx_tail) < SERIAL_RX_BUFFER_SIZE)
+    {
+      rx_buffer[rx_head & (SERIAL_RX_BUFFER_SIZE - 1U)] = data;
+      rx_head++;
+    }
+  }
+
+  if (__HAL_UART_GET_IT_SOURCE(&huart, UART_IT_TXFNF) != 0U)
+  {
+    while ((tx_head != tx_tail) && (__HAL_UART_GET_FLAG(&huart, UART_FLAG_TXFNF) != 0U))
+    {
+      huart.Instance->TDR = tx_buffer[tx_tail & (SERIAL_TX_BUFFER_SIZE - 1U)];
+      tx_tail++;
+    }
+
+    if (tx_head == tx_tail)
+    {
+      __HAL_UART_DISABLE_IT(&huart, UART_IT_TXFNF);
+    }
+  }
+#endif /* __TERMINAL_IO__ */
+}
+
+#ifndef __TERMINAL_IO__
+/**
+  * @brief  Queue characters to transmit, wait for room when the ring is full.
+  *         They are dropped while the UART is not configured.
+  * @param  data: characters to transmit
+  * @param  len: number of characters
+  * @retval None
+  */
+static void Serial_Write(const char *data, uint32_t len)
+{
+  uint32_t idx;
+
+  if (!tx_ready)
+  {
+    return;
+  }
+
+  for (idx = 0U; idx < len; idx++)
+  {
+    while ((tx_head - tx_tail) >= SERIAL_TX_BUFFER_SIZE)
+    {
+    }
+
+    tx_buffer[tx_head & (SERIAL_TX_BUFFER_SIZE - 1U)] = (uint8_t)data[idx];
+    tx_head++;
+    __HAL_UART_ENABLE_IT(&huart, UART_IT_TXFNF);
+  }
+}
+#endif /* __TERMINAL_IO__ */
+
+/**
+  * @brief  Wait for the end of the console output.
+  * @param  None
+  * @retval None
+  */
+void Serial_Flush(void)
+{
+  (void)fflush(stdout);
+
+#ifndef __TERMINAL_IO__
+  if (!tx_ready)
+  {
+    return;
+  }
+
+  while (tx_head != tx_tail)
+  {
+  }
+
+  while (__HAL_UART_GET_FLAG(&huart, UART_FLAG_TC) == 0U)
+  {
+  }
+#endif /* __TERMINAL_IO__ */
+}
+
+/**
+  * @brief  Wait for the next received character.
+  * @param  None
+  * @retval The character received
+  */
+static uint8_t Serial_GetChar(void)
+{
+  uint8_t data;
+
+#ifndef __TERMINAL_IO__
+  /* The console waits for the user, the pending output is not kept in the
+     printf buffer */
+  if (rx_head == rx_tail)
+  {
+    (void)fflush(stdout);
+  }
+
+  while (rx_head == rx_tail)
+  {
+  }
+
+  data = rx_buffer[rx_tail & (SERIAL_RX_BUFFER_SIZE - 1U)];
+  rx_tail++;
+#else
+  data = (uint8_t)getchar();
+#endif /* __TERMINAL_IO__ */
+
+  return data;
+}
+
+/**
+  * @brief  Read a line from the Hyperterminal, with echo and line editing:
+  *         backspace or delete erases the last character, cancel erases the
+  *         line, CR, LF or CR LF ends it. The characters beyond the size of
+  *         the line are dropped.
+  * @param  line: buffer filled with the null terminated line
+  * @param  size: size of the buffer
+  * @retval Length of the line
+  */
+uint32_t Serial_GetLine(char *line, uint32_t size)
+{
+  uint32_t len = 0U;
+  uint8_t data;
+
+  while (1)
+  {
+    data = Serial_GetChar();
+
+    /* LF of a CR LF sequence */
+    if ((data == SERIAL_CHAR_LF) && rx_last_cr)
+    {
+      rx_last_cr = false;
+      continue;
+    }
+    rx_last_cr = (data == SERIAL_CHAR_CR);
+
+    if ((data == SERIAL_CHAR_CR) || (data == SERIAL_CHAR_LF))
+    {
+      break;
+    }
+
+#ifndef __TERMINAL_IO__
+    if ((data == SERIAL_CHAR_BACKSPACE) || (data == SERIAL_CHAR_DELETE))
+    {
+      if (len > 0U)
+      {
+        len--;
+        Serial_Printf("\b \b", 3);
+      }
+    }
+    else if (data == SERIAL_CHAR_CANCEL)
+    {
+      while (len > 0U)
+      {
+        len--;
+        Serial_Printf("\b \b", 3);
+      }
+    }
+    else if ((data < (uint8_t)' ') || (len >= (size - 1U)))
+    {
+      Serial_Putchar((char)SERIAL_CHAR_BELL);
+    }
+    else
+    {
+      line[len++] = (char)data;
+      Serial_Putchar((char)data);
+    }
+#else
+    if (len < (size - 1U))
+    {
+      line[len++] = (char)data;
+    }
+#endif /* __TERMINAL_IO__ */
+  }
+
+  line[len] = '\0';
+  printf("\r\n");
+
+#ifdef __TERMINAL_IO__
+  fflush(stdin);
+#endif /* __TERMINAL_IO__ */
+
+  return len;
 }
 
 /**
@@ -103,15 +359,9 @@ void UART_Config(void)
   */
 uint32_t Serial_Scanf(uint32_t value)
 {
-  uint16_t tmp = 0;
+  uint16_t tmp;
 
-#ifndef __TERMINAL_IO__
-  __HAL_UART_CLEAR_OREFLAG(&huart);
-  /* e.g. read a character from the EVAL_COM1 and Loop until RXNE = 1 */
-  HAL_UART_Receive(&huart, (uint8_t *)&tmp, 1, HAL_TIMEOUT_VALUE);
-#else
-  tmp = getchar();
-#endif
+  tmp = Serial_GetChar();
   if (tmp > value)
   {
     printf("\n\r  !!! Please enter valid number between 0 and %lu \n", value);
@@ -128,8 +378,9 @@ uint32_t Serial_Scanf(uint32_t value)
 void Serial_Putchar(char value)
 {
 #ifndef __TERMINAL_IO__
-  /* e.g. read a character from the EVAL_COM1 and Loop until RXNE = 1 */
-  HAL_UART_Transmit(&huart, (uint8_t *)&value, 1, HAL_TIMEOUT_VALUE);
+  /* Keep the order with the printf output */
+  (void)fflush(stdout);
+  Serial_Write(&value, 1U);
 #endif
 }
 
@@ -141,7 +392,27 @@ void Serial_Putchar(char value)
 void Serial_Printf(char *value, int len)
 {
 #ifndef __TERMINAL_IO__
-  /* e.g. read a character from the EVAL_COM1 and Loop until RXNE = 1 */
-  HAL_UART_Transmit(&huart, (uint8_t *)value, len, HAL_TIMEOUT_VALUE);
+  /* Keep the order with the printf output */
+  (void)fflush(stdout);
+  Serial_Write(value, (uint32_t)len);
 #endif
 }
+
+#if defined(__CONSOLE__) && !defined(__TERMINAL_IO__) && !defined(__VALID_OUTPUT_TERMINAL_IO__)
+/**
+  * @brief  printf output, the whole buffer is queued to the UART instead of
+  *         being transmitted a character at a time.
+  * @param  file: file descriptor, unused
+  * @param  ptr: characters to transmit
+  * @param  len: number of characters
+  * @retval Number of characters written
+  */
+int _write(int file, char *ptr, int len)
+{
+  UNUSED(file);
+
+  Serial_Write(ptr, (uint32_t)len);
+
+  return len;
+}
+#endif /* __CONSOLE__ && !__TERMINAL_IO__ && !__VALID_OUTPUT_TERMINAL_IO__ */
@@ -0,0 +1,60 @@
+/**
+  ******************************************************************************
+  * @file    crc32_util.c
+  * @author  MCD Application Team
+  * @brief   CRC-32 (IEEE 802.3, reflected) shared by the bootloader and the
+  *          consoles: flashlayout, memory digests, otp profiles and pmic
+  *          images. The table is indexed per nibble to stay small.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "crc32_util.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* CRC-32 (IEEE 802.3, reflected) lookup table, one entry per nibble */
+static const uint32_t crc32_nibble_table[16] =
+{
+  0x00000000U, 0x1DB71064U, 0x3B6E20C8U, 0x26D930ACU,
+  0x76DC4190U, 0x6B6B51F4U, 0x4DB26158U, 0x5005713CU,
+  0xEDB88320U, 0xF00F9344U, 0xD6D6A3E8U, 0xCB61B38CU,
+  0x9B64C2B0U, 0x86D3D2D4U, 0xA00AE278U, 0xBDBDF21CU
+};
+
+/* Private function prototypes -----------------------------------------------*/
+/* Functions Definition ------------------------------------------------------*/
+/**
+  * @brief  Update a CRC-32 (IEEE 802.3) with a buffer.
+  *         Chained calls give the same result as a single call over the
+  *         concatenated buffers, starting from 0.
+  * @param  Crc: CRC-32 of the previous data, 0 for the first call
+  * @param  pData: pointer to the data
+  * @param  Size: size of the data in bytes
+  * @retval Updated CRC-32.
+  */
+uint32_t CRC32_Util_Compute(uint32_t Crc, const uint8_t *pData, uint32_t Size)
+{
+  Crc = ~Crc;
+
+  while (Size-- > 0U)
+  {
+    Crc ^= *pData++;
+    Crc = (Crc >> 4) ^ crc32_nibble_table[Crc & 0xFU];
+    Crc = (Crc >> 4) ^ crc32_nibble_table[Crc & 0xFU];
+  }
+
+  return ~Crc;
+}
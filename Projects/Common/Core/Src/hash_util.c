@@ -19,14 +19,23 @@
 /* Includes ------------------------------------------------------------------*/
 #if defined(USE_HASH_OVER_OTP)
 #include "hash_util.h"
+#if !defined(HAL_HASH_MODULE_ENABLED)
+#include "sha256_util.h"
+#endif /* !HAL_HASH_MODULE_ENABLED */
 
 /* Global variables ----------------------------------------------------------*/
 /* Private typedef -----------------------------------------------------------*/
 /* Private defines -----------------------------------------------------------*/
+#define HASH_TIMEOUT                    1000U
 /* Private macros ------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+#if defined(HAL_HASH_MODULE_ENABLED)
 static HASH_HandleTypeDef hhash;
 static uint8_t Hash_Initialized = 0U;
+#endif /* HAL_HASH_MODULE_ENABLED */
+static uint8_t Hash_Valid = 0U;
+static uint32_t Hash_Generation;
+static uint8_t Hash_Digest[OTP_HASH_SIZE];
 /* Private function prototypes -----------------------------------------------*/
 /* Functions Definition ------------------------------------------------------*/
 /**
@@ -36,12 +45,14 @@ static uint8_t Hash_Initialized = 0U;
   */
 void HASH_Util_Init(void)
 {
+#if defined(HAL_HASH_MODULE_ENABLED)
   hhash.Instance = HASH;
   HAL_HASH_DeInit(&hhash);
   hhash.Init.DataType = HASH_NO_SWAP;
   hhash.Init.Algorithm = HASH_ALGOSELECTION_SHA256;
   HAL_HASH_Init(&hhash);
   Hash_Initialized = 1U;
+#endif /* HAL_HASH_MODULE_ENABLED */
 }
 /**
   * @brief  DeIntialize the hash instance.
@@ -50,29 +61,86 @@ void HASH_Util_Init(void)
   */
 void HASH_Util_DeInit(void)
 {
+#if defined(HAL_HASH_MODULE_ENABLED)
   HAL_HASH_DeInit(&hhash);
   Hash_Initialized = 0;
+#endif /* HAL_HASH_MODULE_ENABLED */
 }
 /**
   * @brief  calculate the hash over OTP.
   * @param  OTP structure pointer
   * @retval Status.
+  * @note   The digest is kept until the otp are programmed again, the otp
+  *         values are fed to the peripheral in place, without status words.
+  *         Devices without HASH peripheral use the software SHA-256.
   */
 HAL_StatusTypeDef HASH_Util_calculate(Otp_TypeDef *Otp_p)
 {
-  HAL_StatusTypeDef status = HAL_ERROR;
-  volatile uint32_t LocalOtpPart[OTP_HASH_PART_SIZE / 2] = {0};
+  HAL_StatusTypeDef status = HAL_OK;
+  uint32_t index;
+#if !defined(HAL_HASH_MODULE_ENABLED)
+  SHA256_Util_ContextTypeDef ctx;
+#endif /* !HAL_HASH_MODULE_ENABLED */
+
+  /* Reuse the digest if no otp was programmed since it was computed */
+  if (HASH_Util_IsValid() != 0U)
+  {
+    memcpy(&Otp_p->Sha256Hash[0], Hash_Digest, OTP_HASH_SIZE);
+    return HAL_OK;
+  }
+
+#if defined(HAL_HASH_MODULE_ENABLED)
   if (Hash_Initialized == 0)
   {
     HASH_Util_Init();
   }
-  /* copy only OTP values not status for 376 words */
-  for (uint32_t i = 0, index = 0; index < OTP_HASH_PART_SIZE; index += 2, i++)
+
+  /* Feed only OTP values not status for 376 words */
+  for (index = 0; (index < (OTP_HASH_PART_SIZE - 2U)) && (status == HAL_OK); index += 2)
+  {
+    status = HAL_HASH_Accumulate(&hhash, (uint8_t *)&Otp_p->OtpPart[index], 4U, HASH_TIMEOUT);
+  }
+
+  if (status == HAL_OK)
+  {
+    status = HAL_HASH_AccumulateLast(&hhash, (uint8_t *)&Otp_p->OtpPart[OTP_HASH_PART_SIZE - 2U], 4U,
+                                     &Otp_p->Sha256Hash[0], HASH_TIMEOUT);
+  }
+
+  if (status != HAL_OK)
   {
-    LocalOtpPart[i] = Otp_p->OtpPart[index];
+    /* Restart the peripheral on next calculation */
+    HASH_Util_DeInit();
+    Hash_Valid = 0U;
+    return status;
   }
-  status = HAL_HASH_Start(&hhash, (uint8_t *)&LocalOtpPart[0], sizeof(LocalOtpPart),
-		                                   (uint8_t *)&Otp_p->Sha256Hash[0], 1000);
+#else
+  SHA256_Util_Init(&ctx);
+
+  /* Feed only OTP values not status */
+  for (index = 0; index < OTP_HASH_PART_SIZE; index += 2)
+  {
+    SHA256_Util_UpdateWord(&ctx, Otp_p->OtpPart[index]);
+  }
+
+  SHA256_Util_Final(&ctx, &Otp_p->Sha256Hash[0]);
+#endif /* HAL_HASH_MODULE_ENABLED */
+
+  memcpy(Hash_Digest, &Otp_p->Sha256Hash[0], OTP_HASH_SIZE);
+  Hash_Generation = OTP_Util_GetGeneration();
+  Hash_Valid = 1U;
+
   return status;
 }
+
+/**
+  * @brief  Check if the kept digest matches the otp values.
+  * @param  None
+  * @retval 1 if no otp was programmed since the digest was computed, 0 otherwise.
+  * @note   The otp values need then not be read before HASH_Util_calculate.
+  */
+uint8_t HASH_Util_IsValid(void)
+{
+  return ((Hash_Valid != 0U) && (Hash_Generation == OTP_Util_GetGeneration())) ? 1U : 0U;
+}
 #endif /* USE_HASH_OVER_OTP */
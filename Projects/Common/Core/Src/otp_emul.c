@@ -0,0 +1,396 @@
+/**
+  ******************************************************************************
+  * @file    otp_emul.c
+  * @author  MCD Application Team
+  * @brief   Emulated BSEC fuses, used instead of the BSEC ones when
+  *          USE_OTP_EMULATION is defined. The BSEC HAL functions are mapped
+  *          on the fuses model of otp_model.c, which keeps the fuses in RAM.
+  *          Programming and reload durations and a fuse failing on reload
+  *          can be configured, so that OTP provisioning can be rehearsed and
+  *          timed on a board without blowing any fuse.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#if defined(USE_OTP_EMULATION)
+#include "otp_emul.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#if (OTP_MODEL_WORD_NUMBER != OTP_VALUE_SIZE)
+#error "The fuses model size does not match the otp words number"
+#endif /* OTP_MODEL_WORD_NUMBER */
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Functions Definition ------------------------------------------------------*/
+/**
+  * @brief Configure the emulated fuses
+  * @param pConfig: pointer to the emulation configuration
+  * @retval None
+  */
+void OTP_Emul_Config(const OTP_Emul_ConfigTypeDef *pConfig)
+{
+  OTP_Model_ConfigTypeDef config = *pConfig;
+
+  if (config.Delay == NULL)
+  {
+    config.Delay = HAL_Delay;
+  }
+
+  OTP_Model_Config(&config);
+}
+
+/**
+  * @brief Blank all the emulated fuses and their locks
+  * @param None
+  * @retval None
+  */
+void OTP_Emul_Erase(void)
+{
+  OTP_Model_Erase();
+}
+
+/**
+  * @brief Emulate a reset: sticky locks are released and all the fuses reloaded
+  * @param None
+  * @retval None
+  */
+void OTP_Emul_Reset(void)
+{
+  OTP_Model_Reset();
+}
+
+#if defined(BSEC_API_CHANGE)
+/**
+  * @brief Reload and read a fuse
+  * @param pHbsec: pointer to the BSEC handle
+  * @param FuseId: fuse number
+  * @param pFuseData: pointer to the fuse value
+  * @retval HAL status
+  */
+HAL_StatusTypeDef OTP_Emul_OTP_Read(BSEC_HandleTypeDef *const pHbsec, uint32_t FuseId, uint32_t *pFuseData)
+{
+  switch (OTP_Model_Read(FuseId, pFuseData))
+  {
+    case OTP_MODEL_OK:
+      pHbsec->ErrorCode = HAL_BSEC_ERROR_NONE;
+      return HAL_OK;
+
+    case OTP_MODEL_PARAM_ERROR:
+      pHbsec->ErrorCode = HAL_BSEC_PARAM_ERROR;
+      break;
+
+    /* The reload is denied, the shadow register keeps its value */
+    case OTP_MODEL_STICKY_LOCKED:
+      pHbsec->ErrorCode = HAL_BSEC_LOCK_ERROR;
+      break;
+
+    default:
+      pHbsec->ErrorCode = HAL_BSEC_DED_ERROR;
+      break;
+  }
+
+  return HAL_ERROR;
+}
+
+/**
+  * @brief Program a fuse, then reload and check it
+  * @param pHbsec: pointer to the BSEC handle
+  * @param FuseId: fuse number
+  * @param FuseData: requested fuse value
+  * @param Lock: HAL_BSEC_LOCK_PROG to permanently lock the fuse
+  * @retval HAL status
+  */
+HAL_StatusTypeDef OTP_Emul_OTP_Program(BSEC_HandleTypeDef *pHbsec, uint32_t FuseId, uint32_t FuseData, uint32_t Lock)
+{
+  uint32_t value = 0U;
+  int ret;
+
+  ret = OTP_Model_Program(FuseId, FuseData);
+
+  if (ret == OTP_MODEL_PARAM_ERROR)
+  {
+    pHbsec->ErrorCode = HAL_BSEC_PARAM_ERROR;
+    return HAL_ERROR;
+  }
+
+  if ((ret != OTP_MODEL_OK) || (OTP_Model_Read(FuseId, &value) != OTP_MODEL_OK) || (value != FuseData))
+  {
+    pHbsec->ErrorCode = HAL_BSEC_PROGFAIL_ERROR;
+    return HAL_ERROR;
+  }
+
+  pHbsec->ErrorCode = HAL_BSEC_ERROR_NONE;
+
+  if (Lock == HAL_BSEC_LOCK_PROG)
+  {
+    (void)OTP_Model_Lock(FuseId, OTP_MODEL_PERM);
+  }
+
+  return HAL_OK;
+}
+
+/**
+  * @brief Sticky lock a fuse until reset
+  * @param pHbsec: pointer to the BSEC handle
+  * @param FuseId: fuse number
+  * @param Lock: HAL_BSEC_FUSE_PROG_LOCKED, HAL_BSEC_FUSE_WRITE_LOCKED and/or
+  *        HAL_BSEC_FUSE_RELOAD_LOCKED
+  * @retval HAL status
+  */
+HAL_StatusTypeDef OTP_Emul_OTP_Lock(BSEC_HandleTypeDef *pHbsec, uint32_t FuseId, uint32_t Lock)
+{
+  if (OTP_Model_Lock(FuseId, Lock & OTP_MODEL_STICKY_MASK) != OTP_MODEL_OK)
+  {
+    pHbsec->ErrorCode = HAL_BSEC_PARAM_ERROR;
+    return HAL_ERROR;
+  }
+
+  return HAL_OK;
+}
+
+/**
+  * @brief Get the locks of a fuse
+  * @param pHbsec: pointer to the BSEC handle
+  * @param FuseId: fuse number
+  * @param pState: pointer to the HAL_BSEC_FUSE_xxx flags
+  * @retval HAL status
+  */
+HAL_StatusTypeDef OTP_Emul_OTP_GetState(BSEC_HandleTypeDef *const pHbsec, uint32_t FuseId, uint32_t *pState)
+{
+  uint32_t lock;
+
+  if (OTP_Model_GetLock(FuseId, &lock) != OTP_MODEL_OK)
+  {
+    pHbsec->ErrorCode = HAL_BSEC_PARAM_ERROR;
+    return HAL_ERROR;
+  }
+
+  *pState = (lock & OTP_MODEL_STICKY_MASK) | (((lock & OTP_MODEL_PERM) != 0U) ? HAL_BSEC_FUSE_LOCKED : 0U);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief Read the shadow register of a fuse
+  * @param pHbsec: pointer to the BSEC handle
+  * @param RegId: fuse number
+  * @param pRegData: pointer to the shadow value
+  * @retval HAL status
+  */
+HAL_StatusTypeDef OTP_Emul_OTP_ReadShadow(BSEC_HandleTypeDef *const pHbsec, uint32_t RegId, uint32_t *pRegData)
+{
+  if (OTP_Model_ReadShadow(RegId, pRegData) != OTP_MODEL_OK)
+  {
+    pHbsec->ErrorCode = HAL_BSEC_PARAM_ERROR;
+    return HAL_ERROR;
+  }
+
+  return HAL_OK;
+}
+
+/**
+  * @brief Get the validity of the shadow register of a fuse
+  * @param pHbsec: pointer to the BSEC handle
+  * @param RegId: fuse number
+  * @param pValidity: pointer to HAL_BSEC_RELOAD_WITH_ERROR or HAL_BSEC_RELOAD_WITHOUT_ERROR
+  * @retval HAL status
+  */
+HAL_StatusTypeDef OTP_Emul_OTP_GetShadowState(BSEC_HandleTypeDef *const pHbsec, uint32_t RegId, uint32_t *pValidity)
+{
+  uint32_t lock;
+
+  if (OTP_Model_GetLock(RegId, &lock) != OTP_MODEL_OK)
+  {
+    pHbsec->ErrorCode = HAL_BSEC_PARAM_ERROR;
+    return HAL_ERROR;
+  }
+
+  *pValidity = ((lock & OTP_MODEL_SHADOW_ERROR) != 0U) ? HAL_BSEC_RELOAD_WITH_ERROR : HAL_BSEC_RELOAD_WITHOUT_ERROR;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief Get the device life cycle state
+  * @param pHbsec: pointer to the BSEC handle
+  * @param pState: pointer to HAL_BSEC_OPEN_STATE or HAL_BSEC_CLOSED_STATE
+  * @retval HAL status
+  */
+HAL_StatusTypeDef OTP_Emul_GetDeviceLifeCycleState(BSEC_HandleTypeDef *const pHbsec, uint32_t *pState)
+{
+  UNUSED(pHbsec);
+
+  *pState = (OTP_Model_IsClosed() != 0U) ? HAL_BSEC_CLOSED_STATE : HAL_BSEC_OPEN_STATE;
+
+  return HAL_OK;
+}
+#else
+/**
+  * @brief Reload and read an otp word
+  * @param hBsec: pointer to the BSEC handle
+  * @param otpWordIdx: otp word number
+  * @param pOtpShadowVal: pointer to the otp value
+  * @retval HAL status
+  */
+HAL_StatusTypeDef OTP_Emul_OtpRead(BSEC_HandleTypeDef *hBsec, uint32_t otpWordIdx, uint32_t *pOtpShadowVal)
+{
+  switch (OTP_Model_Read(otpWordIdx, pOtpShadowVal))
+  {
+    /* The shadow update is sticky locked, it keeps its value */
+    case OTP_MODEL_OK:
+    case OTP_MODEL_STICKY_LOCKED:
+      return HAL_OK;
+
+    case OTP_MODEL_PARAM_ERROR:
+      hBsec->Error = BSEC_ERROR_INVALID_PARAMETER;
+      break;
+
+    default:
+      break;
+  }
+
+  return HAL_ERROR;
+}
+
+/**
+  * @brief Program an otp word
+  * @param hBsec: pointer to the BSEC handle
+  * @param otpWordIdx: otp word number
+  * @param otpWordValReq: requested otp value
+  * @retval HAL status
+  */
+HAL_StatusTypeDef OTP_Emul_OtpProgram(BSEC_HandleTypeDef *hBsec, uint32_t otpWordIdx, uint32_t otpWordValReq)
+{
+  switch (OTP_Model_Program(otpWordIdx, otpWordValReq))
+  {
+    case OTP_MODEL_OK:
+      return HAL_OK;
+
+    case OTP_MODEL_PARAM_ERROR:
+      hBsec->Error = BSEC_ERROR_INVALID_PARAMETER;
+      break;
+
+    case OTP_MODEL_PERM_LOCKED:
+      hBsec->Error = BSEC_ERROR_PERM_LOCK_PROG;
+      break;
+
+    case OTP_MODEL_STICKY_LOCKED:
+      hBsec->Error = BSEC_ERROR_STICKY_LOCK_PROG;
+      break;
+
+    default:
+      break;
+  }
+
+  return HAL_ERROR;
+}
+
+/**
+  * @brief Sticky lock an otp word until reset
+  * @param hBsec: pointer to the BSEC handle
+  * @param otpWordIdx: otp word number
+  * @param stickyLockCmd: BSEC_OTP_STICKY_LOCK_xxx mask
+  * @retval HAL status
+  */
+HAL_StatusTypeDef OTP_Emul_SetOtpStickyLock(BSEC_HandleTypeDef *hBsec, uint32_t otpWordIdx, uint32_t stickyLockCmd)
+{
+  if (OTP_Model_Lock(otpWordIdx, stickyLockCmd & OTP_MODEL_STICKY_MASK) != OTP_MODEL_OK)
+  {
+    hBsec->Error = BSEC_ERROR_INVALID_PARAMETER;
+    return HAL_ERROR;
+  }
+
+  return HAL_OK;
+}
+
+/**
+  * @brief Get the sticky locks of an otp word
+  * @param hBsec: pointer to the BSEC handle
+  * @param otpWordIdx: otp word number
+  * @param pStickyLockStatus: pointer to the BSEC_OTP_STICKY_LOCK_xxx mask
+  * @retval HAL status
+  */
+HAL_StatusTypeDef OTP_Emul_GetOtpStickyLockStatus(BSEC_HandleTypeDef *hBsec, uint32_t otpWordIdx,
+                                                  uint32_t *pStickyLockStatus)
+{
+  uint32_t lock;
+
+  if (OTP_Model_GetLock(otpWordIdx, &lock) != OTP_MODEL_OK)
+  {
+    hBsec->Error = BSEC_ERROR_INVALID_PARAMETER;
+    return HAL_ERROR;
+  }
+
+  *pStickyLockStatus = lock & OTP_MODEL_STICKY_MASK;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief Permanently lock the programming of an otp word
+  * @param hBsec: pointer to the BSEC handle
+  * @param otpWordIdx: otp word number
+  * @retval HAL status
+  */
+HAL_StatusTypeDef OTP_Emul_SetOtpPermanentProgLock(BSEC_HandleTypeDef *hBsec, uint32_t otpWordIdx)
+{
+  if (OTP_Model_Lock(otpWordIdx, OTP_MODEL_PERM) != OTP_MODEL_OK)
+  {
+    hBsec->Error = BSEC_ERROR_INVALID_PARAMETER;
+    return HAL_ERROR;
+  }
+
+  return HAL_OK;
+}
+
+/**
+  * @brief Get the permanent programming lock of an otp word
+  * @param hBsec: pointer to the BSEC handle
+  * @param otpWordIdx: otp word number
+  * @param pLockStatus: pointer to BSEC_LOCKED or BSEC_NOTLOCKED
+  * @retval HAL status
+  */
+HAL_StatusTypeDef OTP_Emul_GetOtpPermanentProgLockStatus(BSEC_HandleTypeDef *hBsec, uint32_t otpWordIdx,
+                                                         uint32_t *pLockStatus)
+{
+  uint32_t lock;
+
+  if (OTP_Model_GetLock(otpWordIdx, &lock) != OTP_MODEL_OK)
+  {
+    hBsec->Error = BSEC_ERROR_INVALID_PARAMETER;
+    return HAL_ERROR;
+  }
+
+  *pLockStatus = ((lock & OTP_MODEL_PERM) != 0U) ? BSEC_LOCKED : BSEC_NOTLOCKED;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief Get the device security state
+  * @param hBsec: pointer to the BSEC handle
+  * @param pSecStatus: pointer to the security state
+  * @retval HAL status
+  */
+HAL_StatusTypeDef OTP_Emul_GetSecurityStatus(BSEC_HandleTypeDef *hBsec, BSEC_ChipSecurityTypeDef *pSecStatus)
+{
+  UNUSED(hBsec);
+
+  *pSecStatus = (OTP_Model_IsClosed() != 0U) ? BSEC_SECURED_CLOSE_STATE : BSEC_SECURED_OPEN_STATE;
+
+  return HAL_OK;
+}
+#endif /* BSEC_API_CHANGE */
+#endif /* USE_OTP_EMULATION */
@@ -0,0 +1,257 @@
+/**
+  ******************************************************************************
+  * @file    otp_model.c
+  * @author  MCD Application Team
+  * @brief   Model of the OTP fuses behind the BSEC emulation, without HAL
+  *          dependency so that it also runs on the host. Bits are only
+  *          programmed to 1, sticky locks last until reset, permanent locks
+  *          forever, shadow registers are updated on reload. Durations are
+  *          waited through the configured delay callback.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#if defined(USE_OTP_EMULATION)
+#include <stddef.h>
+#include <string.h>
+#include "otp_model.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static uint32_t model_fuse[OTP_MODEL_WORD_NUMBER];
+static uint32_t model_shadow[OTP_MODEL_WORD_NUMBER];
+static uint8_t model_lock[OTP_MODEL_WORD_NUMBER];
+static OTP_Model_ConfigTypeDef model_config = { 0U, 0U, 0U, OTP_MODEL_NO_ERROR_WORD, NULL };
+
+/* Private function prototypes -----------------------------------------------*/
+static void OTP_Model_Wait(uint32_t Delay);
+static int OTP_Model_Reload(uint32_t Word);
+
+/* Functions Definition ------------------------------------------------------*/
+/**
+  * @brief Configure the fuses model
+  * @param pConfig: pointer to the model configuration
+  * @retval None
+  */
+void OTP_Model_Config(const OTP_Model_ConfigTypeDef *pConfig)
+{
+  model_config = *pConfig;
+}
+
+/**
+  * @brief Blank all the fuses and their locks
+  * @param None
+  * @retval None
+  */
+void OTP_Model_Erase(void)
+{
+  memset(model_fuse, 0, sizeof(model_fuse));
+  memset(model_shadow, 0, sizeof(model_shadow));
+  memset(model_lock, 0, sizeof(model_lock));
+}
+
+/**
+  * @brief Emulate a reset: sticky locks are released and all the fuses reloaded
+  * @param None
+  * @retval None
+  */
+void OTP_Model_Reset(void)
+{
+  uint32_t word;
+
+  for (word = 0U; word < OTP_MODEL_WORD_NUMBER; word++)
+  {
+    model_lock[word] &= (uint8_t)~OTP_MODEL_STICKY_MASK;
+    (void)OTP_Model_Reload(word);
+  }
+}
+
+/**
+  * @brief Reload a fuse in its shadow register and read it
+  * @param Word: fuse number
+  * @param pValue: pointer to the shadow value
+  * @retval OTP_MODEL_OK: if no error
+  *         OTP_MODEL_STICKY_LOCKED: if the reload is locked, the shadow keeps its value
+  *         other: if error
+  */
+int OTP_Model_Read(uint32_t Word, uint32_t *pValue)
+{
+  int ret;
+
+  if (Word >= OTP_MODEL_WORD_NUMBER)
+  {
+    return OTP_MODEL_PARAM_ERROR;
+  }
+
+  if ((model_lock[Word] & OTP_MODEL_STICKY_RELOAD) != 0U)
+  {
+    ret = OTP_MODEL_STICKY_LOCKED;
+  }
+  else
+  {
+    ret = OTP_Model_Reload(Word);
+  }
+
+  *pValue = model_shadow[Word];
+
+  return ret;
+}
+
+/**
+  * @brief Read the shadow register of a fuse, without reload
+  * @param Word: fuse number
+  * @param pValue: pointer to the shadow value
+  * @retval OTP_MODEL_OK: if no error
+  *         other: if error
+  */
+int OTP_Model_ReadShadow(uint32_t Word, uint32_t *pValue)
+{
+  if (Word >= OTP_MODEL_WORD_NUMBER)
+  {
+    return OTP_MODEL_PARAM_ERROR;
+  }
+
+  *pValue = model_shadow[Word];
+
+  return OTP_MODEL_OK;
+}
+
+/**
+  * @brief Program the bits of a fuse, the shadow is not reloaded
+  * @param Word: fuse number
+  * @param Value: requested fuse value
+  * @retval OTP_MODEL_OK: if no error
+  *         other: if the fuse is locked or a bit should go from 1 to 0
+  */
+int OTP_Model_Program(uint32_t Word, uint32_t Value)
+{
+  if (Word >= OTP_MODEL_WORD_NUMBER)
+  {
+    return OTP_MODEL_PARAM_ERROR;
+  }
+
+  if ((model_lock[Word] & OTP_MODEL_PERM) != 0U)
+  {
+    return OTP_MODEL_PERM_LOCKED;
+  }
+
+  if ((model_lock[Word] & OTP_MODEL_STICKY_PROG) != 0U)
+  {
+    return OTP_MODEL_STICKY_LOCKED;
+  }
+
+  OTP_Model_Wait(model_config.ProgramDelay);
+
+  /* A blown bit cannot be cleared */
+  if ((model_fuse[Word] & ~Value) != 0U)
+  {
+    return OTP_MODEL_PROG_ERROR;
+  }
+
+  model_fuse[Word] |= Value;
+
+  return OTP_MODEL_OK;
+}
+
+/**
+  * @brief Lock a fuse
+  * @param Word: fuse number
+  * @param Lock: OTP_MODEL_STICKY_xxx and/or OTP_MODEL_PERM
+  * @retval OTP_MODEL_OK: if no error
+  *         other: if error
+  */
+int OTP_Model_Lock(uint32_t Word, uint32_t Lock)
+{
+  if (Word >= OTP_MODEL_WORD_NUMBER)
+  {
+    return OTP_MODEL_PARAM_ERROR;
+  }
+
+  /* The permanent lock is a fuse programming, the sticky ones a register write */
+  if ((Lock & OTP_MODEL_PERM) != 0U)
+  {
+    OTP_Model_Wait(model_config.ProgramDelay);
+  }
+
+  model_lock[Word] |= (uint8_t)(Lock & (OTP_MODEL_STICKY_MASK | OTP_MODEL_PERM));
+
+  return OTP_MODEL_OK;
+}
+
+/**
+  * @brief Get the locks of a fuse
+  * @param Word: fuse number
+  * @param pLock: pointer to the OTP_MODEL_STICKY_xxx, OTP_MODEL_PERM and
+  *        OTP_MODEL_SHADOW_ERROR flags
+  * @retval OTP_MODEL_OK: if no error
+  *         other: if error
+  */
+int OTP_Model_GetLock(uint32_t Word, uint32_t *pLock)
+{
+  if (Word >= OTP_MODEL_WORD_NUMBER)
+  {
+    return OTP_MODEL_PARAM_ERROR;
+  }
+
+  *pLock = model_lock[Word];
+
+  return OTP_MODEL_OK;
+}
+
+/**
+  * @brief Get the device life cycle
+  * @param None
+  * @retval 1 for a closed device, 0 for an open one
+  */
+uint32_t OTP_Model_IsClosed(void)
+{
+  return (model_config.Closed != 0U) ? 1U : 0U;
+}
+
+/**
+  * @brief Wait through the configured delay callback
+  * @param Delay: duration in ms
+  * @retval None
+  */
+static void OTP_Model_Wait(uint32_t Delay)
+{
+  if ((Delay != 0U) && (model_config.Delay != NULL))
+  {
+    model_config.Delay(Delay);
+  }
+}
+
+/**
+  * @brief Reload a fuse in its shadow register
+  * @param Word: fuse number
+  * @retval OTP_MODEL_OK: if no error
+  *         OTP_MODEL_READ_ERROR: if the fuse is the configured failing one
+  */
+static int OTP_Model_Reload(uint32_t Word)
+{
+  OTP_Model_Wait(model_config.ReadDelay);
+
+  if (Word == model_config.ErrorWord)
+  {
+    model_lock[Word] |= OTP_MODEL_SHADOW_ERROR;
+    return OTP_MODEL_READ_ERROR;
+  }
+
+  model_shadow[Word] = model_fuse[Word];
+  model_lock[Word] &= (uint8_t)~OTP_MODEL_SHADOW_ERROR;
+
+  return OTP_MODEL_OK;
+}
+#endif /* USE_OTP_EMULATION */
@@ -18,10 +18,30 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "otp_util.h"
+#include "otp_emul.h"
+#include <string.h>
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+#define OTP_CACHE_LOCK_MASK             (OTP_STICKY_LOCK_MASK | OTP_PERM_LOCK_MASK)
+#define OTP_CACHE_PROGRAM               (1U << 7)    /* Cached word has bits to be blown */
 /* Private macro -------------------------------------------------------------*/
+#if defined(CORE_CA7)
+/* Generic timer, counting at HSI frequency as the HAL time base */
+#define OTP_UTIL_TIME_US()              ((uint32_t)(PL1_GetCurrentPhysicalValue() / (HSI_VALUE / 1000000UL)))
+#elif defined(CORE_CA35)
+/* Generic timer, counting at the STGEN frequency set in CNTFRQ by SystemInit */
+#define OTP_UTIL_TIME_US()              ((uint32_t)(PL1_GetCurrentPhysicalValue() / (__get_CNTFRQ() / 1000000UL)))
+#else
+#define OTP_UTIL_TIME_US()              (HAL_GetTick() * 1000UL)
+#endif /* CORE_CA7 */
+
+#if defined(BSEC_API_CHANGE)
+#define OTP_UTIL_BSEC_TIMEOUT()         ((hbsec->ErrorCode & HAL_BSEC_TIMEOUT_ERROR) != 0U)
+#else
+#define OTP_UTIL_BSEC_TIMEOUT()         ((hbsec->Error & BSEC_ERROR_TIMEOUT) != 0U)
+#endif /* BSEC_API_CHANGE */
+
 /* Private variables ---------------------------------------------------------*/
 BSEC_HandleTypeDef handleBsec;
 BSEC_HandleTypeDef * hbsec = &handleBsec;
@@ -29,9 +49,20 @@ static uint32_t otp_val_idx;
 static uint32_t otp_stat_idx;
 static uint32_t otp_idx;
 static HAL_StatusTypeDef status;
+static uint32_t otp_read_mode = OTP_READ_RELOAD;
+static Otp_ReadStatsTypeDef otp_read_stats;
+static uint32_t otp_generation = 0U;
+static Otp_ProgStatsTypeDef otp_prog_stats;
+
+/* Session otp cache: target value, requested lock bits and dirty flag of each word */
+static uint32_t otp_cache_value[OTP_VALUE_SIZE];
+static uint8_t otp_cache_lock[OTP_VALUE_SIZE];
+static uint32_t otp_cache_dirty[(OTP_VALUE_SIZE + 31U) / 32U];
 
 /* Exported variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
+static void OTP_Util_ReadWord(uint32_t word, uint32_t *pValue, uint32_t *pStat);
+static void OTP_Util_RecordOp(uint32_t op, uint32_t word, uint32_t start, HAL_StatusTypeDef opStatus);
 /**
   * @brief Init the otp
   * @param None
@@ -74,16 +105,120 @@ void OTP_Util_DeInit(void)
 }
 
 /**
-  * @brief Write the otp
-  * @param Otp: the otp structure
+  * @brief Write a single otp word
+  * @param word: otp word number
+  * @param value: value to be programmed
+  * @param stat: requested lock bits, same layout as the otp status word
   * @retval OTP_OK: if no error
   *         other: if error
   */
-int OTP_Util_Write(Otp_TypeDef Otp)
+int OTP_Util_WriteWord(uint32_t word, uint32_t value, uint32_t stat)
 {
-  uint32_t valueW;
-  uint32_t otpPermWLockValue = 0;
+  HAL_StatusTypeDef wstatus = HAL_OK;
+  uint32_t otpPermWLockValue;
   uint32_t stickyLockValue;
+  uint32_t start;
+  int ret = OTP_OK;
+
+  /* Check the otp word range */
+  if (word >= OTP_VALUE_SIZE)
+  {
+    return OTP_ERROR;
+  }
+
+  /* Fuses may change, even if programming fails */
+  otp_generation++;
+
+  /*### Program the otp value ###*/
+  /* Get the permanent lock value */
+  otpPermWLockValue = (uint8_t)((stat & OTP_PERM_LOCK_MASK) >> OTP_PERM_LOCK_POS);
+
+#if defined(BSEC_API_CHANGE)
+  /* Check if there is a permanent lock */
+  if (otpPermWLockValue == OTP_PERM_LOCK)
+  {
+    /* Program the permanent lock */
+    otpPermWLockValue = HAL_BSEC_LOCK_PROG;
+  }
+
+  /* Skip write value if value = 0 and Permanent Programming lock is not requested */
+  if ((value != 0) || (otpPermWLockValue == HAL_BSEC_LOCK_PROG))
+  {
+    start = OTP_UTIL_TIME_US();
+    wstatus = HAL_BSEC_OTP_Program(hbsec, word, value, otpPermWLockValue);
+    OTP_Util_RecordOp(OTP_OP_PROGRAM, word, start, wstatus);
+    if (wstatus != HAL_OK)
+    {
+      ret = OTP_ERROR;
+    }
+  }
+#else
+  /* Skip write value if value = 0 */
+  if (value != 0)
+  {
+    start = OTP_UTIL_TIME_US();
+    wstatus = HAL_BSEC_OtpProgram(hbsec, word, value);
+    OTP_Util_RecordOp(OTP_OP_PROGRAM, word, start, wstatus);
+    /* Check the status */
+    if (wstatus != HAL_OK) return OTP_ERROR;
+  }
+#endif
+
+  /*### Program the otp status ###*/
+  /* Status frame usefull values */
+  /* bit0 = read error detected, 1 => invalid value */
+  /* bit26 = lock error */
+  /* bit27 = sticky programming lock */
+  /* bit28 = shadow write sticky lock */
+  /* bit29 = shadow read sticky lock */
+  /* bit30 = permanent write lock */
+  /* bit31 = request update */
+  /*###########################*/
+
+  /* Get the sticky lock value (1 = bit27, 2 = bit28 ,4 = bit29 */
+  stickyLockValue = (uint8_t)((stat & OTP_STICKY_LOCK_MASK) >> OTP_STICKY_LOCK_POS);
+
+  /* Check if there is a sticky lock */
+  if ((stickyLockValue & OTP_STICKY_LOCK_ALL) != 0)
+  {
+    /* Program the sticky lock */
+    start = OTP_UTIL_TIME_US();
+#if defined(BSEC_API_CHANGE)
+    wstatus = HAL_BSEC_OTP_Lock(hbsec, word, stickyLockValue);
+#else
+    wstatus = HAL_BSEC_SetOtpStickyLock(hbsec, word, stickyLockValue);
+#endif
+    OTP_Util_RecordOp(OTP_OP_STICKY_LOCK, word, start, wstatus);
+    /* Check the status */
+    if (wstatus != HAL_OK) return OTP_ERROR;
+  }
+
+  /* permanent lock set during HAL_BSEC_OTP_Program with new API */
+#if !defined(BSEC_API_CHANGE)
+  /* Check if there is a permanent lock */
+  if (otpPermWLockValue == OTP_PERM_LOCK)
+  {
+    /* Program the permanent lock */
+    start = OTP_UTIL_TIME_US();
+    wstatus = HAL_BSEC_SetOtpPermanentProgLock(hbsec, word);
+    OTP_Util_RecordOp(OTP_OP_PERM_LOCK, word, start, wstatus);
+
+    /* Check the status */
+    if (wstatus != HAL_OK) return OTP_ERROR;
+  }
+#endif
+
+  return ret;
+}
+
+/**
+  * @brief Write the otp
+  * @param pOtp: pointer to the otp structure to program
+  * @retval OTP_OK: if no error
+  *         other: if error
+  */
+int OTP_Util_Write(const Otp_TypeDef *pOtp)
+{
   uint32_t requestUpdateValue;
 #if defined (STM32MP257Cxx)
   /* This is for MP2 as during bulk update some OPT might throw an error because of access issue
@@ -94,7 +229,7 @@ int OTP_Util_Write(Otp_TypeDef Otp)
   for (otp_val_idx = 0, otp_stat_idx = otp_val_idx + 1, otp_idx = (otp_val_idx / 2); otp_val_idx < OTP_PART_SIZE; otp_val_idx += 2, otp_stat_idx = otp_val_idx + 1, otp_idx = (otp_val_idx / 2))
   {
     /* Get the request update bit */
-    requestUpdateValue = (uint8_t)((Otp.OtpPart[otp_stat_idx] & OTP_REQUEST_UPDATE_MASK) >> OTP_REQUEST_UPDATE_POS);
+    requestUpdateValue = (uint8_t)((pOtp->OtpPart[otp_stat_idx] & OTP_REQUEST_UPDATE_MASK) >> OTP_REQUEST_UPDATE_POS);
 
     /* Check if there is request update */
     if (requestUpdateValue != OTP_REQUEST_UPDATE)
@@ -103,80 +238,15 @@ int OTP_Util_Write(Otp_TypeDef Otp)
       continue;
     }
 
-    /*### Program the otp value ###*/
-    /* Get the otp value */
-    valueW = Otp.OtpPart[otp_val_idx];
-
-#if defined(BSEC_API_CHANGE)
-    /* Get the permanent lock value */
-    otpPermWLockValue = (uint8_t)((Otp.OtpPart[otp_stat_idx] & OTP_PERM_LOCK_MASK) >> OTP_PERM_LOCK_POS);
-
-    /* Check if there is a permanent lock */
-	  if (otpPermWLockValue == OTP_PERM_LOCK)
-	  {
-        /* Program the permanent lock */
-		otpPermWLockValue = HAL_BSEC_LOCK_PROG;
-	  }
-
-	  /* Skip write value if value = 0 and Permanent Programming lock is not requested */
-	if (valueW != 0 || (otpPermWLockValue == HAL_BSEC_LOCK_PROG))
-	{
-      status = HAL_BSEC_OTP_Program(hbsec, otp_idx, valueW, otpPermWLockValue);
-      if (status != HAL_OK)
-      {
-    	  ret = OTP_ERROR;
-      }
-#else
-      /* Skip write value if value = 0 */
-    if (valueW != 0)
-    {
-      status = HAL_BSEC_OtpProgram(hbsec, otp_idx, valueW);
-      /* Check the status */
-      if (status != HAL_OK) return OTP_ERROR;
-#endif
-
-    }
-
-    /*### Program the otp status ###*/
-    /* Status frame usefull values */
-    /* bit0 = read error detected, 1 => invalid value */
-    /* bit26 = lock error */
-    /* bit27 = sticky programming lock */
-    /* bit28 = shadow write sticky lock */
-    /* bit29 = shadow read sticky lock */
-    /* bit30 = permanent write lock */
-    /* bit31 = request update */
-    /*###########################*/
-
-    /* Get the sticky lock value (1 = bit27, 2 = bit28 ,4 = bit29 */
-    stickyLockValue = (uint8_t)((Otp.OtpPart[otp_stat_idx] & OTP_STICKY_LOCK_MASK) >> OTP_STICKY_LOCK_POS);
-
-    /* Check if there is a sticky lock */
-    if ((stickyLockValue & OTP_STICKY_LOCK_ALL) != 0)
+    /* Program the otp value and its locks */
+    if (OTP_Util_WriteWord(otp_idx, pOtp->OtpPart[otp_val_idx], pOtp->OtpPart[otp_stat_idx]) != OTP_OK)
     {
-      /* Program the sticky lock */
-#if defined(BSEC_API_CHANGE)
-	  status = HAL_BSEC_OTP_Lock(hbsec, otp_idx, stickyLockValue);
+#if defined (STM32MP257Cxx)
+      ret = OTP_ERROR;
 #else
-      status = HAL_BSEC_SetOtpStickyLock(hbsec, otp_idx, stickyLockValue);
+      return OTP_ERROR;
 #endif
-      /* Check the status */
-      if (status != HAL_OK) return OTP_ERROR;
-    }
-    /* permanent lock set during HAL_BSEC_OTP_Program with new API */
-#if !defined(BSEC_API_CHANGE)
-    /* Get the permanent lock value */
-    otpPermWLockValue = (uint8_t)((Otp.OtpPart[otp_stat_idx] & OTP_PERM_LOCK_MASK) >> OTP_PERM_LOCK_POS);
-
-    /* Check if there is a permanent lock */
-    if (otpPermWLockValue == OTP_PERM_LOCK)
-    {
-      /* Program the permanent lock */
-      status = HAL_BSEC_SetOtpPermanentProgLock(hbsec, otp_idx);
     }
-    /* Check the status */
-    if (status != HAL_OK) return OTP_ERROR;
-#endif
   }
 
 #if defined (STM32MP257Cxx)
@@ -189,30 +259,23 @@ int OTP_Util_Write(Otp_TypeDef Otp)
 }
 
 /**
-  * @brief Read the otp
-  * @param None
-  * @retval Otp: the otp structure
+  * @brief Read the otp version and global security state
+  * @param pOtp: pointer to the otp structure filled in place
+  * @retval None
   */
-Otp_TypeDef OTP_Util_Read(void)
+void OTP_Util_ReadState(Otp_TypeDef *pOtp)
 {
-  uint32_t valueR;
-  uint32_t stickyLockR;
-  uint32_t otpPermWLockR;
-  uint32_t statusR = 0;
 #if !defined(BSEC_API_CHANGE)
   BSEC_ChipSecurityTypeDef secR = 0;
 #else
   uint32_t secR = 0;
-  uint32_t lockStatus;
   uint32_t value = 0U;
   uint32_t SecMask = 0x00000001;
   uint32_t bootromcfg_9_OTP18 = 18U;
 #endif
 
-  Otp_TypeDef Otp = {0};
-
   /* Get the otp version */
-  Otp.Version = OPENBL_OTP_VERSION;
+  pOtp->Version = OPENBL_OTP_VERSION;
 
   /* Get security status */
 #if defined(BSEC_API_CHANGE)
@@ -235,7 +298,7 @@ Otp_TypeDef OTP_Util_Read(void)
 #if defined (STM32MP257Cxx)
   if (secR == HAL_BSEC_OPEN_STATE)
   {
-    Otp.GlobalState = BSEC_SEC_OTP_INVALID;
+    pOtp->GlobalState = BSEC_SEC_OTP_INVALID;
   }
   else if (secR == HAL_BSEC_CLOSED_STATE)
   {
@@ -243,110 +306,483 @@ Otp_TypeDef OTP_Util_Read(void)
 
 	if ((SecMask & value) == 0U)
 	{
-	  Otp.GlobalState = BSEC_SEC_OTP_OPEN;
+	  pOtp->GlobalState = BSEC_SEC_OTP_OPEN;
 	}
 	else
 	{
-      Otp.GlobalState = BSEC_SEC_OTP_CLOSED;
+      pOtp->GlobalState = BSEC_SEC_OTP_CLOSED;
 	}
   }
   else
   {
-    Otp.GlobalState = BSEC_SEC_OTP_INVALID;
+    pOtp->GlobalState = BSEC_SEC_OTP_INVALID;
   }
 #else
   if (secR == BSEC_SECURED_OPEN_STATE)
   {
-    Otp.GlobalState = BSEC_SEC_OTP_OPEN;
+    pOtp->GlobalState = BSEC_SEC_OTP_OPEN;
   }
   else if (secR == BSEC_SECURED_CLOSE_STATE)
   {
-    Otp.GlobalState = BSEC_SEC_OTP_CLOSED;
+    pOtp->GlobalState = BSEC_SEC_OTP_CLOSED;
   }
   else
   {
-    Otp.GlobalState = BSEC_SEC_OTP_INVALID;
+    pOtp->GlobalState = BSEC_SEC_OTP_INVALID;
   }
 #endif /* STM32MP257Cxx */
+}
 
-  /* Get the otp values */
-  for (otp_val_idx = 0, otp_stat_idx = otp_val_idx + 1, otp_idx = (otp_val_idx / 2); otp_val_idx < OTP_PART_SIZE; otp_val_idx += 2, otp_stat_idx = otp_val_idx + 1, otp_idx = (otp_val_idx / 2))
+/**
+  * @brief Read one otp word and its lock status
+  * @param word: otp word number
+  * @param pValue: pointer to the otp value
+  * @param pStat: pointer to the otp status
+  * @retval None
+  */
+static void OTP_Util_ReadWord(uint32_t word, uint32_t *pValue, uint32_t *pStat)
+{
+  uint32_t valueR = 0U;
+  uint32_t stickyLockR;
+  uint32_t otpPermWLockR;
+  uint32_t statusR = 0;
+  uint32_t start;
+#if defined(BSEC_API_CHANGE)
+  uint32_t lockStatus;
+  uint32_t validity;
+#endif
+
+  start = OTP_UTIL_TIME_US();
+
+#if defined(BSEC_API_CHANGE)
+  status = HAL_ERROR;
+
+  /* In fast mode, use the shadow register if its last reload was done without error */
+  if (otp_read_mode == OTP_READ_SHADOW)
+  {
+    if ((HAL_BSEC_OTP_GetShadowState(hbsec, word, &validity) == HAL_OK)
+        && (validity == HAL_BSEC_RELOAD_WITHOUT_ERROR))
+    {
+      status = HAL_BSEC_OTP_ReadShadow(hbsec, word, &valueR);
+    }
+  }
+
+  if (status == HAL_OK)
+  {
+    otp_read_stats.ShadowCount++;
+  }
+  else
   {
-    /* Reset the read status variable */
-    statusR = 0;
+    /* Reload and read the OTP word */
+    status = HAL_BSEC_OTP_Read(hbsec, word, &valueR);
+    otp_read_stats.ReloadCount++;
+  }
+#else
+  /* Read the otp word */
+  status = HAL_BSEC_OtpRead(hbsec, word, &valueR);
+  otp_read_stats.ReloadCount++;
+#endif
 
+  /* The sticky read lock is not a fuse failure */
 #if defined(BSEC_API_CHANGE)
-    /* Read the OTP word */
-    status = HAL_BSEC_OTP_Read(hbsec, otp_idx, &valueR);
+  OTP_Util_RecordOp(OTP_OP_READ, word, start, (hbsec->ErrorCode != HAL_BSEC_LOCK_ERROR) ? status : HAL_OK);
 #else
-    /* Read the otp word */
-    status = HAL_BSEC_OtpRead(hbsec, otp_idx, &valueR);
+  OTP_Util_RecordOp(OTP_OP_READ, word, start, status);
 #endif
-    /* Save the otp value */
-    Otp.OtpPart[otp_val_idx] = valueR;
+  /* Save the otp value */
+  *pValue = valueR;
 
 #if defined(BSEC_API_CHANGE)
-    /* Check the status. Skip the sticky read lock error */
-    if((status != HAL_OK) && (hbsec->ErrorCode != HAL_BSEC_LOCK_ERROR))
+  /* Check the status. Skip the sticky read lock error */
+  if((status != HAL_OK) && (hbsec->ErrorCode != HAL_BSEC_LOCK_ERROR))
 #else
-    if(status != HAL_OK)
+  if(status != HAL_OK)
 #endif
-    {
-      /* Save status as read error */
-      statusR += OTP_READ_ERROR;
+  {
+    /* Save status as read error */
+    statusR += OTP_READ_ERROR;
 
-      /* Save the otp value */
-      Otp.OtpPart[otp_stat_idx] = statusR;
+    /* Save the otp value */
+    *pStat = statusR;
 
-      /* Update the otp value to 0 as read error */
-      Otp.OtpPart[otp_val_idx] = 0;
+    /* Update the otp value to 0 as read error */
+    *pValue = 0;
 
-      /* Continue to the next otp */
-      continue;
-    }
+    return;
+  }
 
 #if defined(BSEC_API_CHANGE)
-    /* Get the lock status */
-    status = HAL_BSEC_OTP_GetState(hbsec, otp_idx, &lockStatus);
-    stickyLockR = (lockStatus & HAL_BSEC_FUSE_RELOAD_LOCKED) ? (1 << 2):0UL;
-    otpPermWLockR = (lockStatus & HAL_BSEC_FUSE_LOCKED) ? OTP_PERM_LOCK:0UL;
+  /* Get the lock status */
+  status = HAL_BSEC_OTP_GetState(hbsec, word, &lockStatus);
+  stickyLockR = (lockStatus & HAL_BSEC_FUSE_RELOAD_LOCKED) ? (1 << 2):0UL;
+  otpPermWLockR = (lockStatus & HAL_BSEC_FUSE_LOCKED) ? OTP_PERM_LOCK:0UL;
 #else
-    /* Get the sticky lock status */
-    status = HAL_BSEC_GetOtpStickyLockStatus(hbsec, otp_idx, &stickyLockR);
+  /* Get the sticky lock status */
+  status = HAL_BSEC_GetOtpStickyLockStatus(hbsec, word, &stickyLockR);
 #endif
 
-    /* Check the status */
-    if (status != HAL_OK)
+  /* Check the status */
+  if (status != HAL_OK)
+  {
+    /* Save status as lock error */
+    statusR += OTP_LOCK_ERROR;
+
+    /* Save the otp value */
+    *pStat = statusR;
+
+    return;
+  }
+#if !defined(BSEC_API_CHANGE)
+  /* Get the permanent lock status */
+  status = HAL_BSEC_GetOtpPermanentProgLockStatus(hbsec, word, &otpPermWLockR);
+
+  /* Check the status */
+  if (status != HAL_OK)
+  {
+    /* Save status as lock error */
+    statusR += OTP_LOCK_ERROR;
+
+    /* Save the otp value */
+    *pStat = statusR;
+
+    return;
+  }
+#endif
+  /* Set the otp status */
+  *pStat = (stickyLockR << OTP_STICKY_LOCK_POS) + (otpPermWLockR << OTP_PERM_LOCK_POS);
+}
+
+/**
+  * @brief Read a range of otp words
+  * @param first: first otp word number
+  * @param count: number of otp words to read
+  * @param pOtp: pointer to the otp structure, only the requested words
+  *        value/status pairs are updated
+  * @retval OTP_OK: if no error
+  *         other: if the range is out of the otp area
+  */
+int OTP_Util_ReadRange(uint32_t first, uint32_t count, Otp_TypeDef *pOtp)
+{
+  uint32_t tickstart;
+
+  /* Check the otp word range */
+  if ((first >= OTP_VALUE_SIZE) || (count > (OTP_VALUE_SIZE - first)))
+  {
+    return OTP_ERROR;
+  }
+
+  /* Reset the read counters */
+  otp_read_stats.ShadowCount = 0U;
+  otp_read_stats.ReloadCount = 0U;
+  tickstart = HAL_GetTick();
+
+  /* Get the otp values */
+  for (otp_val_idx = first * 2, otp_stat_idx = otp_val_idx + 1, otp_idx = (otp_val_idx / 2); otp_val_idx < ((first + count) * 2); otp_val_idx += 2, otp_stat_idx = otp_val_idx + 1, otp_idx = (otp_val_idx / 2))
+  {
+    OTP_Util_ReadWord(otp_idx, &pOtp->OtpPart[otp_val_idx], &pOtp->OtpPart[otp_stat_idx]);
+  }
+
+  otp_read_stats.Ticks = HAL_GetTick() - tickstart;
+
+  return OTP_OK;
+}
+
+/**
+  * @brief Read the otp
+  * @param pOtp: pointer to the otp structure filled in place
+  * @retval None
+  */
+void OTP_Util_Read(Otp_TypeDef *pOtp)
+{
+  /* Words not read on error are returned as 0 */
+  memset(pOtp, 0, sizeof(Otp_TypeDef));
+
+  /* Get the otp version and security state */
+  OTP_Util_ReadState(pOtp);
+
+  /* Get all the otp values */
+  (void)OTP_Util_ReadRange(0U, OTP_VALUE_SIZE, pOtp);
+}
+
+/**
+  * @brief Select the otp read mode
+  * @param mode: OTP_READ_RELOAD to reload every fuse before reading it, or
+  *        OTP_READ_SHADOW to read the valid shadow registers and reload only
+  *        the fuses which are not shadowed. Shadow reads are only supported
+  *        with the new BSEC API, other devices always reload.
+  * @retval None
+  */
+void OTP_Util_SetReadMode(uint32_t mode)
+{
+  otp_read_mode = (mode == OTP_READ_SHADOW) ? OTP_READ_SHADOW : OTP_READ_RELOAD;
+}
+
+/**
+  * @brief Get the otp read mode
+  * @param None
+  * @retval OTP_READ_RELOAD or OTP_READ_SHADOW
+  */
+uint32_t OTP_Util_GetReadMode(void)
+{
+  return otp_read_mode;
+}
+
+/**
+  * @brief Get the counters of the last otp read
+  * @param pStats: pointer to the counters structure filled in place
+  * @retval None
+  */
+void OTP_Util_GetReadStats(Otp_ReadStatsTypeDef *pStats)
+{
+  *pStats = otp_read_stats;
+}
+
+/**
+  * @brief Clear the otp cache, no word is pending
+  * @param None
+  * @retval None
+  */
+void OTP_Util_CacheReset(void)
+{
+  memset(otp_cache_dirty, 0, sizeof(otp_cache_dirty));
+}
+
+/**
+  * @brief Set the target of an otp word in the cache
+  * @param word: otp word number
+  * @param value: target value of the otp word
+  * @param stat: requested lock bits, same layout as the otp status word
+  * @retval OTP_OK: if no error
+  *         other: if the word is out of range
+  */
+int OTP_Util_CacheSet(uint32_t word, uint32_t value, uint32_t stat)
+{
+  if (word >= OTP_VALUE_SIZE)
+  {
+    return OTP_ERROR;
+  }
+
+  otp_cache_value[word] = value;
+  otp_cache_lock[word]  = (uint8_t)((stat & OTP_CACHE_LOCK_MASK) >> OTP_STICKY_LOCK_POS);
+  otp_cache_dirty[word / 32U] |= (1UL << (word % 32U));
+
+  return OTP_OK;
+}
+
+/**
+  * @brief Compute the programming plan of the cached words
+  * @param pPlan: pointer to the plan summary
+  * @retval OTP_OK: if all the cached words can reach their target
+  *         other: if a bit must be cleared, a locked word must be programmed
+  *                or a word cannot be read
+  *
+  * Each dirty word is compared to the fuses: bits already blown and locks
+  * already set are dropped, words left with nothing to do are no longer dirty.
+  */
+int OTP_Util_CacheDiff(Otp_PlanTypeDef *pPlan)
+{
+  uint32_t word;
+  uint32_t current;
+  uint32_t currentStat;
+  uint32_t blow;
+  uint8_t lock;
+
+  memset(pPlan, 0, sizeof(Otp_PlanTypeDef));
+
+  for (word = 0U; word < OTP_VALUE_SIZE; word++)
+  {
+    /* Skip whole clean groups of words */
+    if (otp_cache_dirty[word / 32U] == 0U)
     {
-      /* Save status as lock error */
-      statusR += OTP_LOCK_ERROR;
+      word |= 31U;
+      continue;
+    }
 
-      /* Save the otp value */
-      Otp.OtpPart[otp_stat_idx] = statusR;
+    if ((otp_cache_dirty[word / 32U] & (1UL << (word % 32U))) == 0U)
+    {
+      continue;
+    }
+
+    OTP_Util_ReadWord(word, &current, &currentStat);
+
+    /* Bits to be blown and locks not yet set */
+    blow = otp_cache_value[word] & ~current;
+    lock = (uint8_t)(otp_cache_lock[word] & ~((currentStat & OTP_CACHE_LOCK_MASK) >> OTP_STICKY_LOCK_POS)
+                     & (OTP_CACHE_LOCK_MASK >> OTP_STICKY_LOCK_POS));
+
+    if (((currentStat & (OTP_READ_ERROR | OTP_LOCK_ERROR)) != 0U)
+        || ((current & ~otp_cache_value[word]) != 0U)
+        || ((blow != 0U) && ((currentStat & (OTP_PERM_LOCK_MASK | OTP_STICKY_PROG_LOCK_MASK)) != 0U)))
+    {
+      /* Unreadable word, 1 to 0 transition or programming of a locked word */
+      if (pPlan->ErrorCount == 0U)
+      {
+        pPlan->FirstError = word;
+      }
+      pPlan->ErrorCount++;
+      continue;
+    }
 
-      /* Continue to the next otp */
+    if ((blow == 0U) && (lock == 0U))
+    {
+      /* Already in the requested state */
+      otp_cache_dirty[word / 32U] &= ~(1UL << (word % 32U));
+      pPlan->SkipCount++;
       continue;
     }
-#if !defined(BSEC_API_CHANGE)
-    /* Get the permanent lock status */
-    status = HAL_BSEC_GetOtpPermanentProgLockStatus(hbsec, otp_idx, &otpPermWLockR);
 
-    /* Check the status */
-    if (status != HAL_OK)
+    if (blow != 0U)
+    {
+      lock |= OTP_CACHE_PROGRAM;
+      pPlan->ProgramCount++;
+    }
+
+    if ((lock & ~OTP_CACHE_PROGRAM) != 0U)
     {
-      /* Save status as lock error */
-      statusR += OTP_LOCK_ERROR;
+      pPlan->LockCount++;
+    }
 
-      /* Save the otp value */
-      Otp.OtpPart[otp_stat_idx] = statusR;
+    otp_cache_lock[word] = lock;
+  }
+
+  return (pPlan->ErrorCount == 0U) ? OTP_OK : OTP_ERROR;
+}
 
-      /* Continue to the next otp */
+/**
+  * @brief Program the cached words
+  * @param pPlan: pointer to the plan summary
+  * @retval OTP_OK: if no error
+  *         other: if the plan is not possible, nothing is programmed, or
+  *                if a word programming failed
+  */
+int OTP_Util_CacheApply(Otp_PlanTypeDef *pPlan)
+{
+  uint32_t word;
+  uint32_t value;
+  uint32_t stat;
+  int ret = OTP_OK;
+
+  /* Reject the whole plan before any fuse is blown */
+  if (OTP_Util_CacheDiff(pPlan) != OTP_OK)
+  {
+    OTP_Util_CacheReset();
+    return OTP_ERROR;
+  }
+
+  for (word = 0U; word < OTP_VALUE_SIZE; word++)
+  {
+    if ((otp_cache_dirty[word / 32U] & (1UL << (word % 32U))) == 0U)
+    {
       continue;
     }
+
+    stat = ((uint32_t)(otp_cache_lock[word] & ~OTP_CACHE_PROGRAM) << OTP_STICKY_LOCK_POS);
+
+    /* The full target is programmed, the permanent lock needs it on new BSEC API */
+    value = (((otp_cache_lock[word] & OTP_CACHE_PROGRAM) != 0U) || ((stat & OTP_PERM_LOCK_MASK) != 0U))
+            ? otp_cache_value[word] : 0U;
+
+    if (OTP_Util_WriteWord(word, value, stat) != OTP_OK)
+    {
+      if (ret == OTP_OK)
+      {
+        pPlan->FirstError = word;
+      }
+      pPlan->ErrorCount++;
+      ret = OTP_ERROR;
+#if !defined (STM32MP257Cxx)
+      break;
 #endif
-    /* Set the otp status */
-    Otp.OtpPart[otp_stat_idx] = (stickyLockR << OTP_STICKY_LOCK_POS) + (otpPermWLockR << OTP_PERM_LOCK_POS);
+    }
+  }
+
+  OTP_Util_CacheReset();
+
+  return ret;
+}
+
+/**
+  * @brief Get the otp generation counter
+  * @param None
+  * @retval Counter incremented each time an otp word is programmed
+  */
+uint32_t OTP_Util_GetGeneration(void)
+{
+  return otp_generation;
+}
+
+/**
+  * @brief Get the otp programming statistics
+  * @param pStats: pointer to the statistics filled in place
+  * @retval None
+  */
+void OTP_Util_GetProgStats(Otp_ProgStatsTypeDef *pStats)
+{
+  *pStats = otp_prog_stats;
+}
+
+/**
+  * @brief Reset the otp programming statistics
+  * @param None
+  * @retval None
+  */
+void OTP_Util_ResetProgStats(void)
+{
+  memset(&otp_prog_stats, 0, sizeof(otp_prog_stats));
+}
+
+/**
+  * @brief Account one BSEC operation in the programming statistics
+  * @param op: operation type, OTP_OP_xxx
+  * @param word: otp word number
+  * @param start: time of the operation start, in us
+  * @param opStatus: status returned by the operation
+  * @retval None
+  */
+static void OTP_Util_RecordOp(uint32_t op, uint32_t word, uint32_t start, HAL_StatusTypeDef opStatus)
+{
+  Otp_OpStatsTypeDef *pOp = &otp_prog_stats.Op[op];
+  uint32_t duration = OTP_UTIL_TIME_US() - start;
+  uint32_t idx;
+
+  if ((pOp->Count == 0U) || (duration < pOp->Min))
+  {
+    pOp->Min = duration;
+  }
+
+  if (duration > pOp->Max)
+  {
+    pOp->Max = duration;
+  }
+
+  pOp->Count++;
+  pOp->Total += duration;
+
+  if (opStatus == HAL_OK)
+  {
+    return;
+  }
+
+  pOp->Errors++;
+
+  if ((opStatus == HAL_TIMEOUT) || OTP_UTIL_BSEC_TIMEOUT())
+  {
+    pOp->Timeouts++;
+  }
+
+  /* Keep each failing fuse once */
+  for (idx = 0U; (idx < otp_prog_stats.FailCount) && (idx < OTP_PROG_FAIL_MAX); idx++)
+  {
+    if (otp_prog_stats.FailWord[idx] == word)
+    {
+      return;
+    }
+  }
+
+  if (otp_prog_stats.FailCount < OTP_PROG_FAIL_MAX)
+  {
+    otp_prog_stats.FailWord[otp_prog_stats.FailCount] = word;
   }
 
-  return Otp;
+  otp_prog_stats.FailCount++;
 }
@@ -0,0 +1,276 @@
+/**
+  ******************************************************************************
+  * @file    pmic_emul.c
+  * @author  GPM Application Team
+  * @brief   Emulated STPMIC, used instead of the I2C bus when
+  *          USE_PMIC_EMULATION is defined. The I2C HAL calls are forwarded
+  *          to the PMIC model, so that the PMIC flows of all the interfaces
+  *          can be checked and benchmarked on a board without PMIC. The
+  *          model time is a virtual bus clock: each transfer advances it by
+  *          its number of SCL periods, so the NVM programming ends after the
+  *          same status polls as on the I2C bus, also in interrupt context.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#if defined(USE_PMIC_EMULATION)
+#include "pmic_emul.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* SCL periods of the transfer phases, acknowledge included */
+#define PMIC_EMUL_BITS_CONDITION        1U     /* START, repeated START or STOP */
+#define PMIC_EMUL_BITS_BYTE             9U     /* Device address, register or data */
+
+#if (PMIC_MODEL_I2C_ADDRESS != PMIC_I2C_ADDRESS) || (PMIC_MODEL_PRODUCT_ID_ADDR != PMIC_PRODUCT_ID_SR_ADDR) || \
+    (PMIC_MODEL_NVM_BUSY_MSK != PMIC_NVM_BUSY_MSK)
+#error "PMIC model registers do not match the pmic utilities"
+#endif
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static uint32_t emul_scl_ns = 10000U;   /* SCL period of the I2C timing, 100 kHz until init */
+static uint32_t emul_time_us;           /* Virtual bus clock */
+static uint32_t emul_time_ns;           /* Virtual bus clock below 1 us */
+
+/* Private function prototypes -----------------------------------------------*/
+static void PMIC_Emul_Clock(uint32_t Bits);
+static HAL_StatusTypeDef PMIC_Emul_Status(I2C_HandleTypeDef *hi2c, int Status);
+
+/* Functions Definition ------------------------------------------------------*/
+/**
+  * @brief Configure the emulated PMIC, its registers are reset
+  * @param pConfig: pointer to the emulation configuration
+  * @retval None
+  */
+void PMIC_Emul_Config(const PMIC_Emul_ConfigTypeDef *pConfig)
+{
+  PMIC_Model_ConfigTypeDef config;
+
+  switch (pConfig->Type)
+  {
+    case PMIC_STPMIC25:
+      config.Type = PMIC_MODEL_STPMIC25;
+      break;
+    case PMIC_STPMIC1:
+      config.Type = PMIC_MODEL_STPMIC1;
+      break;
+    default:
+      config.Type = PMIC_MODEL_NONE;
+      break;
+  }
+
+  config.ProgramDelay = pConfig->ProgramDelay;
+  config.NackCount = pConfig->NackCount;
+  config.Time = PMIC_Emul_GetTime;
+
+  PMIC_Model_Config(&config);
+}
+
+/**
+  * @brief Blank the emulated NVM
+  * @param None
+  * @retval None
+  */
+void PMIC_Emul_Erase(void)
+{
+  PMIC_Model_Erase();
+}
+
+/**
+  * @brief Emulate a power cycle: the shadow registers are reloaded from NVM
+  * @param None
+  * @retval None
+  */
+void PMIC_Emul_Reset(void)
+{
+  PMIC_Model_Reset();
+}
+
+/**
+  * @brief Get the bus transfer counters
+  * @param pStats: pointer to the counters filled in place
+  * @retval None
+  */
+void PMIC_Emul_GetStats(PMIC_Emul_StatsTypeDef *pStats)
+{
+  PMIC_Model_GetStats(pStats);
+}
+
+/**
+  * @brief Clear the bus transfer counters
+  * @param None
+  * @retval None
+  */
+void PMIC_Emul_ResetStats(void)
+{
+  PMIC_Model_ResetStats();
+}
+
+/**
+  * @brief Get the virtual bus clock, also the time callback of the model
+  * @param None
+  * @retval Virtual bus clock, in us
+  */
+uint32_t PMIC_Emul_GetTime(void)
+{
+  return emul_time_us;
+}
+
+/**
+  * @brief Advance the virtual bus clock by a wait, the bus being idle
+  * @param Delay: duration of the wait, in us
+  * @retval None
+  */
+void PMIC_Emul_Delay(uint32_t Delay)
+{
+  emul_time_us += Delay;
+}
+
+/**
+  * @brief Advance the virtual bus clock by a transfer
+  * @param Bits: number of SCL periods of the transfer
+  * @retval None
+  */
+static void PMIC_Emul_Clock(uint32_t Bits)
+{
+  emul_time_ns += Bits * emul_scl_ns;
+  emul_time_us += emul_time_ns / 1000U;
+  emul_time_ns %= 1000U;
+}
+
+/**
+  * @brief Convert a model status into the I2C handle error
+  * @param hi2c: pointer to the I2C handle
+  * @param Status: model status of the transfer
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef PMIC_Emul_Status(I2C_HandleTypeDef *hi2c, int Status)
+{
+  if (Status == PMIC_MODEL_OK)
+  {
+    hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+    return HAL_OK;
+  }
+
+  if (Status == PMIC_MODEL_NACK)
+  {
+    /* The transfer stops after the device address */
+    PMIC_Emul_Clock(PMIC_EMUL_BITS_CONDITION + PMIC_EMUL_BITS_BYTE + PMIC_EMUL_BITS_CONDITION);
+    hi2c->ErrorCode = HAL_I2C_ERROR_AF;
+  }
+  else
+  {
+    hi2c->ErrorCode = HAL_I2C_ERROR_SIZE;
+  }
+
+  return HAL_ERROR;
+}
+
+/**
+  * @brief Initialize the emulated I2C instance
+  * @param hi2c: pointer to the I2C handle
+  * @retval HAL status
+  * @note  The SCL period is decoded from the timing register value and the
+  *        I2C kernel clock, so the virtual bus clock follows the bus speed.
+  *        Rise and fall times are not counted, the emulated bus is slightly
+  *        faster than the I2C bus.
+  */
+HAL_StatusTypeDef PMIC_Emul_I2C_Init(I2C_HandleTypeDef *hi2c)
+{
+  uint32_t clk_khz = HAL_RCCEx_GetPeriphCLKFreq(BUS_I2C_PERIPHCLK) / 1000U;
+  uint32_t timing = hi2c->Init.Timing;
+  uint32_t presc = ((timing & I2C_TIMINGR_PRESC) >> I2C_TIMINGR_PRESC_Pos) + 1U;
+  uint32_t scll = ((timing & I2C_TIMINGR_SCLL) >> I2C_TIMINGR_SCLL_Pos) + 1U;
+  uint32_t sclh = ((timing & I2C_TIMINGR_SCLH) >> I2C_TIMINGR_SCLH_Pos) + 1U;
+
+  if (clk_khz != 0U)
+  {
+    emul_scl_ns = (uint32_t)(((uint64_t)presc * (scll + sclh) * 1000000U) / clk_khz);
+  }
+
+  hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+  hi2c->State     = HAL_I2C_STATE_READY;
+  hi2c->Mode      = HAL_I2C_MODE_NONE;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief Read consecutive PMIC registers
+  * @param hi2c: pointer to the I2C handle
+  * @param DevAddress: target device address
+  * @param MemAddress: first register
+  * @param MemAddSize: size of the register address
+  * @param pData: pointer to the register values
+  * @param Size: number of registers
+  * @param Timeout: timeout duration
+  * @retval HAL status
+  */
+HAL_StatusTypeDef PMIC_Emul_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                         uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+  int status;
+
+  UNUSED(MemAddSize);
+  UNUSED(Timeout);
+
+  status = PMIC_Model_Read(DevAddress, MemAddress, pData, Size);
+  if (status == PMIC_MODEL_OK)
+  {
+    /* START, address, register, repeated START, address, data, STOP */
+    PMIC_Emul_Clock((3U * PMIC_EMUL_BITS_CONDITION) + (3U * PMIC_EMUL_BITS_BYTE) + (Size * PMIC_EMUL_BITS_BYTE));
+  }
+
+  return PMIC_Emul_Status(hi2c, status);
+}
+
+/**
+  * @brief Write consecutive PMIC registers
+  * @param hi2c: pointer to the I2C handle
+  * @param DevAddress: target device address
+  * @param MemAddress: first register
+  * @param MemAddSize: size of the register address
+  * @param pData: pointer to the register values
+  * @param Size: number of registers
+  * @param Timeout: timeout duration
+  * @retval HAL status
+  */
+HAL_StatusTypeDef PMIC_Emul_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+                                          uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+  int status;
+
+  UNUSED(MemAddSize);
+  UNUSED(Timeout);
+
+  status = PMIC_Model_Write(DevAddress, MemAddress, pData, Size);
+  if (status == PMIC_MODEL_OK)
+  {
+    /* START, address, register, data, STOP */
+    PMIC_Emul_Clock((2U * PMIC_EMUL_BITS_CONDITION) + (2U * PMIC_EMUL_BITS_BYTE) + (Size * PMIC_EMUL_BITS_BYTE));
+  }
+
+  return PMIC_Emul_Status(hi2c, status);
+}
+
+/**
+  * @brief Return the error code of the last transfer
+  * @param hi2c: pointer to the I2C handle
+  * @retval I2C error code
+  */
+uint32_t PMIC_Emul_I2C_GetError(I2C_HandleTypeDef *hi2c)
+{
+  return hi2c->ErrorCode;
+}
+#endif /* USE_PMIC_EMULATION */
@@ -0,0 +1,277 @@
+/**
+  ******************************************************************************
+  * @file    pmic_model.c
+  * @author  GPM Application Team
+  * @brief   Model of the STPMIC register map behind the PMIC emulation,
+  *          without HAL dependency so that it also runs on the host. The
+  *          map holds the product ID, the NVM shadow registers with
+  *          auto-increment access, the NVM control register starting a
+  *          programming or a reload and the NVM status register busy for
+  *          the configured programming duration. The duration is measured
+  *          with the configured time callback. Transfers are counted.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#if defined(USE_PMIC_EMULATION)
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "pmic_model.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Register map of a modeled PMIC, from its datasheet */
+typedef struct
+{
+  uint8_t    ProductId;         /* Product ID register value */
+  uint8_t    NVMStartAddress;   /* First NVM shadow register */
+  uint8_t    NVMSize;           /* Number of NVM shadow registers */
+  uint8_t    NVMSRRegisterAddr; /* NVM status register */
+  uint8_t    NVMCRRegisterAddr; /* NVM control register */
+} PMIC_Model_MapTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define PMIC_MODEL_NVM_SIZE_MAX         40U
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static const PMIC_Model_MapTypeDef model_map[PMIC_MODEL_NONE] =
+{
+  {0x21U, 0x90U, 40U, 0x8EU, 0x8FU}, /* PMIC_MODEL_STPMIC25 */
+  {0x01U, 0xF8U,  8U, 0xB8U, 0xB9U}, /* PMIC_MODEL_STPMIC1 */
+};
+
+static uint8_t model_reg[PMIC_MODEL_REG_NUMBER];
+static uint8_t model_nvm[PMIC_MODEL_NVM_SIZE_MAX];
+static uint32_t model_busy_start;
+static bool model_busy = false;
+static PMIC_Model_ConfigTypeDef model_config = { PMIC_MODEL_STPMIC25, 0U, 0U, NULL };
+static PMIC_Model_StatsTypeDef model_stats;
+
+/* Private function prototypes -----------------------------------------------*/
+static int PMIC_Model_Address(uint16_t DevAddress, uint16_t Reg, uint16_t Size);
+static void PMIC_Model_Update(void);
+
+/* Functions Definition ------------------------------------------------------*/
+/**
+  * @brief Configure the modeled PMIC, its registers are reset
+  * @param pConfig: pointer to the model configuration
+  * @retval None
+  */
+void PMIC_Model_Config(const PMIC_Model_ConfigTypeDef *pConfig)
+{
+  model_config = *pConfig;
+
+  PMIC_Model_Reset();
+}
+
+/**
+  * @brief Blank the modeled NVM
+  * @param None
+  * @retval None
+  */
+void PMIC_Model_Erase(void)
+{
+  memset(model_nvm, 0, sizeof(model_nvm));
+}
+
+/**
+  * @brief Model a power cycle: the shadow registers are reloaded from NVM
+  * @param None
+  * @retval None
+  */
+void PMIC_Model_Reset(void)
+{
+  const PMIC_Model_MapTypeDef *map;
+
+  memset(model_reg, 0, sizeof(model_reg));
+  model_busy = false;
+
+  if (model_config.Type < PMIC_MODEL_NONE)
+  {
+    map = &model_map[model_config.Type];
+    model_reg[PMIC_MODEL_PRODUCT_ID_ADDR] = map->ProductId;
+    memcpy(&model_reg[map->NVMStartAddress], model_nvm, map->NVMSize);
+  }
+}
+
+/**
+  * @brief Get the transfer counters
+  * @param pStats: pointer to the counters filled in place
+  * @retval None
+  */
+void PMIC_Model_GetStats(PMIC_Model_StatsTypeDef *pStats)
+{
+  *pStats = model_stats;
+}
+
+/**
+  * @brief Clear the transfer counters
+  * @param None
+  * @retval None
+  */
+void PMIC_Model_ResetStats(void)
+{
+  memset(&model_stats, 0, sizeof(model_stats));
+}
+
+/**
+  * @brief End the NVM programming once its duration is elapsed
+  * @param None
+  * @retval None
+  */
+static void PMIC_Model_Update(void)
+{
+  const PMIC_Model_MapTypeDef *map = &model_map[model_config.Type];
+
+  if (!model_busy)
+  {
+    return;
+  }
+
+  if ((model_config.Time == NULL) ||
+      ((model_config.Time() - model_busy_start) >= (model_config.ProgramDelay * 1000U)))
+  {
+    memcpy(model_nvm, &model_reg[map->NVMStartAddress], map->NVMSize);
+    model_reg[map->NVMSRRegisterAddr] &= (uint8_t)~PMIC_MODEL_NVM_BUSY_MSK;
+    model_busy = false;
+  }
+}
+
+/**
+  * @brief Address phase of a transfer
+  * @param DevAddress: target device address
+  * @param Reg: first register
+  * @param Size: number of registers
+  * @retval PMIC_MODEL_OK: if the PMIC acknowledges the transfer
+  *         other: if error
+  */
+static int PMIC_Model_Address(uint16_t DevAddress, uint16_t Reg, uint16_t Size)
+{
+  if ((model_config.Type >= PMIC_MODEL_NONE) || (DevAddress != PMIC_MODEL_I2C_ADDRESS) ||
+      (model_config.NackCount != 0U))
+  {
+    if (model_config.NackCount != 0U)
+    {
+      model_config.NackCount--;
+    }
+
+    model_stats.NackCount++;
+    return PMIC_MODEL_NACK;
+  }
+
+  if ((Size == 0U) || (((uint32_t)Reg + Size) > PMIC_MODEL_REG_NUMBER))
+  {
+    return PMIC_MODEL_PARAM_ERROR;
+  }
+
+  PMIC_Model_Update();
+
+  return PMIC_MODEL_OK;
+}
+
+/**
+  * @brief Read consecutive PMIC registers
+  * @param DevAddress: target device address
+  * @param Reg: first register
+  * @param pData: pointer to the register values
+  * @param Size: number of registers
+  * @retval PMIC_MODEL_OK: if no error
+  *         other: if error
+  */
+int PMIC_Model_Read(uint16_t DevAddress, uint16_t Reg, uint8_t *pData, uint16_t Size)
+{
+  int ret;
+
+  ret = PMIC_Model_Address(DevAddress, Reg, Size);
+  if (ret != PMIC_MODEL_OK)
+  {
+    return ret;
+  }
+
+  model_stats.ReadCount++;
+  model_stats.ReadBytes += Size;
+
+  if (model_busy && (Reg == model_map[model_config.Type].NVMSRRegisterAddr))
+  {
+    model_stats.BusyPolls++;
+  }
+
+  memcpy(pData, &model_reg[Reg], Size);
+
+  return PMIC_MODEL_OK;
+}
+
+/**
+  * @brief Write consecutive PMIC registers
+  * @param DevAddress: target device address
+  * @param Reg: first register
+  * @param pData: pointer to the register values
+  * @param Size: number of registers
+  * @retval PMIC_MODEL_OK: if no error
+  *         other: if error
+  */
+int PMIC_Model_Write(uint16_t DevAddress, uint16_t Reg, const uint8_t *pData, uint16_t Size)
+{
+  const PMIC_Model_MapTypeDef *map;
+  uint16_t idx;
+  uint16_t reg;
+  int ret;
+
+  ret = PMIC_Model_Address(DevAddress, Reg, Size);
+  if (ret != PMIC_MODEL_OK)
+  {
+    return ret;
+  }
+
+  map = &model_map[model_config.Type];
+  model_stats.WriteCount++;
+  model_stats.WriteBytes += Size;
+
+  for (idx = 0U; idx < Size; idx++)
+  {
+    reg = Reg + idx;
+
+    /* Product ID and NVM status are read only */
+    if ((reg == PMIC_MODEL_PRODUCT_ID_ADDR) || (reg == map->NVMSRRegisterAddr))
+    {
+      continue;
+    }
+
+    model_reg[reg] = pData[idx];
+
+    if ((reg != map->NVMCRRegisterAddr) || model_busy)
+    {
+      continue;
+    }
+
+    if ((pData[idx] & PMIC_MODEL_NVM_CMD_MSK) == PMIC_MODEL_NVM_CMD_PROGRAM)
+    {
+      model_stats.ProgCount++;
+      model_reg[map->NVMSRRegisterAddr] |= PMIC_MODEL_NVM_BUSY_MSK;
+      model_busy_start = (model_config.Time != NULL) ? model_config.Time() : 0U;
+      model_busy = true;
+    }
+    else if ((pData[idx] & PMIC_MODEL_NVM_CMD_MSK) == PMIC_MODEL_NVM_CMD_READ)
+    {
+      memcpy(&model_reg[map->NVMStartAddress], model_nvm, map->NVMSize);
+    }
+    else
+    {
+      /* No NVM operation */
+    }
+  }
+
+  return PMIC_MODEL_OK;
+}
+#endif /* USE_PMIC_EMULATION */
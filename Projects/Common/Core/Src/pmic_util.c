@@ -18,22 +18,78 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "pmic_util.h"
+#include "pmic_emul.h"
 
 /* Global variables ----------------------------------------------------------*/
 /* Private typedef -----------------------------------------------------------*/
+/* I2C specification characteristics of a bus speed, times in ns */
+typedef struct
+{
+  uint32_t   Freq;              /* SCL frequency, in kHz */
+  uint32_t   LowMin;            /* tLOW min */
+  uint32_t   HighMin;           /* tHIGH min */
+  uint32_t   Rise;              /* tr max */
+  uint32_t   Fall;              /* tf max */
+  uint32_t   SuDatMin;          /* tSU;DAT min */
+  uint32_t   VdDatMax;          /* tVD;DAT max */
+} pmic_i2c_spec_t;
+
 /* Private defines -----------------------------------------------------------*/
+#define PMIC_I2C_AF_DELAY_MIN      50U    /* Analog filter delay min, in ns */
+#define PMIC_I2C_AF_DELAY_MAX      260U   /* Analog filter delay max, in ns */
+#define PMIC_I2C_BUS_ERRORS        (HAL_I2C_ERROR_AF | HAL_I2C_ERROR_ARLO | HAL_I2C_ERROR_BERR)
+
 /* Private macros ------------------------------------------------------------*/
+/* Number of kernel clock cycles in a duration, rounded up */
+#define PMIC_I2C_CYCLES(ns, khz)   ((int32_t)((((ns) * (khz)) + 999999U) / 1000000U))
+
+#if defined(USE_PMIC_EMULATION)
+/* Virtual bus clock of the emulated PMIC, advanced by the transfers and the waits */
+#define PMIC_UTIL_TIME_US()        PMIC_Emul_GetTime()
+#elif defined(CORE_CA7)
+/* Generic timer, counting at HSI frequency as the HAL time base */
+#define PMIC_UTIL_TIME_US()        ((uint32_t)(PL1_GetCurrentPhysicalValue() / (HSI_VALUE / 1000000UL)))
+#elif defined(CORE_CA35)
+/* Generic timer, counting at the STGEN frequency set in CNTFRQ by SystemInit */
+#define PMIC_UTIL_TIME_US()        ((uint32_t)(PL1_GetCurrentPhysicalValue() / (__get_CNTFRQ() / 1000000UL)))
+#else
+#define PMIC_UTIL_TIME_US()        (HAL_GetTick() * 1000UL)
+#endif /* USE_PMIC_EMULATION */
+
 /* Private variables ---------------------------------------------------------*/
 static I2C_HandleTypeDef hi2c;
 static const pmic_data_t pmic_database[PMIC_MAX] =
 {
-  /*Supported, Identifier, NVMSize, DisplayString, NVMStartAddress, NVMSRRegisterAddr, NVMCRRegisterAddr */
-  {PMIC_SUPPORTED,     0x20, 40, "25", 0x90, 0x8E, 0x8F}, /* PMIC_STPMIC25 */
-  {PMIC_SUPPORTED,     0x00,  8, "1", 0xF8, 0xB8, 0xB9}, /* PMIC_STPMIC1 */
+  /*Supported, Identifier, NVMSize, DisplayString, NVMStartAddress, NVMSRRegisterAddr, NVMCRRegisterAddr, AutoIncrement,
+    MaxSpeed */
+  {PMIC_SUPPORTED,     0x20, 40, "25", 0x90, 0x8E, 0x8F, 1, PMIC_I2C_FAST_PLUS}, /* PMIC_STPMIC25 */
+  {PMIC_SUPPORTED,     0x00,  8, "1", 0xF8, 0xB8, 0xB9, 1, PMIC_I2C_FAST_PLUS}, /* PMIC_STPMIC1 */
+};
+
+static const pmic_i2c_spec_t i2c_spec[PMIC_I2C_SPEED_NUMBER] =
+{
+  /* Freq, LowMin, HighMin, Rise, Fall, SuDatMin, VdDatMax */
+  { 100U, 4700U, 4000U, 1000U, 300U, 250U, 3450U}, /* PMIC_I2C_STANDARD */
+  { 400U, 1300U,  600U,  300U, 300U, 100U,  900U}, /* PMIC_I2C_FAST */
+  {1000U,  500U,  260U,  120U, 120U,  50U,  450U}, /* PMIC_I2C_FAST_PLUS */
 };
 
 static uint32_t nvm_id = 0U;
+static pmic_write_result_t write_result;
+static uint32_t nvm_prog_time = PMIC_NVM_PROG_TIME;
+static bool shadow_dirty = false;  /* Shadow registers written but not programmed */
+static pmic_context_t pmic_context = { false, PMIC_I2C_STANDARD, 0U, PMIC_ERROR_NO_PMIC, { 0 }, false, { 0U } };
 /* Private function prototypes -----------------------------------------------*/
+static void PMIC_Util_InitPins(void);
+static void PMIC_Util_BusDelay(void);
+static void PMIC_Util_DelayUs(uint32_t delay);
+static void PMIC_Util_BusRecovery(void);
+static uint32_t PMIC_Util_ComputeTiming(uint32_t clk_khz, const pmic_i2c_spec_t *spec, uint32_t filter);
+static HAL_StatusTypeDef PMIC_Util_SetSpeed(uint8_t speed);
+static bool PMIC_Util_FallBack(void);
+static void PMIC_Util_Negotiate(void);
+static HAL_StatusTypeDef PMIC_Util_ReadRegs(uint8_t reg, uint8_t *data, uint8_t size, const pmic_data_t *pmic_data);
+static uint32_t PMIC_Util_ProgramNVM(const pmic_data_t *pmic_data);
 /* Functions Definition ------------------------------------------------------*/
 
 /**
@@ -43,27 +99,14 @@ static uint32_t nvm_id = 0U;
   */
 void PMIC_Util_Init(void)
 {
-  GPIO_InitTypeDef  gpio_init_structure;
-
   /*** Configure the GPIOs ***/
   /* Enable GPIO clock */
 
   BUS_I2C_SCL_GPIO_CLK_ENABLE();
   BUS_I2C_SDA_GPIO_CLK_ENABLE();
 
-  gpio_init_structure.Mode = GPIO_MODE_AF_OD;
-  gpio_init_structure.Pull = GPIO_NOPULL;
-  gpio_init_structure.Speed = GPIO_SPEED_FREQ_HIGH;
-
-  /* Configure I2C SCL clock as alternate function */
-  gpio_init_structure.Alternate = BUS_I2C_SCL_AF;
-  gpio_init_structure.Pin = BUS_I2C_SCL_PIN;
-  HAL_GPIO_Init(BUS_I2C_SCL_GPIO_PORT, &gpio_init_structure);
-
-  /* Configure I2C SDA data as alternate function */
-  gpio_init_structure.Alternate = BUS_I2C_SDA_AF;
-  gpio_init_structure.Pin = BUS_I2C_SDA_PIN;
-  HAL_GPIO_Init(BUS_I2C_SDA_GPIO_PORT, &gpio_init_structure);
+  /* Release the bus if a transfer was interrupted, e.g. by a reset */
+  PMIC_Util_BusRecovery();
 
   /*** Configure the I2C peripheral ***/
   /* Enable I2C clock */
@@ -84,7 +127,6 @@ void PMIC_Util_Init(void)
 #endif /* CORE_CA7 */
 
   hi2c.Instance              = BUS_I2C_INSTANCE;
-  hi2c.Init.Timing           = BUS_I2Cx_TIMING;
   hi2c.Init.OwnAddress1      = OWN_I2C_SLAVE_ADDRESS;
   hi2c.Init.AddressingMode   = I2C_ADDRESSINGMODE_7BIT;
   hi2c.Init.DualAddressMode  = I2C_DUALADDRESS_DISABLE;
@@ -93,7 +135,265 @@ void PMIC_Util_Init(void)
   hi2c.Init.GeneralCallMode  = I2C_GENERALCALL_DISABLE;
   hi2c.Init.NoStretchMode    = I2C_NOSTRETCH_DISABLE;
 
-  HAL_I2C_Init(&hi2c);
+  /* The PMIC is detected in standard-mode, which every PMIC supports */
+  (void)PMIC_Util_SetSpeed(PMIC_I2C_STANDARD);
+
+  pmic_context.BusReady = true;
+}
+
+/**
+  * @brief  Configure the I2C pins as alternate function.
+  * @param  None
+  * @retval None.
+  */
+static void PMIC_Util_InitPins(void)
+{
+  GPIO_InitTypeDef  gpio_init_structure;
+
+  gpio_init_structure.Mode = GPIO_MODE_AF_OD;
+  gpio_init_structure.Pull = GPIO_NOPULL;
+  gpio_init_structure.Speed = GPIO_SPEED_FREQ_HIGH;
+
+  /* Configure I2C SCL clock as alternate function */
+  gpio_init_structure.Alternate = BUS_I2C_SCL_AF;
+  gpio_init_structure.Pin = BUS_I2C_SCL_PIN;
+  HAL_GPIO_Init(BUS_I2C_SCL_GPIO_PORT, &gpio_init_structure);
+
+  /* Configure I2C SDA data as alternate function */
+  gpio_init_structure.Alternate = BUS_I2C_SDA_AF;
+  gpio_init_structure.Pin = BUS_I2C_SDA_PIN;
+  HAL_GPIO_Init(BUS_I2C_SDA_GPIO_PORT, &gpio_init_structure);
+}
+
+/**
+  * @brief  Wait for half an SCL period of the bus recovery.
+  * @param  None
+  * @retval None.
+  * @note   Counted in core cycles, the tick does not run in interrupt context.
+  *         Each loop takes at least one cycle, so the delay is never shorter.
+  */
+static void PMIC_Util_BusDelay(void)
+{
+  volatile uint32_t cycles = (SystemCoreClock / 1000000U) * PMIC_I2C_RECOVERY_HALF_US;
+
+  while (cycles > 0U)
+  {
+    cycles--;
+  }
+}
+
+/**
+  * @brief  Release a slave holding SDA low: SCL is clocked until SDA is
+  *         released then a STOP condition is generated. The pins are left
+  *         configured as alternate function.
+  * @param  None
+  * @retval None.
+  */
+static void PMIC_Util_BusRecovery(void)
+{
+  GPIO_InitTypeDef  gpio_init_structure;
+  uint32_t pulse;
+
+  /* Drive the pins as open drain GPIOs, both released */
+  gpio_init_structure.Mode = GPIO_MODE_OUTPUT_OD;
+  gpio_init_structure.Pull = GPIO_NOPULL;
+  gpio_init_structure.Speed = GPIO_SPEED_FREQ_HIGH;
+  gpio_init_structure.Alternate = 0U;
+
+  HAL_GPIO_WritePin(BUS_I2C_SCL_GPIO_PORT, BUS_I2C_SCL_PIN, GPIO_PIN_SET);
+  gpio_init_structure.Pin = BUS_I2C_SCL_PIN;
+  HAL_GPIO_Init(BUS_I2C_SCL_GPIO_PORT, &gpio_init_structure);
+
+  HAL_GPIO_WritePin(BUS_I2C_SDA_GPIO_PORT, BUS_I2C_SDA_PIN, GPIO_PIN_SET);
+  gpio_init_structure.Pin = BUS_I2C_SDA_PIN;
+  HAL_GPIO_Init(BUS_I2C_SDA_GPIO_PORT, &gpio_init_structure);
+
+  PMIC_Util_BusDelay();
+
+  if (HAL_GPIO_ReadPin(BUS_I2C_SDA_GPIO_PORT, BUS_I2C_SDA_PIN) == GPIO_PIN_RESET)
+  {
+    /* Clock out the byte the slave is sending, one bit per pulse */
+    for (pulse = 0U; (pulse < PMIC_I2C_RECOVERY_PULSES) &&
+         (HAL_GPIO_ReadPin(BUS_I2C_SDA_GPIO_PORT, BUS_I2C_SDA_PIN) == GPIO_PIN_RESET); pulse++)
+    {
+      HAL_GPIO_WritePin(BUS_I2C_SCL_GPIO_PORT, BUS_I2C_SCL_PIN, GPIO_PIN_RESET);
+      PMIC_Util_BusDelay();
+      HAL_GPIO_WritePin(BUS_I2C_SCL_GPIO_PORT, BUS_I2C_SCL_PIN, GPIO_PIN_SET);
+      PMIC_Util_BusDelay();
+    }
+
+    /* STOP condition: SDA rising while SCL is high */
+    HAL_GPIO_WritePin(BUS_I2C_SCL_GPIO_PORT, BUS_I2C_SCL_PIN, GPIO_PIN_RESET);
+    PMIC_Util_BusDelay();
+    HAL_GPIO_WritePin(BUS_I2C_SDA_GPIO_PORT, BUS_I2C_SDA_PIN, GPIO_PIN_RESET);
+    PMIC_Util_BusDelay();
+    HAL_GPIO_WritePin(BUS_I2C_SCL_GPIO_PORT, BUS_I2C_SCL_PIN, GPIO_PIN_SET);
+    PMIC_Util_BusDelay();
+    HAL_GPIO_WritePin(BUS_I2C_SDA_GPIO_PORT, BUS_I2C_SDA_PIN, GPIO_PIN_SET);
+    PMIC_Util_BusDelay();
+  }
+
+  PMIC_Util_InitPins();
+}
+
+/**
+  * @brief  Compute the I2C TIMINGR value of a bus speed.
+  * @param  clk_khz: I2C kernel clock frequency, in kHz.
+  * @param  spec: I2C specification characteristics of the bus speed.
+  * @param  filter: 1 when the analog filter is enabled.
+  * @retval uint32_t: TIMINGR value, 0 if the kernel clock does not allow this speed.
+  * @note   The smallest prescaler is used for the best SCL resolution. The
+  *         SCL period is split between tLOW and tHIGH in the ratio of their
+  *         minimums, so the bus never runs faster than the requested speed.
+  */
+static uint32_t PMIC_Util_ComputeTiming(uint32_t clk_khz, const pmic_i2c_spec_t *spec, uint32_t filter)
+{
+  uint32_t af_min = (filter != 0U) ? PMIC_I2C_AF_DELAY_MIN : 0U;
+  uint32_t af_max = (filter != 0U) ? PMIC_I2C_AF_DELAY_MAX : 0U;
+  uint32_t period = (1000000U / spec->Freq) - spec->Rise - spec->Fall;
+  uint32_t low = (period * spec->LowMin) / (spec->LowMin + spec->HighMin);
+  int32_t low_cycles = PMIC_I2C_CYCLES(low, clk_khz);
+  int32_t high_cycles = PMIC_I2C_CYCLES(period - low, clk_khz);
+  int32_t scldel_cycles = PMIC_I2C_CYCLES(spec->Rise + spec->SuDatMin, clk_khz);
+  int32_t sdadel_min;
+  int32_t sdadel_max;
+  int32_t presc;
+  int32_t scll;
+  int32_t sclh;
+  int32_t scldel;
+  int32_t sdadel;
+
+  /* Data hold time, the internal delays are 3 to 4 kernel clock cycles */
+  sdadel_min = ((spec->Fall > af_min) ? PMIC_I2C_CYCLES(spec->Fall - af_min, clk_khz) : 0) - 3;
+  sdadel_max = (int32_t)(((spec->VdDatMax - spec->Rise - af_max) * clk_khz) / 1000000U) - 4;
+  if (sdadel_min < 0)
+  {
+    sdadel_min = 0;
+  }
+
+  for (presc = 1; presc <= 16; presc++)
+  {
+    scll   = ((low_cycles + presc - 1) / presc) - 1;
+    sclh   = ((high_cycles + presc - 1) / presc) - 1;
+    scldel = ((scldel_cycles + presc - 1) / presc) - 1;
+    sdadel = (sdadel_min + presc - 1) / presc;
+
+    if ((scll <= 255) && (sclh <= 255) && (scldel <= 15) && (sdadel <= 15) && ((sdadel * presc) <= sdadel_max))
+    {
+      return (((uint32_t)presc - 1U) << I2C_TIMINGR_PRESC_Pos) | ((uint32_t)scldel << I2C_TIMINGR_SCLDEL_Pos) |
+             ((uint32_t)sdadel << I2C_TIMINGR_SDADEL_Pos) | ((uint32_t)sclh << I2C_TIMINGR_SCLH_Pos) |
+             ((uint32_t)scll << I2C_TIMINGR_SCLL_Pos);
+    }
+  }
+
+  return 0U;
+}
+
+/**
+  * @brief  Configure the I2C instance for a bus speed.
+  * @param  speed: bus speed, pmic_i2c_speed_t.
+  * @retval HAL_OK if the kernel clock allows this speed.
+  * @note   The analog filter is disabled only when its delay leaves no
+  *         valid data hold time, which happens in Fast-mode Plus.
+  */
+static HAL_StatusTypeDef PMIC_Util_SetSpeed(uint8_t speed)
+{
+  uint32_t clk_khz = HAL_RCCEx_GetPeriphCLKFreq(BUS_I2C_PERIPHCLK) / 1000U;
+  uint32_t filter = 1U;
+  uint32_t timing = 0U;
+
+  if (clk_khz != 0U)
+  {
+    timing = PMIC_Util_ComputeTiming(clk_khz, &i2c_spec[speed], filter);
+    if (timing == 0U)
+    {
+      filter = 0U;
+      timing = PMIC_Util_ComputeTiming(clk_khz, &i2c_spec[speed], filter);
+    }
+  }
+
+  if (timing == 0U)
+  {
+    if (speed != PMIC_I2C_STANDARD)
+    {
+      return HAL_ERROR;
+    }
+
+    filter = 1U;
+    timing = BUS_I2Cx_TIMING;
+  }
+
+  hi2c.Init.Timing = timing;
+  if (HAL_I2C_Init(&hi2c) != HAL_OK)
+  {
+    return HAL_ERROR;
+  }
+
+  if (HAL_I2CEx_ConfigAnalogFilter(&hi2c, (filter != 0U) ? I2C_ANALOGFILTER_ENABLE : I2C_ANALOGFILTER_DISABLE) != HAL_OK)
+  {
+    return HAL_ERROR;
+  }
+
+  pmic_context.BusSpeed = speed;
+  pmic_context.BusFreq = i2c_spec[speed].Freq;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Step down the bus speed after a NACK, arbitration or bus error.
+  * @param  None
+  * @retval bool: true if the failed transfer can be retried at a lower speed.
+  */
+static bool PMIC_Util_FallBack(void)
+{
+  uint8_t speed = pmic_context.BusSpeed;
+
+  if (((HAL_I2C_GetError(&hi2c) & PMIC_I2C_BUS_ERRORS) == 0U) || (speed == PMIC_I2C_STANDARD))
+  {
+    return false;
+  }
+
+  PMIC_Util_BusRecovery();
+
+  while (speed > PMIC_I2C_STANDARD)
+  {
+    speed--;
+    if (PMIC_Util_SetSpeed(speed) == HAL_OK)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+  * @brief  Switch to the fastest bus speed at which the detected PMIC answers.
+  * @param  None
+  * @retval None.
+  */
+static void PMIC_Util_Negotiate(void)
+{
+  uint8_t speed = pmic_context.Pmic.MaxSpeed;
+  uint8_t data;
+
+  for (; speed > PMIC_I2C_STANDARD; speed--)
+  {
+    if ((PMIC_Util_SetSpeed(speed) == HAL_OK) &&
+        (HAL_I2C_Mem_Read(&hi2c, PMIC_I2C_ADDRESS, PMIC_PRODUCT_ID_SR_ADDR, I2C_MEMADD_SIZE_8BIT,
+                          &data, 1, 100) == HAL_OK) && (data == nvm_id))
+    {
+      return;
+    }
+
+    if ((HAL_I2C_GetError(&hi2c) & PMIC_I2C_BUS_ERRORS) != 0U)
+    {
+      PMIC_Util_BusRecovery();
+    }
+  }
+
+  (void)PMIC_Util_SetSpeed(PMIC_I2C_STANDARD);
 }
 
 /**
@@ -101,57 +401,105 @@ void PMIC_Util_Init(void)
   * @param addr: address of the memory from which to read or write the PMIC.
   * @param ops: operation to perform PMIC_SHADOW_WRITE or PMIC_SHADOW_READ.
   * @param pmic_data: PMIC information.
-  * @retval none
+  * @retval uint32_t: PMIC_ERROR_NONE if the operation is done
   */
-void PMIC_Util_ReadWrite(uint8_t *addr, pmic_nvm_ops_t ops, pmic_data_t *pmic_data)
+uint32_t PMIC_Util_ReadWrite(uint8_t *addr, pmic_nvm_ops_t ops, pmic_data_t *pmic_data)
 {
-  uint8_t data;
-  uint16_t count = 0U;
+  uint8_t shadow[MAX_PMIC_NVM_SIZE];
+  uint8_t idx;
+  uint8_t run;
+  uint32_t ret = PMIC_ERROR_NONE;
 
   if ((pmic_data == NULL) || (addr == NULL))
   {
-    return;
+    return PMIC_ERROR_INVALID_ARG;
   }
 
   switch (ops)
   {
     case PMIC_SHADOW_READ:
-      for (uint8_t idx = 0; idx < pmic_data->NVMSize; idx++)
+      if (PMIC_Util_ReadRegs(pmic_data->NVMStartAddress, addr, pmic_data->NVMSize, pmic_data) != HAL_OK)
       {
-        if (HAL_I2C_Mem_Read(&hi2c, PMIC_I2C_ADDRESS,
-                             (pmic_data->NVMStartAddress) + idx, I2C_MEMADD_SIZE_8BIT, &data, 1, 1000) == 0U)
-        {
-          *(addr + idx) = data;
-        }
-        else
-        {
-          while (1) {}; /* Error */
-        }
+        return PMIC_ERROR_I2C;
       }
+
+      /* The shadow registers only match the NVM when no write is pending */
+      memcpy(pmic_context.NVM, addr, pmic_data->NVMSize);
+      pmic_context.NVMValid = !shadow_dirty;
       break;
 
     case PMIC_SHADOW_WRITE:
-      for (uint8_t idx = 0; idx < pmic_data->NVMSize; idx++)
+      memset(&write_result, 0, sizeof(write_result));
+      pmic_context.NVMValid = false;
+      shadow_dirty = true;
+
+      /* Get the current shadow values */
+      if (PMIC_Util_ReadRegs(pmic_data->NVMStartAddress, shadow, pmic_data->NVMSize, pmic_data) != HAL_OK)
+      {
+        return PMIC_ERROR_I2C;
+      }
+
+      /* Write each run of consecutive changed registers in one transaction */
+      idx = 0U;
+      while (idx < pmic_data->NVMSize)
       {
-        if (HAL_I2C_Mem_Read(&hi2c, PMIC_I2C_ADDRESS,
-                             (pmic_data->NVMStartAddress) + idx, I2C_MEMADD_SIZE_8BIT, &data, 1, 1000) == 0U)
+        if (shadow[idx] == *(addr + idx))
         {
-          if (data != *(addr + idx))
-          {
-            data = *(addr + idx);
-            HAL_I2C_Mem_Write(&hi2c, PMIC_I2C_ADDRESS, (pmic_data->NVMStartAddress) + idx,
-                              I2C_MEMADD_SIZE_8BIT, &data, 1, 1000);
-          }
-          else
+          /* Do nothing value is already programmed */
+          idx++;
+          continue;
+        }
+
+        run = 1U;
+        while ((pmic_data->AutoIncrement != 0U) && ((idx + run) < pmic_data->NVMSize)
+               && (shadow[idx + run] != *(addr + idx + run)))
+        {
+          run++;
+        }
+
+        while (HAL_I2C_Mem_Write(&hi2c, PMIC_I2C_ADDRESS, (pmic_data->NVMStartAddress) + idx,
+                                 I2C_MEMADD_SIZE_8BIT, addr + idx, run, 1000) != HAL_OK)
+        {
+          if (PMIC_Util_FallBack() == false)
           {
-            /* Do nothing value is already programmed */
+            return PMIC_ERROR_I2C;
           }
         }
-        else
+        write_result.WriteCount++;
+        write_result.DirtyCount += run;
+
+        for (; run > 0U; run--, idx++)
+        {
+          write_result.DirtyMap |= (1ULL << idx);
+        }
+      }
+
+      /* Check the written shadow values */
+      if (PMIC_Util_ReadRegs(pmic_data->NVMStartAddress, shadow, pmic_data->NVMSize, pmic_data) != HAL_OK)
+      {
+        return PMIC_ERROR_I2C;
+      }
+
+      for (idx = 0U; idx < pmic_data->NVMSize; idx++)
+      {
+        if (shadow[idx] != *(addr + idx))
         {
-          while (1) {}; /* Error */
+          write_result.ErrorMap |= (1ULL << idx);
         }
+      }
+
+      /* Do not burn shadow values which are not the requested ones */
+      if (write_result.ErrorMap != 0U)
+      {
+        return PMIC_ERROR_VERIFY;
+      }
 
+      ret = PMIC_Util_ProgramNVM(pmic_data);
+      if (ret == PMIC_ERROR_NONE)
+      {
+        memcpy(pmic_context.NVM, shadow, pmic_data->NVMSize);
+        pmic_context.NVMValid = true;
+        shadow_dirty = false;
       }
       break;
 
@@ -159,33 +507,114 @@ void PMIC_Util_ReadWrite(uint8_t *addr, pmic_nvm_ops_t ops, pmic_data_t *pmic_da
       break;
   }
 
-  if (ops == PMIC_SHADOW_WRITE)
+  return ret;
+}
+
+/**
+  * @brief wait on the generic timer
+  * @param delay: duration of the wait, in us
+  * @retval None.
+  * @note   The generic timer also runs in interrupt context, where the HAL
+  *         tick does not advance.
+  */
+static void PMIC_Util_DelayUs(uint32_t delay)
+{
+#if defined(USE_PMIC_EMULATION)
+  PMIC_Emul_Delay(delay);
+#else
+  uint32_t start = PMIC_UTIL_TIME_US();
+
+  while ((PMIC_UTIL_TIME_US() - start) < delay)
   {
+  }
+#endif /* USE_PMIC_EMULATION */
+}
 
-    data = 0xfd;
+/**
+  * @brief program the NVM with the shadow registers and wait for its end
+  * @param pmic_data: PMIC information.
+  * @retval uint32_t: PMIC_ERROR_NONE if the NVM is programmed
+  * @note   The first status read is done after 3/4 of the last measured
+  *         programming duration, then the wait between the reads doubles
+  *         from PMIC_NVM_POLL_MIN_US to PMIC_NVM_POLL_MAX_US. The duration
+  *         is measured on the generic timer, so the estimate follows the NVM.
+  */
+static uint32_t PMIC_Util_ProgramNVM(const pmic_data_t *pmic_data)
+{
+  uint8_t data = 0xfd;
+  uint32_t start;
+  uint32_t elapsed;
+  uint32_t delay = (nvm_prog_time * 1000U * 3U) / 4U;
+  uint32_t backoff = PMIC_NVM_POLL_MIN_US;
+
+  if (HAL_I2C_Mem_Write(&hi2c, PMIC_I2C_ADDRESS, pmic_data->NVMCRRegisterAddr, I2C_MEMADD_SIZE_8BIT,
+                        &data, 1, 100) != HAL_OK)
+  {
+    return PMIC_ERROR_I2C;
+  }
 
-    HAL_I2C_Mem_Write(&hi2c, PMIC_I2C_ADDRESS, pmic_data->NVMCRRegisterAddr, I2C_MEMADD_SIZE_8BIT, &data, 1, 100);
+  start = PMIC_UTIL_TIME_US();
 
-    count = PMIC_SR_REG_TIMEOUT;
+  do
+  {
+    PMIC_Util_DelayUs(delay);
 
-    for (count = 0; count < PMIC_SR_REG_TIMEOUT; count++)
+    if (HAL_I2C_Mem_Read(&hi2c, PMIC_I2C_ADDRESS, pmic_data->NVMSRRegisterAddr, I2C_MEMADD_SIZE_8BIT,
+                         &data, 1, 100) != HAL_OK)
     {
+      return PMIC_ERROR_I2C;
+    }
 
-      HAL_I2C_Mem_Read(&hi2c, PMIC_I2C_ADDRESS, pmic_data->NVMSRRegisterAddr, I2C_MEMADD_SIZE_8BIT, &data, 1, 100);
+    elapsed = PMIC_UTIL_TIME_US() - start;
+    write_result.ProgTime = (elapsed + 999U) / 1000U;
 
-      if ((PMIC_NVM_BUSY_MSK & data) == 0U)
-      {
-        break;
-      }
+    if ((PMIC_NVM_BUSY_MSK & data) == 0U)
+    {
+      nvm_prog_time = write_result.ProgTime;
+      return PMIC_ERROR_NONE;
+    }
 
+    delay = backoff;
+    if (backoff < PMIC_NVM_POLL_MAX_US)
+    {
+      backoff *= 2U;
     }
+  } while (elapsed < (PMIC_SR_REG_TIMEOUT * 1000U));
 
-    if ((PMIC_NVM_BUSY_MSK & data) != 0U)
+  return PMIC_ERROR_NVM_TIMEOUT;
+}
+
+/**
+  * @brief read consecutive PMIC registers
+  * @param reg: address of the first register.
+  * @param data: pointer to the register values.
+  * @param size: number of registers.
+  * @param pmic_data: PMIC information.
+  * @retval HAL_OK if all the registers are read
+  */
+static HAL_StatusTypeDef PMIC_Util_ReadRegs(uint8_t reg, uint8_t *data, uint8_t size, const pmic_data_t *pmic_data)
+{
+  HAL_StatusTypeDef status;
+
+  do
+  {
+    status = HAL_OK;
+
+    /* Burst read of the whole window in one transaction */
+    if (pmic_data->AutoIncrement != 0U)
     {
-      while (1); /* hold the code so that a system reset can be performed. */
+      status = HAL_I2C_Mem_Read(&hi2c, PMIC_I2C_ADDRESS, reg, I2C_MEMADD_SIZE_8BIT, data, size, 1000);
     }
-  }
+    else
+    {
+      for (uint8_t idx = 0; (idx < size) && (status == HAL_OK); idx++)
+      {
+        status = HAL_I2C_Mem_Read(&hi2c, PMIC_I2C_ADDRESS, reg + idx, I2C_MEMADD_SIZE_8BIT, data + idx, 1, 1000);
+      }
+    }
+  } while ((status != HAL_OK) && PMIC_Util_FallBack());
 
+  return status;
 }
 
 /**
@@ -239,3 +668,64 @@ uint8_t PMIC_Util_GetNVMID(void)
 	return nvm_id;
 }
 
+/**
+  * @brief api to return the PMIC context, the I2C bus is configured and the
+  *        PMIC detected on the first call
+  * @retval pmic_context_t: PMIC context, Status gives the detection result
+  */
+pmic_context_t *PMIC_Util_GetContext(void)
+{
+  if (pmic_context.BusReady == false)
+  {
+    PMIC_Util_Init();
+  }
+
+  /* Detect again until a PMIC answers */
+  if (pmic_context.Status != PMIC_ERROR_NONE)
+  {
+    pmic_context.NVMValid = false;
+    if (pmic_context.BusSpeed != PMIC_I2C_STANDARD)
+    {
+      (void)PMIC_Util_SetSpeed(PMIC_I2C_STANDARD);
+    }
+
+    pmic_context.Status = PMIC_Util_Detect_PMIC(&pmic_context.Pmic);
+    if (pmic_context.Status == PMIC_ERROR_NONE)
+    {
+      PMIC_Util_Negotiate();
+    }
+  }
+
+  return &pmic_context;
+}
+
+/**
+  * @brief api to detect the PMIC again, e.g. after it was replaced
+  * @retval pmic_context_t: PMIC context, Status gives the detection result
+  */
+pmic_context_t *PMIC_Util_Redetect(void)
+{
+  pmic_context.Status = PMIC_ERROR_NO_PMIC;
+
+  return PMIC_Util_GetContext();
+}
+
+/**
+  * @brief api to return the per register result of the last NVM write
+  * @param result: pointer to the result filled in place
+  * @retval none
+  */
+void PMIC_Util_GetWriteResult(pmic_write_result_t *result)
+{
+  *result = write_result;
+}
+
+/**
+  * @brief api to return the expected NVM programming duration
+  * @retval uint32_t: duration of the last NVM programming, in ms
+  */
+uint32_t PMIC_Util_GetProgTime(void)
+{
+  return nvm_prog_time;
+}
+
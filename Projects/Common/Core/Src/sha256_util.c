@@ -0,0 +1,237 @@
+/**
+  ******************************************************************************
+  * @file    sha256_util.c
+  * @author  MCD Application Team
+  * @brief   Software SHA-256 (FIPS 180-4) for devices without HASH peripheral.
+  *          The message is handled as big-endian 32-bit words, the message
+  *          schedule is computed in place in a 16 words ring and the rounds
+  *          are unrolled by 8 so that no working variable is moved.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "sha256_util.h"
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+#define SHA256_ROTR(x, n)               (((x) >> (n)) | ((x) << (32U - (n))))
+#define SHA256_CH(x, y, z)              ((z) ^ ((x) & ((y) ^ (z))))
+#define SHA256_MAJ(x, y, z)             (((x) & (y)) | ((z) & ((x) | (y))))
+#define SHA256_SUM0(x)                  (SHA256_ROTR((x), 2U) ^ SHA256_ROTR((x), 13U) ^ SHA256_ROTR((x), 22U))
+#define SHA256_SUM1(x)                  (SHA256_ROTR((x), 6U) ^ SHA256_ROTR((x), 11U) ^ SHA256_ROTR((x), 25U))
+#define SHA256_SIG0(x)                  (SHA256_ROTR((x), 7U) ^ SHA256_ROTR((x), 18U) ^ ((x) >> 3U))
+#define SHA256_SIG1(x)                  (SHA256_ROTR((x), 17U) ^ SHA256_ROTR((x), 19U) ^ ((x) >> 10U))
+
+/* Message word t, computed in place of word t - 16 for rounds 16 to 63 */
+#define SHA256_W(t)                     (((t) < 16U) ? W[(t)] : \
+                                         (W[(t) & 15U] += SHA256_SIG1(W[((t) - 2U) & 15U]) + W[((t) - 7U) & 15U] \
+                                                          + SHA256_SIG0(W[((t) - 15U) & 15U])))
+
+/* One round, the caller rotates the working variables by renaming them */
+#define SHA256_ROUND(a, b, c, d, e, f, g, h, t)                                 \
+  do                                                                            \
+  {                                                                             \
+    uint32_t t1 = (h) + SHA256_SUM1(e) + SHA256_CH((e), (f), (g)) + K[(t)] + SHA256_W(t); \
+    (d) += t1;                                                                  \
+    (h) = t1 + SHA256_SUM0(a) + SHA256_MAJ((a), (b), (c));                      \
+  } while (0)
+
+/* Private variables ---------------------------------------------------------*/
+static const uint32_t K[64] =
+{
+  0x428a2f98U, 0x71374491U, 0xb5c0fbcfU, 0xe9b5dba5U, 0x3956c25bU, 0x59f111f1U, 0x923f82a4U, 0xab1c5ed5U,
+  0xd807aa98U, 0x12835b01U, 0x243185beU, 0x550c7dc3U, 0x72be5d74U, 0x80deb1feU, 0x9bdc06a7U, 0xc19bf174U,
+  0xe49b69c1U, 0xefbe4786U, 0x0fc19dc6U, 0x240ca1ccU, 0x2de92c6fU, 0x4a7484aaU, 0x5cb0a9dcU, 0x76f988daU,
+  0x983e5152U, 0xa831c66dU, 0xb00327c8U, 0xbf597fc7U, 0xc6e00bf3U, 0xd5a79147U, 0x06ca6351U, 0x14292967U,
+  0x27b70a85U, 0x2e1b2138U, 0x4d2c6dfcU, 0x53380d13U, 0x650a7354U, 0x766a0abbU, 0x81c2c92eU, 0x92722c85U,
+  0xa2bfe8a1U, 0xa81a664bU, 0xc24b8b70U, 0xc76c51a3U, 0xd192e819U, 0xd6990624U, 0xf40e3585U, 0x106aa070U,
+  0x19a4c116U, 0x1e376c08U, 0x2748774cU, 0x34b0bcb5U, 0x391c0cb3U, 0x4ed8aa4aU, 0x5b9cca4fU, 0x682e6ff3U,
+  0x748f82eeU, 0x78a5636fU, 0x84c87814U, 0x8cc70208U, 0x90befffaU, 0xa4506cebU, 0xbef9a3f7U, 0xc67178f2U
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static void SHA256_Util_Compress(SHA256_Util_ContextTypeDef *pCtx);
+
+/* Functions Definition ------------------------------------------------------*/
+/**
+  * @brief  Start a new SHA-256 computation.
+  * @param  pCtx: pointer to the SHA-256 context
+  * @retval None.
+  */
+void SHA256_Util_Init(SHA256_Util_ContextTypeDef *pCtx)
+{
+  pCtx->State[0] = 0x6a09e667U;
+  pCtx->State[1] = 0xbb67ae85U;
+  pCtx->State[2] = 0x3c6ef372U;
+  pCtx->State[3] = 0xa54ff53aU;
+  pCtx->State[4] = 0x510e527fU;
+  pCtx->State[5] = 0x9b05688cU;
+  pCtx->State[6] = 0x1f83d9abU;
+  pCtx->State[7] = 0x5be0cd19U;
+  pCtx->Index    = 0U;
+  pCtx->Length   = 0U;
+}
+
+/**
+  * @brief  Feed bytes to the SHA-256 computation.
+  * @param  pCtx: pointer to the SHA-256 context
+  * @param  pData: pointer to the message bytes
+  * @param  Size: number of bytes
+  * @retval None.
+  */
+void SHA256_Util_Update(SHA256_Util_ContextTypeDef *pCtx, const uint8_t *pData, uint32_t Size)
+{
+  uint32_t shift;
+
+  pCtx->Length += Size;
+
+  while (Size > 0U)
+  {
+    /* Whole words when the block is word aligned */
+    if (((pCtx->Index & 3U) == 0U) && (Size >= 4U))
+    {
+      pCtx->Block[pCtx->Index >> 2] = ((uint32_t)pData[0] << 24) | ((uint32_t)pData[1] << 16)
+                                      | ((uint32_t)pData[2] << 8) | (uint32_t)pData[3];
+      pCtx->Index += 4U;
+      pData       += 4U;
+      Size        -= 4U;
+    }
+    else
+    {
+      shift = 24U - ((pCtx->Index & 3U) * 8U);
+
+      if ((pCtx->Index & 3U) == 0U)
+      {
+        pCtx->Block[pCtx->Index >> 2] = 0U;
+      }
+
+      pCtx->Block[pCtx->Index >> 2] |= ((uint32_t)*pData << shift);
+      pCtx->Index++;
+      pData++;
+      Size--;
+    }
+
+    if (pCtx->Index == SHA256_BLOCK_SIZE)
+    {
+      SHA256_Util_Compress(pCtx);
+    }
+  }
+}
+
+/**
+  * @brief  Feed a 32-bit message word, most significant byte first.
+  * @param  pCtx: pointer to the SHA-256 context
+  * @param  Word: message word
+  * @retval None.
+  * @note   Matches the HASH peripheral fed with 32-bit data without swap.
+  */
+void SHA256_Util_UpdateWord(SHA256_Util_ContextTypeDef *pCtx, uint32_t Word)
+{
+  uint8_t bytes[4];
+
+  if ((pCtx->Index & 3U) != 0U)
+  {
+    bytes[0] = (uint8_t)(Word >> 24);
+    bytes[1] = (uint8_t)(Word >> 16);
+    bytes[2] = (uint8_t)(Word >> 8);
+    bytes[3] = (uint8_t)Word;
+    SHA256_Util_Update(pCtx, bytes, 4U);
+    return;
+  }
+
+  pCtx->Block[pCtx->Index >> 2] = Word;
+  pCtx->Index  += 4U;
+  pCtx->Length += 4U;
+
+  if (pCtx->Index == SHA256_BLOCK_SIZE)
+  {
+    SHA256_Util_Compress(pCtx);
+  }
+}
+
+/**
+  * @brief  End the SHA-256 computation.
+  * @param  pCtx: pointer to the SHA-256 context
+  * @param  pDigest: pointer to the 32 bytes digest
+  * @retval None.
+  */
+void SHA256_Util_Final(SHA256_Util_ContextTypeDef *pCtx, uint8_t *pDigest)
+{
+  uint64_t bits = pCtx->Length * 8U;
+  uint8_t pad = 0x80U;
+  uint32_t i;
+
+  /* Append the 1 bit then zeros up to the length field */
+  SHA256_Util_Update(pCtx, &pad, 1U);
+  pad = 0U;
+  while (pCtx->Index != (SHA256_BLOCK_SIZE - 8U))
+  {
+    SHA256_Util_Update(pCtx, &pad, 1U);
+  }
+
+  /* Append the message length in bits */
+  pCtx->Block[14] = (uint32_t)(bits >> 32);
+  pCtx->Block[15] = (uint32_t)bits;
+  SHA256_Util_Compress(pCtx);
+
+  for (i = 0U; i < 8U; i++)
+  {
+    pDigest[(i * 4U)]      = (uint8_t)(pCtx->State[i] >> 24);
+    pDigest[(i * 4U) + 1U] = (uint8_t)(pCtx->State[i] >> 16);
+    pDigest[(i * 4U) + 2U] = (uint8_t)(pCtx->State[i] >> 8);
+    pDigest[(i * 4U) + 3U] = (uint8_t)pCtx->State[i];
+  }
+}
+
+/**
+  * @brief  Process the message block of the context.
+  * @param  pCtx: pointer to the SHA-256 context
+  * @retval None.
+  */
+static void SHA256_Util_Compress(SHA256_Util_ContextTypeDef *pCtx)
+{
+  uint32_t *W = pCtx->Block;
+  uint32_t a = pCtx->State[0];
+  uint32_t b = pCtx->State[1];
+  uint32_t c = pCtx->State[2];
+  uint32_t d = pCtx->State[3];
+  uint32_t e = pCtx->State[4];
+  uint32_t f = pCtx->State[5];
+  uint32_t g = pCtx->State[6];
+  uint32_t h = pCtx->State[7];
+  uint32_t t;
+
+  for (t = 0U; t < 64U; t += 8U)
+  {
+    SHA256_ROUND(a, b, c, d, e, f, g, h, t);
+    SHA256_ROUND(h, a, b, c, d, e, f, g, t + 1U);
+    SHA256_ROUND(g, h, a, b, c, d, e, f, t + 2U);
+    SHA256_ROUND(f, g, h, a, b, c, d, e, t + 3U);
+    SHA256_ROUND(e, f, g, h, a, b, c, d, t + 4U);
+    SHA256_ROUND(d, e, f, g, h, a, b, c, t + 5U);
+    SHA256_ROUND(c, d, e, f, g, h, a, b, t + 6U);
+    SHA256_ROUND(b, c, d, e, f, g, h, a, t + 7U);
+  }
+
+  pCtx->State[0] += a;
+  pCtx->State[1] += b;
+  pCtx->State[2] += c;
+  pCtx->State[3] += d;
+  pCtx->State[4] += e;
+  pCtx->State[5] += f;
+  pCtx->State[6] += g;
+  pCtx->State[7] += h;
+
+  pCtx->Index = 0U;
+}
@@ -38,6 +38,8 @@ typedef enum
 } cli_interface_type;
 
 /* Private define ------------------------------------------------------------*/
+#define CHOICE_MAX_LEN  8U
+
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
@@ -68,10 +70,15 @@ static void print_command_error(void)
 /* Exported functions --------------------------------------------------------*/
 void MainMenu_interface_start(void)
 {
+  char entry[CHOICE_MAX_LEN];
   char choice = 0;
   print_console_header();
-  choice = Serial_Scanf(255);
-  fflush(stdin);
+
+  /* The choice is read as a line, its end of line is not left to the console */
+  if (Serial_GetLine(entry, CHOICE_MAX_LEN) == 1U)
+  {
+    choice = entry[0];
+  }
 
   switch (choice)
   {
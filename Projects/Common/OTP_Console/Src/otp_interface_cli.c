@@ -21,6 +21,7 @@
 #include "otp_interface_cli.h"
 #include "console_util.h"
 #include "otp_util.h"
+#include "crc32_util.h"
 #include <limits.h>
 #include <errno.h>
 #include <stdbool.h>
@@ -37,6 +38,9 @@ typedef enum
   OTP_CMD_DISPL,
   OTP_CMD_WRITE,
   OTP_CMD_LOCK,
+  OTP_CMD_MODE,
+  OTP_CMD_PROFILE,
+  OTP_CMD_STATS,
   OTP_CMD_EXIT,
   OTP_CMD_MAX,
 } otp_cmd_id;
@@ -60,12 +64,17 @@ const otp_command otp_cmd[OTP_CMD_MAX] =
   [OTP_CMD_DISPL]        = { "displ", 0, OTP_VALUE_SIZE },
   [OTP_CMD_WRITE]        = { "write", 2, ((2 * OTP_VALUE_SIZE) + 2)},
   [OTP_CMD_LOCK]         = { "lock", 1, 2 },
+  [OTP_CMD_MODE]         = { "mode", 0, 1 },
+  [OTP_CMD_PROFILE]      = { "profile", 0, 4 },
+  [OTP_CMD_STATS]        = { "stats", 0, 1 },
   [OTP_CMD_EXIT]         = { "exit", 0, 0 }
 };
 
 /* Private define ------------------------------------------------------------*/
 #define CMD_MAX_LEN 1024
 #define CMD_MAX_ARG 255
+#define PROFILE_END_STR       "end"
+#define PROFILE_RECORD_MAX    3U
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 static Otp_TypeDef Otp;
@@ -90,7 +99,14 @@ static void print_command_error(void);
 static void print_outofrange_error(uint32_t num);
 static void write_otp(uint32_t word, uint32_t val, bool lock);
 static void lock_otp(uint32_t word);
-static void print_otp_more_status(Otp_TypeDef Otp, uint32_t word);
+static void print_otp_more_status(const Otp_TypeDef *pOtp, uint32_t word);
+static void print_read_stats(void);
+static void print_mode(int argc, char *argv[]);
+static void print_stats(int argc, char *argv[]);
+static void print_profile(int argc, char *argv[]);
+static int profile_add_record(char *record);
+static int profile_receive_text(void);
+static int profile_receive_bin(uint32_t length, uint32_t crc);
 
 /* Exported variables --------------------------------------------------------*/
 /**
@@ -126,37 +142,53 @@ static void print_help(void)
   printf(" [-y]                      : {Optional} enable auto confirmation\n\r");
   printf(" [word=<id>]               : This field contains the OTP word number in\n\r");
   printf("                             dec/hex/oct format.\n\r");
+  printf("-mode                      : This command allows to display or select the OTP\n\r");
+  printf("                             read mode and the last read timing\n\r");
+  printf(" [shadow|reload]           : {Optional} fast read from the valid shadow\n\r");
+  printf("                             registers or authoritative reload of each fuse\n\r");
+  printf("-profile                   : This command allows to fuse and lock many OTP words\n\r");
+  printf("                             in one pass with a single confirmation. Records\n\r");
+  printf("                             'word=<id> value=<value> [lock]' are pasted one per\n\r");
+  printf("                             line and ended by '%s'\n\r", PROFILE_END_STR);
+  printf(" [-y]                      : {Optional} enable auto confirmation\n\r");
+  printf(" [bin <length> <crc>]      : {Optional} receive instead <length> raw bytes of\n\r");
+  printf("                             {word, value, status} little endian 32-bit records\n\r");
+  printf("                             checked with their CRC-32 <crc>\n\r");
+  printf("-stats                     : This command allows to display the duration of the\n\r");
+  printf("                             OTP operations since the last reset and the\n\r");
+  printf("                             failing OTP words\n\r");
+  printf(" [reset]                   : {Optional} reset the statistics\n\r");
 }
 
 /**
   * @brief print otp status description
-  * @param Otp: otp structure
+  * @param pOtp: pointer to the otp structure
   *      word: otp word
   * @retval None
   */
-static void print_otp_more_status(Otp_TypeDef Otp, uint32_t word)
+static void print_otp_more_status(const Otp_TypeDef *pOtp, uint32_t word)
 {
-  if ((Otp.OtpPart[word] & OTP_READ_ERROR) == OTP_READ_ERROR)
+  if ((pOtp->OtpPart[word] & OTP_READ_ERROR) == OTP_READ_ERROR)
   {
     printf("\n\r                                   |_[00] Invalid");
   }
-  if ((Otp.OtpPart[word] & OTP_LOCK_ERROR) == OTP_LOCK_ERROR)
+  if ((pOtp->OtpPart[word] & OTP_LOCK_ERROR) == OTP_LOCK_ERROR)
   {
     printf("\n\r                                   |_[26] Lock error");
   }
-  if ((Otp.OtpPart[word] & OTP_STICKY_PROG_LOCK_MASK) == OTP_STICKY_PROG_LOCK_MASK)
+  if ((pOtp->OtpPart[word] & OTP_STICKY_PROG_LOCK_MASK) == OTP_STICKY_PROG_LOCK_MASK)
   {
     printf("\n\r                                   |_[27] Sticky programming lock");
   }
-  if ((Otp.OtpPart[word] & OTP_STICKY_WRITE_LOCK_MASK) == OTP_STICKY_WRITE_LOCK_MASK)
+  if ((pOtp->OtpPart[word] & OTP_STICKY_WRITE_LOCK_MASK) == OTP_STICKY_WRITE_LOCK_MASK)
   {
     printf("\n\r                                   |_[28] Shadow write sticky lock");
   }
-  if ((Otp.OtpPart[word] & OTP_STICKY_READ_LOCK_MASK) == OTP_STICKY_READ_LOCK_MASK)
+  if ((pOtp->OtpPart[word] & OTP_STICKY_READ_LOCK_MASK) == OTP_STICKY_READ_LOCK_MASK)
   {
     printf("\n\r                                   |_[29] Shadow read sticky lock");
   }
-  if ((Otp.OtpPart[word] & OTP_PERM_LOCK_MASK) == OTP_PERM_LOCK_MASK)
+  if ((pOtp->OtpPart[word] & OTP_PERM_LOCK_MASK) == OTP_PERM_LOCK_MASK)
   {
     printf("\n\r                                   |_[30] Permanent programming lock");
   }
@@ -173,12 +205,6 @@ static void print_displ(int argc, char *argv[])
   errno = 0;
   once = true;
 
-  /* Read otp */
-  Otp = OTP_Util_Read();
-
-#ifdef USE_HASH_OVER_OTP
-  HASH_Util_calculate(&Otp);
-#endif /* USE_HASH_OVER_OTP */
   /* In case of specific otp words display */
   if (argc >= 2)
   {
@@ -204,8 +230,8 @@ static void print_displ(int argc, char *argv[])
             print_command_error();
           }
 
-          /* if value is in otp word range */
-          if ((val >= 0) && (val <= OTP_VALUE_SIZE))
+          /* if value is in otp word range, read only this otp word */
+          if ((val < OTP_VALUE_SIZE) && (OTP_Util_ReadRange(val, 1U, &Otp) == OTP_OK))
           {
             /* print this once */
             if (once)
@@ -218,7 +244,7 @@ static void print_displ(int argc, char *argv[])
             printf("\n\r---------------------------------------------------------------------");
             printf("\n\r    %02ld    |    0x%08lX    |    0x%08lX    ", val, Otp.OtpPart[val * 2], Otp.OtpPart[val * 2 + 1]);
             /* print otp status description */
-            print_otp_more_status(Otp, val * 2 + 1);
+            print_otp_more_status(&Otp, val * 2 + 1);
           }
           else /* if value is out of otp word range */
           {
@@ -237,6 +263,12 @@ static void print_displ(int argc, char *argv[])
   }
   else /* In case of all otp display */
   {
+    /* Read otp */
+    OTP_Util_Read(&Otp);
+
+#ifdef USE_HASH_OVER_OTP
+    HASH_Util_calculate(&Otp);
+#endif /* USE_HASH_OVER_OTP */
     printf("\n\rOTP GLOBAL STATE");
     if (Otp.GlobalState == BSEC_SEC_OTP_OPEN)
     {
@@ -269,10 +301,109 @@ static void print_displ(int argc, char *argv[])
     {
       printf("\n\r    %02lu    |    0x%08lX    |    0x%08lX    ", (idx / 2), Otp.OtpPart[idx], Otp.OtpPart[idx + 1]);
       /* print otp status description */
-      print_otp_more_status(Otp, idx + 1);
+      print_otp_more_status(&Otp, idx + 1);
     }
     printf("\n\r---------------------------------------------------------------------\n\r");
+    print_read_stats();
+  }
+}
+
+/**
+  * @brief print the counters of the last otp read
+  * @param None
+  * @retval None
+  */
+static void print_read_stats(void)
+{
+  Otp_ReadStatsTypeDef stats;
+
+  OTP_Util_GetReadStats(&stats);
+
+  printf("Read mode: %s, %lu shadowed, %lu reloaded, %lu ms\n\r",
+         (OTP_Util_GetReadMode() == OTP_READ_SHADOW) ? "shadow" : "reload",
+         stats.ShadowCount, stats.ReloadCount, stats.Ticks);
+}
+
+/**
+  * @brief display or select the otp read mode
+  * @param argc:
+  *      argv:
+  * @retval None
+  */
+static void print_mode(int argc, char *argv[])
+{
+  if (argc >= 2)
+  {
+    if (!strcmp(argv[0], "shadow"))
+    {
+      OTP_Util_SetReadMode(OTP_READ_SHADOW);
+    }
+    else if (!strcmp(argv[0], "reload"))
+    {
+      OTP_Util_SetReadMode(OTP_READ_RELOAD);
+    }
+    else
+    {
+      /* print command error message */
+      print_command_error();
+      return;
+    }
+  }
+
+  print_read_stats();
+}
+
+/**
+  * @brief display or reset the otp programming statistics
+  * @param argc:
+  *      argv:
+  * @retval None
+  */
+static void print_stats(int argc, char *argv[])
+{
+  static const char *const op_str[OTP_OP_NUMBER] = { "program", "sticky lock", "perm lock", "read" };
+  Otp_ProgStatsTypeDef stats;
+  uint32_t op;
+  uint32_t i;
+
+  if (argc >= 2)
+  {
+    if (!strcmp(argv[0], "reset"))
+    {
+      OTP_Util_ResetProgStats();
+    }
+    else
+    {
+      /* print command error message */
+      print_command_error();
+      return;
+    }
+  }
+
+  OTP_Util_GetProgStats(&stats);
+
+  printf("Operation   |   Count |  Min us |  Avg us |  Max us |  Errors | Timeouts\n\r");
+  printf("---------------------------------------------------------------------\n\r");
+  for (op = 0; op < OTP_OP_NUMBER; op++)
+  {
+    printf("%-11s | %7lu | %7lu | %7lu | %7lu | %7lu | %7lu\n\r", op_str[op], stats.Op[op].Count,
+           stats.Op[op].Min, (stats.Op[op].Count != 0U) ? (stats.Op[op].Total / stats.Op[op].Count) : 0U,
+           stats.Op[op].Max, stats.Op[op].Errors, stats.Op[op].Timeouts);
+  }
+  printf("---------------------------------------------------------------------\n\r");
+
+  if (stats.FailCount == 0U)
+  {
+    printf("No failing OTP word\n\r");
+    return;
   }
+
+  printf("Failing OTP words (%lu):", stats.FailCount);
+  for (i = 0; (i < stats.FailCount) && (i < OTP_PROG_FAIL_MAX); i++)
+  {
+    printf(" %lu", stats.FailWord[i]);
+  }
+  printf("\n\r");
 }
 
 /**
@@ -308,24 +439,8 @@ static void print_outofrange_error(uint32_t num)
   */
 static void write_otp(uint32_t word, uint32_t val, bool lock)
 {
-  /* Read the otp */
-  Otp = OTP_Util_Read();
-
-  /* Change the otp value */
-  Otp.OtpPart[word * 2] = val;
-
-  /* if lock is enabled */
-  if (lock)
-  {
-    /* lock the otp */
-    Otp.OtpPart[word * 2 + 1] |= OTP_PERM_LOCK_MASK;
-  }
-
-  /* Apply the change */
-  Otp.OtpPart[word * 2 + 1] |= OTP_REQUEST_UPDATE_MASK;
-
-  /* Write the otp */
-  if (!OTP_Util_Write(Otp))
+  /* Write only this otp word, with the permanent lock if enabled */
+  if (!OTP_Util_WriteWord(word, val, lock ? OTP_PERM_LOCK_MASK : 0U))
   {
     /* In case of success */
     printf("\n\rSUCCESS\n\r");
@@ -344,17 +459,9 @@ static void write_otp(uint32_t word, uint32_t val, bool lock)
   */
 static void lock_otp(uint32_t word)
 {
-  /* Read the otp */
-  Otp = OTP_Util_Read();
-
-  /* Lock the otp */
-  Otp.OtpPart[word * 2 + 1] |= OTP_PERM_LOCK_MASK;
-
-  /* Apply the change */
-  Otp.OtpPart[word * 2 + 1] |= OTP_REQUEST_UPDATE_MASK;
-
-  /* Write the otp */
-  if (!OTP_Util_Write(Otp))
+  /* Read only this otp word, then lock it keeping its current value */
+  if ((OTP_Util_ReadRange(word, 1U, &Otp) == OTP_OK) &&
+      (!OTP_Util_WriteWord(word, Otp.OtpPart[word * 2], OTP_PERM_LOCK_MASK)))
   {
     /* In case of success */
     printf("\n\rSUCCESS\n\r");
@@ -604,12 +711,9 @@ static void print_lock(int argc, char *argv[])
         print_command_error();
       }
 
-      /* if value is in otp word range */
-      if ((val >= 0) && (val <= OTP_VALUE_SIZE))
+      /* if value is in otp word range, read only this otp word */
+      if ((val < OTP_VALUE_SIZE) && (OTP_Util_ReadRange(val, 1U, &Otp) == OTP_OK))
       {
-        /* Read the otp */
-        Otp = OTP_Util_Read();
-
         printf("OTP Lock command:");
         printf("\n\rYou are trying to lock some OTP words with the following inputs:");
         printf("\n\r--------------------------");
@@ -670,6 +774,291 @@ static void print_lock(int argc, char *argv[])
   }
 }
 
+/**
+  * @brief add a text record of the profile to the otp cache
+  * @param record: "word=<id> value=<value> [lock]" string
+  * @retval OTP_OK: if the record is valid
+  *         other: if the record is not valid
+  */
+static int profile_add_record(char *record)
+{
+  char *token[PROFILE_RECORD_MAX];
+  char *str;
+  uint32_t count = 0U;
+  uint32_t word;
+  uint32_t value;
+  uint32_t stat = 0U;
+
+  /* split the record on spaces */
+  for (str = strtok(record, " "); str != NULL; str = strtok(NULL, " "))
+  {
+    if (count >= PROFILE_RECORD_MAX)
+    {
+      return OTP_ERROR;
+    }
+    token[count++] = str;
+  }
+
+  if ((count < 2U) || strncmp(token[0], "word=", 5) || strncmp(token[1], "value=", 6))
+  {
+    return OTP_ERROR;
+  }
+
+  /* if the permanent lock is requested */
+  if (count == 3U)
+  {
+    if (strcmp(token[2], "lock"))
+    {
+      return OTP_ERROR;
+    }
+    stat = OTP_PERM_LOCK_MASK;
+  }
+
+  errno = 0;
+  word = strtoul(&token[0][5], &end_ptr, 0);
+  if ((end_ptr == &token[0][5]) || (*end_ptr != '\0') || (errno == ERANGE))
+  {
+    return OTP_ERROR;
+  }
+
+  value = strtoul(&token[1][6], &end_ptr, 0);
+  if ((end_ptr == &token[1][6]) || (*end_ptr != '\0') || (errno == ERANGE))
+  {
+    return OTP_ERROR;
+  }
+
+  /* the cache rejects out of range words */
+  return OTP_Util_CacheSet(word, value, stat);
+}
+
+/**
+  * @brief get the pasted text profile, until its end line
+  * @param None
+  * @retval OTP_OK: if all the records are valid
+  *         other: if a record is not valid
+  */
+static int profile_receive_text(void)
+{
+  uint32_t line = 0U;
+  int ret = OTP_OK;
+
+  printf("Paste the profile, one 'word=<id> value=<value> [lock]' record per line,\n\r");
+  printf("end with '%s'\n\r", PROFILE_END_STR);
+
+  while (true)
+  {
+    /* Get the user entry */
+    get_entry_string(entry);
+
+    if (!strcmp(entry, PROFILE_END_STR))
+    {
+      break;
+    }
+
+    /* ignore empty lines */
+    if (entry[0] == '\0')
+    {
+      continue;
+    }
+
+    line++;
+
+    /* keep reading up to the end line so that no record is taken as a command */
+    if (profile_add_record(entry) != OTP_OK)
+    {
+      printf("Error: invalid record at line %lu\n\r", line);
+      ret = OTP_ERROR;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief get the binary profile
+  * @param length: number of bytes of the profile
+  *      crc: CRC-32 of the profile
+  * @retval OTP_OK: if the profile is valid
+  *         other: if the profile is not valid
+  */
+static int profile_receive_bin(uint32_t length, uint32_t crc)
+{
+  uint8_t record[OTP_DELTA_ENTRY_SIZE];
+  uint32_t running_crc = 0U;
+  uint32_t word;
+  uint32_t value;
+  uint32_t stat;
+  uint32_t i;
+  int ret = OTP_OK;
+
+  /* records have the otp delta entry layout */
+  if ((length == 0U) || ((length % OTP_DELTA_ENTRY_SIZE) != 0U)
+      || (length > (OTP_VALUE_SIZE * OTP_DELTA_ENTRY_SIZE)))
+  {
+    return OTP_ERROR;
+  }
+
+  printf("Send the %lu bytes of the profile\n\r", length);
+
+  while (length > 0U)
+  {
+    for (i = 0U; i < OTP_DELTA_ENTRY_SIZE; i++)
+    {
+      record[i] = (uint8_t)Serial_Scanf(255);
+    }
+    length -= OTP_DELTA_ENTRY_SIZE;
+
+    running_crc = CRC32_Util_Compute(running_crc, record, OTP_DELTA_ENTRY_SIZE);
+
+    word  = (uint32_t)record[0] | ((uint32_t)record[1] << 8) | ((uint32_t)record[2] << 16) | ((uint32_t)record[3] << 24);
+    value = (uint32_t)record[4] | ((uint32_t)record[5] << 8) | ((uint32_t)record[6] << 16) | ((uint32_t)record[7] << 24);
+    stat  = (uint32_t)record[8] | ((uint32_t)record[9] << 8) | ((uint32_t)record[10] << 16) | ((uint32_t)record[11] << 24);
+
+    /* keep receiving up to the end of the profile */
+    if (OTP_Util_CacheSet(word, value, stat) != OTP_OK)
+    {
+      ret = OTP_ERROR;
+    }
+  }
+
+  if (running_crc != crc)
+  {
+    printf("Error: CRC-32 0x%08lX does not match 0x%08lX\n\r", running_crc, crc);
+    ret = OTP_ERROR;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief get an otp profile, check it against the fuses and program it
+  * @param argc:
+  *      argv:
+  * @retval None
+  */
+static void print_profile(int argc, char *argv[])
+{
+  Otp_PlanTypeDef plan;
+  uint32_t length;
+  uint32_t crc;
+  int ret;
+
+  auto_conf = false;
+  prev_opt_cmd = 0;
+  errno = 0;
+
+  /* if auto confirmation is enabled */
+  if ((argc >= 2) && !strcmp(argv[0], "-y"))
+  {
+    auto_conf = true;
+    prev_opt_cmd++;
+    printf("Warning: Auto confirmation is enabled.\n\r");
+  }
+
+  OTP_Util_CacheReset();
+
+  /* if the profile is a binary one */
+  if (((argc - 1 - prev_opt_cmd) == 3) && !strcmp(argv[prev_opt_cmd], "bin"))
+  {
+    length = strtoul(argv[prev_opt_cmd + 1], &end_ptr, 0);
+    if ((end_ptr == argv[prev_opt_cmd + 1]) || (*end_ptr != '\0'))
+    {
+      print_command_error();
+      return;
+    }
+
+    crc = strtoul(argv[prev_opt_cmd + 2], &end_ptr, 0);
+    if ((end_ptr == argv[prev_opt_cmd + 2]) || (*end_ptr != '\0') || (errno == ERANGE))
+    {
+      print_command_error();
+      return;
+    }
+
+    ret = profile_receive_bin(length, crc);
+  }
+  else if ((argc - 1 - prev_opt_cmd) == 0)
+  {
+    ret = profile_receive_text();
+  }
+  else
+  {
+    /* print command error message */
+    print_command_error();
+    return;
+  }
+
+  if (ret != OTP_OK)
+  {
+    OTP_Util_CacheReset();
+    printf("Error: invalid profile, no OTP word is programmed\n\r");
+    return;
+  }
+
+  /* Check the whole profile against the fuses before any programming */
+  if (OTP_Util_CacheDiff(&plan) != OTP_OK)
+  {
+    OTP_Util_CacheReset();
+    printf("Error: %lu word(s) cannot reach the requested value or lock (first: %lu),\n\r",
+           plan.ErrorCount, plan.FirstError);
+    printf("no OTP word is programmed\n\r");
+    return;
+  }
+
+  printf("\n\rOTP Profile command:");
+  printf("\n\rYou are trying to program OTP with the following profile:");
+  printf("\n\r--------------------------");
+  printf("\n\r Program  |  %lu word(s)", plan.ProgramCount);
+  printf("\n\r Lock     |  %lu word(s)", plan.LockCount);
+  printf("\n\r Skip     |  %lu word(s)", plan.SkipCount);
+  printf("\n\r--------------------------");
+
+  if ((plan.ProgramCount == 0U) && (plan.LockCount == 0U))
+  {
+    OTP_Util_CacheReset();
+    printf("\n\rThe OTP words are already in the requested state\n\r");
+    return;
+  }
+
+  printf("\n\rWarning: This operation cannot be reverted and may brick your device.");
+
+  /* if auto confirmation is not enabled */
+  if (!auto_conf)
+  {
+    printf("\n\rWarning: Do you confirm?  [y/n]\n\r");
+    /* Get the user entry */
+    get_entry_string(entry);
+
+    /* while the entry is not the expected one */
+    while ((entry[0] != 'y') && (entry[0] != 'Y') && (entry[0] != 'n') && (entry[0] != 'N'))
+    {
+      printf("Error: type 'y' or 'Y' for yes and type 'n' or 'N' for no\n\r");
+      /* Get the user entry */
+      get_entry_string(entry);
+    }
+
+    /* if entry is no */
+    if ((entry[0] == 'n') || (entry[0] == 'N'))
+    {
+      OTP_Util_CacheReset();
+      printf("Warning: The operation was cancelled...\n\r");
+      return;
+    }
+    printf("The operation was confirmed...");
+  }
+
+  /* Program all the words of the profile in one pass */
+  if (OTP_Util_CacheApply(&plan) == OTP_OK)
+  {
+    /* In case of success */
+    printf("\n\rSUCCESS\n\r");
+  }
+  else
+  {
+    /* In case of failure */
+    printf("\n\rFAIL (word %lu)\n\r", plan.FirstError);
+  }
+}
+
 
 static bool print_exit(int argc, char *argv[])
 {
@@ -700,10 +1089,6 @@ static void free_args(int argc, char *argv[])
   */
 static void get_entry_string(char *entry)
 {
-  uint8_t user_entry_valid = 0;
-  char user_entry_value = 0;
-  int i = 0;
-
 #ifndef __TERMINAL_IO__
   Serial_Putchar(0xd);
   Serial_Putchar('U');
@@ -715,42 +1100,8 @@ static void get_entry_string(char *entry)
   printf("\rUser>\n\r");
 #endif
 
-  while (user_entry_valid == 0)
-  {
-    /* Scan for user entry */
-    user_entry_value = Serial_Scanf(255);
-
-#ifndef __TERMINAL_IO__
-    /* Print the entry character */
-    Serial_Putchar(user_entry_value);
-
-    /* if carriage return is detected */
-    if (user_entry_value == 0xd)
-    {
-      entry[i] = '\0';
-      printf("\r\n");
-      user_entry_valid = 1;
-    }
-    /* if cancel or delete is detected */
-    else if (user_entry_value == 0x18 || user_entry_value == 0x7f)
-    {
-      i--;
-    }
-#else
-    /* if new line is detected */
-    if ((user_entry_value == 0xa) || (user_entry_value == 0xd))
-    {
-      entry[i] = '\0';
-      printf("\r\n");
-      user_entry_valid = 1;
-      fflush(stdin);
-    }
-#endif
-    else /* if user keep writing */
-    {
-      entry[i++] = user_entry_value;
-    }
-  }
+  /* Echo, line editing and length bound are handled by the line discipline */
+  (void)Serial_GetLine(entry, CMD_MAX_LEN);
 }
 
 /**
@@ -873,6 +1224,9 @@ void otp_print_header(void)
   /* Output a message on Hyperterminal using printf function */
   printf("\n\r=============== OTP Serial Interface ===============\r");
   printf("\n\rTarget: %s \r", MX_MODEL);
+#if defined(USE_OTP_EMULATION)
+  printf("\n\rWarning: OTP emulation, no fuse is programmed\r");
+#endif /* USE_OTP_EMULATION */
   printf("\n\rPrint 'help' to see OTP commands\n\r");
 }
 
@@ -923,6 +1277,18 @@ bool otp_commands_interactive(void)
       print_lock(argc, argv);
       break;
 
+    case OTP_CMD_MODE:
+      print_mode(argc, argv);
+      break;
+
+    case OTP_CMD_PROFILE:
+      print_profile(argc, argv);
+      break;
+
+    case OTP_CMD_STATS:
+      print_stats(argc, argv);
+      break;
+
     case OTP_CMD_EXIT:
     	ret = print_exit(argc, argv); /* return console control to main console*/
       break;
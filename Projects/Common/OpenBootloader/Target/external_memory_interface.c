@@ -56,6 +56,7 @@ OPENBL_MemoryTypeDef EXTERNAL_MEMORY_Descriptor =
   EXTERNAL_MEMORY_AREA,
   OPENBL_ExtMem_Init,
   OPENBL_ExtMem_Read,
+  OPENBL_ExtMem_ReadBlock,
   OPENBL_ExtMem_Write,
   OPENBL_ExtMem_JumpToAddress,
   OPENBL_ExtMem_MassErase,
@@ -101,6 +102,28 @@ uint8_t OPENBL_ExtMem_Read(uint32_t Address)
     }
 }
 
+/**
+  * @brief  This function is used to read a block of data from external memory.
+  * @param  Address The address where the data will be read.
+  * @param  Data Pointer to the buffer receiving the data.
+  * @param  DataLength The length of the data to be read.
+  * @retval None.
+  */
+void OPENBL_ExtMem_ReadBlock(uint32_t Address, uint8_t *Data, uint32_t DataLength)
+{
+  /* Check if the External memory has a Read function or not  */
+  if (NULL != Read)
+  {
+    if (function_is_in_RAM((uint32_t)Read))
+      Read(Address, DataLength, Data);
+  }
+  else
+  {
+    /* External memory is memory mapped */
+    memcpy(Data, (uint8_t *)Address, DataLength);
+  }
+}
+
 /**
   * @brief  This function is used to write data in external memory.
   * @param  Address The address where that data will be written.
@@ -43,6 +43,7 @@ struct StorageInfo
 /* Exported functions ------------------------------------------------------- */
 void OPENBL_ExtMem_Init(uint32_t Address);
 uint8_t OPENBL_ExtMem_Read(uint32_t Address);
+void OPENBL_ExtMem_ReadBlock(uint32_t Address, uint8_t *Data, uint32_t DataLength);
 void OPENBL_ExtMem_Write(uint32_t Address, uint8_t *Data, uint32_t DataLength);
 uint64_t OPENBL_ExtMem_Verify(uint32_t Address, uint32_t DataAddr, uint32_t DataLength, uint32_t missalignement);
 void OPENBL_ExtMem_JumpToAddress(uint32_t Address);
@@ -83,6 +83,10 @@
 #define SECTOR_SIZE                       0x1000     /* (pStorageInfo->sectors[0].SectorSize) */
 #define SECTOR_MAX_NUMBER                 0x4000     /* (pStorageInfo->sectors[0].SectorNum) */
 
+/* Typical erase durations in ms, used to choose between sector and chip erase */
+#define SECTOR_ERASE_TIME                 30U
+#define CHIP_ERASE_TIME                   150000U
+
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
 
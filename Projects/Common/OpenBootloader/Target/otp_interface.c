@@ -28,10 +28,18 @@
 #endif /* USE_HASH_OVER_OTP */
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+#define OTP_IMAGE_RECORD_SIZE           8U     /* Version and global state, or otp value and status */
+#define OTP_IMAGE_SIZE                  ((uint32_t)sizeof(OPENBL_Otp_TypeDef))
+#define OTP_STATS_SIZE                  (OTP_STATS_RECORD_SIZE * 4U)
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+static OPENBL_Otp_TypeDef otp_image;
+static uint8_t otp_image_record[OTP_IMAGE_RECORD_SIZE];
+static int otp_image_status = OTP_OK;
+static uint32_t otp_image_stats[OTP_STATS_RECORD_SIZE];
 /* Exported variables --------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
+static void OPENBL_OTP_ProgramRecord(uint32_t Index, const uint32_t *pRecord);
 /**
   * @brief Init the otp
   * @param None
@@ -54,35 +62,414 @@ void OPENBL_OTP_DeInit(void)
 
 /**
   * @brief Write the otp
-  * @param Otp: the otp structure
+  * @param pOtp: pointer to the otp structure
   * @retval OTP_OK: if no error
   *         other: if error
   */
-int OPENBL_OTP_Write(OPENBL_Otp_TypeDef Otp)
+int OPENBL_OTP_Write(const OPENBL_Otp_TypeDef *pOtp)
 {
-  int ret = OTP_Util_Write(Otp);
+  int ret = OTP_Util_Write(pOtp);
   return ret;
 }
 
 
 /**
   * @brief Read the otp
-  * @param None
-  * @retval Otp: the otp structure
+  * @param pOtp: pointer to the otp structure filled in place
+  * @retval None
+  */
+void OPENBL_OTP_Read(OPENBL_Otp_TypeDef *pOtp)
+{
+  OTP_Util_Read(pOtp);
+}
+
+/**
+  * @brief Read the otp version and global state
+  * @param pOtp: pointer to the otp structure filled in place
+  * @retval None
+  */
+void OPENBL_OTP_ReadState(OPENBL_Otp_TypeDef *pOtp)
+{
+  OTP_Util_ReadState(pOtp);
+}
+
+/**
+  * @brief Read a range of otp words
+  * @param first: first otp word number
+  * @param count: number of otp words
+  * @param pOtp: pointer to the otp structure updated in place
+  * @retval OTP_OK: if no error
+  *         other: if error
   */
-OPENBL_Otp_TypeDef OPENBL_OTP_Read(void)
+int OPENBL_OTP_ReadRange(uint32_t first, uint32_t count, OPENBL_Otp_TypeDef *pOtp)
 {
-  OPENBL_Otp_TypeDef ret = OTP_Util_Read();
+  int ret = OTP_Util_ReadRange(first, count, pOtp);
   return ret;
 }
+
+/**
+  * @brief Apply an otp programming statistics record
+  * @param pRecord: pointer to the received otp block
+  * @param Length: size of the received block
+  * @retval OTP_OK: if the block is a statistics record, the statistics are then reset
+  *         other: if the block is an otp structure
+  *
+  * The record is sent in place of the otp structure: the "SOS1" magic word.
+  */
+int OPENBL_OTP_StatsRecord(const uint8_t *pRecord, uint32_t Length)
+{
+  uint32_t magic;
+
+  if (Length < 4U)
+  {
+    return OTP_ERROR;
+  }
+
+  magic = ((uint32_t)pRecord[3] << 24) | ((uint32_t)pRecord[2] << 16) | ((uint32_t)pRecord[1] << 8) | (uint32_t)pRecord[0];
+
+  if (magic != OTP_STATS_MAGIC)
+  {
+    return OTP_ERROR;
+  }
+
+  OTP_Util_ResetProgStats();
+
+  return OTP_OK;
+}
+
+/**
+  * @brief Get the otp programming statistics record
+  * @param pRecord: pointer to the OTP_STATS_RECORD_SIZE words of the record
+  * @retval None
+  *
+  * The record is sent after the otp image: the "SOS1" magic word, then for
+  * the program, sticky lock, permanent lock and read operations their number,
+  * min, average and max durations in us, errors and timeouts numbers, then the
+  * failing fuses number and the first failing fuses.
+  */
+void OPENBL_OTP_GetStats(uint32_t *pRecord)
+{
+  Otp_ProgStatsTypeDef stats;
+  uint32_t op;
+  uint32_t idx;
+
+  OTP_Util_GetProgStats(&stats);
+
+  *pRecord++ = OTP_STATS_MAGIC;
+
+  for (op = 0U; op < OTP_OP_NUMBER; op++)
+  {
+    *pRecord++ = stats.Op[op].Count;
+    *pRecord++ = stats.Op[op].Min;
+    *pRecord++ = (stats.Op[op].Count != 0U) ? (stats.Op[op].Total / stats.Op[op].Count) : 0U;
+    *pRecord++ = stats.Op[op].Max;
+    *pRecord++ = stats.Op[op].Errors;
+    *pRecord++ = stats.Op[op].Timeouts;
+  }
+
+  *pRecord++ = stats.FailCount;
+
+  for (idx = 0U; idx < OTP_PROG_FAIL_MAX; idx++)
+  {
+    *pRecord++ = (idx < stats.FailCount) ? stats.FailWord[idx] : 0U;
+  }
+}
+
+/**
+  * @brief Apply an otp read mode record
+  * @param pRecord: pointer to the received otp block
+  * @param Length: size of the received block
+  * @retval OTP_OK: if the block is a read mode record, it is then applied
+  *         other: if the block is an otp structure
+  *
+  * The record is sent in place of the otp structure: the "SOM1" magic word
+  * followed by the read mode word, OTP_READ_SHADOW for fast reads from the
+  * shadow registers or OTP_READ_RELOAD for authoritative reads.
+  */
+int OPENBL_OTP_ReadModeRecord(const uint8_t *pRecord, uint32_t Length)
+{
+  uint32_t magic;
+  uint32_t mode;
+
+  if (Length < 8U)
+  {
+    return OTP_ERROR;
+  }
+
+  magic = ((uint32_t)pRecord[3] << 24) | ((uint32_t)pRecord[2] << 16) | ((uint32_t)pRecord[1] << 8) | (uint32_t)pRecord[0];
+  mode  = ((uint32_t)pRecord[7] << 24) | ((uint32_t)pRecord[6] << 16) | ((uint32_t)pRecord[5] << 8) | (uint32_t)pRecord[4];
+
+  if (magic != OTP_READ_MODE_MAGIC)
+  {
+    return OTP_ERROR;
+  }
+
+  OTP_Util_SetReadMode(mode);
+
+  return OTP_OK;
+}
+
+/**
+  * @brief Apply an otp delta record
+  * @param pRecord: pointer to the received otp block
+  * @param Length: size of the received block
+  * @retval OTP_OK: if the delta is cached, or programmed on commit
+  *         OTP_RECORD_INVALID: if the delta is malformed
+  *         OTP_ERROR: if the delta cannot be programmed
+  *         OTP_RECORD_NONE: if the block is not a delta record
+  *
+  * The record is sent in place of the otp structure: the "SOD1" magic word,
+  * a flags word, the entries number then for each entry the otp word
+  * number, its value and its status word carrying the requested lock bits.
+  * Entries are cached until a record with the OTP_DELTA_COMMIT flag, the
+  * whole plan is then checked against the fuses before any programming.
+  */
+int OPENBL_OTP_DeltaRecord(const uint8_t *pRecord, uint32_t Length)
+{
+  uint32_t record[3];
+  uint32_t flags;
+  uint32_t entries;
+  uint32_t index;
+  uint32_t offset;
+  Otp_PlanTypeDef plan;
+
+  if (Length < OTP_DELTA_HEADER_SIZE)
+  {
+    return OTP_RECORD_NONE;
+  }
+
+  memcpy(record, pRecord, OTP_DELTA_HEADER_SIZE);
+
+  if (record[0] != OTP_DELTA_MAGIC)
+  {
+    return OTP_RECORD_NONE;
+  }
+
+  flags   = record[1];
+  entries = record[2];
+
+  if (entries > ((Length - OTP_DELTA_HEADER_SIZE) / OTP_DELTA_ENTRY_SIZE))
+  {
+    OTP_Util_CacheReset();
+    return OTP_RECORD_INVALID;
+  }
+
+  for (index = 0U, offset = OTP_DELTA_HEADER_SIZE; index < entries; index++, offset += OTP_DELTA_ENTRY_SIZE)
+  {
+    memcpy(record, &pRecord[offset], OTP_DELTA_ENTRY_SIZE);
+
+    if (OTP_Util_CacheSet(record[0], record[1], record[2]) != OTP_OK)
+    {
+      OTP_Util_CacheReset();
+      return OTP_RECORD_INVALID;
+    }
+  }
+
+  if ((flags & OTP_DELTA_COMMIT) != 0U)
+  {
+    return OTP_Util_CacheApply(&plan);
+  }
+
+  return OTP_OK;
+}
+
+/**
+  * @brief Program a block of the otp image
+  * @param Offset: offset of the block in the otp image
+  * @param pData: pointer to the block
+  * @param Length: size of the block, any size is supported
+  * @retval OTP_OK: if no error since the start of the image
+  *         other: if an otp word programming failed
+  *
+  * The otp image is the otp structure: version and global state, then a
+  * value and a status word for each otp word. Each otp word is programmed
+  * as soon as its value and status are received, if its status requests
+  * an update; a record split between two blocks is kept until completed.
+  */
+int OPENBL_OTP_WriteImage(uint32_t Offset, const uint8_t *pData, uint32_t Length)
+{
+  uint32_t record[OTP_IMAGE_RECORD_SIZE / 4U];
+  uint32_t position;
+  uint32_t size;
+
+  /* Start of a new otp image */
+  if (Offset == 0U)
+  {
+    otp_image_status = OTP_OK;
+  }
+
+  while (Length > 0U)
+  {
+    position = Offset % OTP_IMAGE_RECORD_SIZE;
+    size = OTP_IMAGE_RECORD_SIZE - position;
+
+    if (size > Length)
+    {
+      size = Length;
+    }
+
+    if (size == OTP_IMAGE_RECORD_SIZE)
+    {
+      /* Whole record in the block, the words are little endian as the core */
+      memcpy(record, pData, OTP_IMAGE_RECORD_SIZE);
+      OPENBL_OTP_ProgramRecord(Offset / OTP_IMAGE_RECORD_SIZE, record);
+    }
+    else
+    {
+      /* Record split between blocks */
+      memcpy(&otp_image_record[position], pData, size);
+
+      if ((position + size) == OTP_IMAGE_RECORD_SIZE)
+      {
+        memcpy(record, otp_image_record, OTP_IMAGE_RECORD_SIZE);
+        OPENBL_OTP_ProgramRecord(Offset / OTP_IMAGE_RECORD_SIZE, record);
+      }
+    }
+
+    Offset += size;
+    pData  += size;
+    Length -= size;
+  }
+
+  return otp_image_status;
+}
+
+/**
+  * @brief Read a block of the otp image
+  * @param Offset: offset of the block in the otp image
+  * @param pData: pointer to the block
+  * @param Length: size of the block, any size is supported
+  * @retval Number of otp image and statistics bytes in the block, the rest is filled with 0
+  *
+  * The otp state, and the hash if enabled, are read at the start of the
+  * image, then only the otp words of the block are read.
+  */
+uint32_t OPENBL_OTP_ReadImage(uint32_t Offset, uint8_t *pData, uint32_t Length)
+{
+  uint32_t size = 0U;
+  uint32_t start;
+  uint32_t dest;
+  uint32_t first;
+  uint32_t last;
+
+  /* Start of the otp image */
+  if (Offset == 0U)
+  {
+    /* Statistics of the operations done before this read */
+    OPENBL_OTP_GetStats(otp_image_stats);
+
+    OTP_Util_ReadState(&otp_image);
+
+#ifdef USE_HASH_OVER_OTP
+    /* Calculate Hash over OTP values only once */
+    OPENBL_Hash_Calculate(&otp_image);
+#endif /* USE_HASH_OVER_OTP */
+  }
+
+  if (Offset < OTP_IMAGE_SIZE)
+  {
+    size = OTP_IMAGE_SIZE - Offset;
+
+    if (size > Length)
+    {
+      size = Length;
+    }
+
+    /* Otp words covered by the block, the first record is the otp state */
+    first = Offset / OTP_IMAGE_RECORD_SIZE;
+    last  = (Offset + size + OTP_IMAGE_RECORD_SIZE - 1U) / OTP_IMAGE_RECORD_SIZE;
+
+    if (first == 0U)
+    {
+      first = 1U;
+    }
+
+    /* The hash follows the otp words */
+    if (last > (OTP_VALUE_SIZE + 1U))
+    {
+      last = OTP_VALUE_SIZE + 1U;
+    }
+
+    if (last > first)
+    {
+      (void)OTP_Util_ReadRange(first - 1U, last - first, &otp_image);
+    }
+
+    /* The otp structure is the image, the words are little endian as the core */
+    memcpy(pData, ((const uint8_t *)&otp_image) + Offset, size);
+  }
+
+  memset(&pData[size], 0, Length - size);
+
+  /* Otp programming statistics record follows the otp image */
+  if ((Offset + Length) > OTP_IMAGE_SIZE)
+  {
+    start = (Offset > OTP_IMAGE_SIZE) ? (Offset - OTP_IMAGE_SIZE) : 0U;
+    dest  = (Offset > OTP_IMAGE_SIZE) ? 0U : (OTP_IMAGE_SIZE - Offset);
+
+    if (start < OTP_STATS_SIZE)
+    {
+      size = OTP_STATS_SIZE - start;
+
+      if (size > (Length - dest))
+      {
+        size = Length - dest;
+      }
+
+      memcpy(&pData[dest], ((const uint8_t *)otp_image_stats) + start, size);
+      size += dest;
+    }
+  }
+
+  return size;
+}
+
+/**
+  * @brief Program an otp word received in the otp image
+  * @param Index: record number in the otp image
+  * @param pRecord: pointer to the otp value and status
+  * @retval None
+  */
+static void OPENBL_OTP_ProgramRecord(uint32_t Index, const uint32_t *pRecord)
+{
+  /* Otp state record and hash are not programmed */
+  if ((Index == 0U) || (Index > OTP_VALUE_SIZE))
+  {
+    return;
+  }
+
+  /* Check if there is request update */
+  if ((pRecord[1] & OTP_REQUEST_UPDATE_MASK) == 0U)
+  {
+    return;
+  }
+
+#if !defined (STM32MP257Cxx)
+  /* Stop at the first error, as the otp structure write */
+  if (otp_image_status != OTP_OK)
+  {
+    return;
+  }
+#endif /* STM32MP257Cxx */
+
+  if (OTP_Util_WriteWord(Index - 1U, pRecord[0], pRecord[1]) != OTP_OK)
+  {
+    otp_image_status = OTP_ERROR;
+  }
+}
+
 #ifdef USE_HASH_OVER_OTP
 int OPENBL_Hash_Calculate(OPENBL_Otp_TypeDef *Otp)
 {
   int ret = -1;
-  OPENBL_Hash_DeInit();
-  OPENBL_Hash_Init();
 
-  /* calculate hash over OTP value & status */
+  /* The otp values are read only if the kept digest is outdated */
+  if (HASH_Util_IsValid() == 0U)
+  {
+    OTP_Util_Read(Otp);
+  }
+
+  /* calculate hash over OTP values, the peripheral is kept initialized */
   ret = OPENBL_Hash_Start(Otp);
   return ret;
 }
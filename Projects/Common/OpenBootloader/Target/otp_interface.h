@@ -29,12 +29,22 @@ extern "C" {
 /* Exported types ------------------------------------------------------------*/
 typedef Otp_TypeDef OPENBL_Otp_TypeDef;
 /* Exported constants --------------------------------------------------------*/
+#define OTP_RECORD_NONE                 1   /* Received otp block is not a record */
+#define OTP_RECORD_INVALID              -2  /* Received otp record is malformed */
 /* Exported macro ------------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
 void OPENBL_OTP_Init(void);
 void OPENBL_OTP_DeInit(void);
-int OPENBL_OTP_Write(OPENBL_Otp_TypeDef Otp);
-OPENBL_Otp_TypeDef OPENBL_OTP_Read(void);
+int OPENBL_OTP_Write(const OPENBL_Otp_TypeDef *pOtp);
+void OPENBL_OTP_Read(OPENBL_Otp_TypeDef *pOtp);
+void OPENBL_OTP_ReadState(OPENBL_Otp_TypeDef *pOtp);
+int OPENBL_OTP_ReadRange(uint32_t first, uint32_t count, OPENBL_Otp_TypeDef *pOtp);
+int OPENBL_OTP_ReadModeRecord(const uint8_t *pRecord, uint32_t Length);
+int OPENBL_OTP_StatsRecord(const uint8_t *pRecord, uint32_t Length);
+void OPENBL_OTP_GetStats(uint32_t *pRecord);
+int OPENBL_OTP_DeltaRecord(const uint8_t *pRecord, uint32_t Length);
+int OPENBL_OTP_WriteImage(uint32_t Offset, const uint8_t *pData, uint32_t Length);
+uint32_t OPENBL_OTP_ReadImage(uint32_t Offset, uint8_t *pData, uint32_t Length);
 #ifdef USE_HASH_OVER_OTP
 int OPENBL_Hash_Calculate(OPENBL_Otp_TypeDef *Otp);
 #endif /* USE_HASH_OVER_OTP */
@@ -26,25 +26,31 @@ extern int8_t pmic_nvm_str[];
 /* Private defines -----------------------------------------------------------*/
 /* Private macros ------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
-uint8_t PMIC_Initialized = 0U;
-static uint8_t pmic_status = PMIC_ERROR_NONE;
-static pmic_data_t identified_pmic;
+static pmic_context_t *pmic_ctx = NULL;
+static uint8_t pmic_nvm_cache[MAX_PMIC_NVM_SIZE];
+static uint32_t pmic_generation = 1U;         /* Bumped by each NVM write */
+static uint32_t pmic_cache_generation = 0U;   /* Generation of the cached NVM image */
+static bool pmic_refresh = false;             /* Next read is done on the I2C bus */
 
 /* Private function prototypes -----------------------------------------------*/
 /* Functions Definition ------------------------------------------------------*/
 
 /**
-  * @brief  Interface for OpenBootloader to initialize PMIC.
+  * @brief  Interface for OpenBootloader to initialize PMIC, done on its first use.
   * @param  none
-  * @param  none
-  * @retval
+  * @retval none
+  *
+  * No PMIC access is done at boot when no PMIC phase is used: until then the
+  * DFU descriptor advertises the largest NVM image.
   */
 void OPENBL_PMIC_Init(void)
 {
+  uint32_t pmic_status;
+  uint8_t tmp = PMIC_PROTOCOL_HEADER_SIZE;
 
-  PMIC_Util_Init();
-
-  pmic_status = PMIC_Util_Detect_PMIC(&identified_pmic);
+  /* The I2C bus and the detected PMIC are shared with the console */
+  pmic_ctx = PMIC_Util_GetContext();
+  pmic_status = pmic_ctx->Status;
 
   if (pmic_status == PMIC_ERROR_INVALID_ARG)
   {
@@ -60,35 +66,37 @@ void OPENBL_PMIC_Init(void)
   }
   else
   {
-	  uint8_t tmp;
-	  tmp = (identified_pmic.NVMSize + PMIC_PROTOCOL_HEADER_SIZE);
-	  pmic_nvm_str[14] = (tmp/10) + 48U;
-	  pmic_nvm_str[15] = (tmp%10) + 48U;
+	  tmp += pmic_ctx->Pmic.NVMSize;
   }
 
-  PMIC_Initialized = 1U;
+  pmic_nvm_str[14] = (tmp/10) + 48U;
+  pmic_nvm_str[15] = (tmp%10) + 48U;
 }
 
 /**
   * @brief  Interface for OpenBootloader to Read PMIC.
   * @param  pDest : address of memory in RAM to write the read data form PMIC
-  * @retval none
+  * @retval PMIC_ERROR_NONE if the NVM image is read, or no PMIC is present
+  *         PMIC_ERROR_I2C if the bus read failed, the header then reports no PMIC
   */
-void OPENBL_PMIC_Read(uint8_t *pDest)
+uint32_t OPENBL_PMIC_Read(uint8_t *pDest)
 {
   uint8_t pmic_info;
 
-  if (PMIC_Initialized == 0)
+  if (pmic_ctx == NULL)
   {
     OPENBL_PMIC_Init();
   }
 
+  /* The partition may be sized for the largest NVM image before the detection */
+  memset(pDest, 0, PMIC_PROTOCOL_HEADER_SIZE + MAX_PMIC_NVM_SIZE);
+
   /* protocol version specified in Macro PMIC_PROTOCOL_VERSION */
   pmic_info = PMIC_Util_GetNVMID();
 
   *pDest = PMIC_PROTOCOL_VERSION;
 
-  if (pmic_status == PMIC_ERROR_NO_PMIC)
+  if (pmic_ctx->Status == PMIC_ERROR_NO_PMIC)
   {
 	  *(pDest + 1) = 0xFF;
   }
@@ -97,38 +105,123 @@ void OPENBL_PMIC_Read(uint8_t *pDest)
     *(pDest + 1) = (pmic_info & 0xF0) >> 4;
     *(pDest + 3) = (pmic_info & 0x0F);
     *(pDest + 4) = (PMIC_I2C_ADDRESS >> 1);
-    PMIC_Util_ReadWrite(pDest + PMIC_PROTOCOL_HEADER_SIZE, PMIC_SHADOW_READ, &identified_pmic);
+
+    /* The NVM image is only read again on the bus when it may have changed */
+    if (pmic_refresh || (pmic_cache_generation != pmic_generation))
+    {
+      /* After a write, the shadow registers were already read back for verification */
+      if ((pmic_refresh == false) && pmic_ctx->NVMValid)
+      {
+        memcpy(pmic_nvm_cache, pmic_ctx->NVM, pmic_ctx->Pmic.NVMSize);
+      }
+      else if (PMIC_Util_ReadWrite(pmic_nvm_cache, PMIC_SHADOW_READ, &pmic_ctx->Pmic) != PMIC_ERROR_NONE)
+      {
+        /* The cache is left stale, the next read is tried on the bus again */
+        *(pDest + 1) = 0xFF;
+        return PMIC_ERROR_I2C;
+      }
+
+      pmic_cache_generation = pmic_generation;
+      pmic_refresh = false;
+    }
+
+    memcpy(pDest + PMIC_PROTOCOL_HEADER_SIZE, pmic_nvm_cache, pmic_ctx->Pmic.NVMSize);
   }
 
+  return PMIC_ERROR_NONE;
 }
 
 /**
   * @brief  Interface for OpenBootloader to Write PMIC.
   * @param  pSource : address of memory in RAM to read data for writing to PMIC.
-  * @retval none
+  * @retval PMIC_ERROR_NONE if the NVM is programmed
   */
-void OPENBL_PMIC_Write(uint8_t *pSource)
+uint32_t OPENBL_PMIC_Write(uint8_t *pSource)
 {
-  if (PMIC_Initialized == 0)
+  if (pmic_ctx == NULL)
   {
     OPENBL_PMIC_Init();
   }
 
-  PMIC_Util_ReadWrite(pSource, PMIC_SHADOW_WRITE, &identified_pmic);
+  /* The cached NVM image is stale, even if the write failed halfway */
+  pmic_generation++;
+
+  return PMIC_Util_ReadWrite(pSource, PMIC_SHADOW_WRITE, &pmic_ctx->Pmic);
+}
+
+/**
+  * @brief  Interface for OpenBootloader to force the next PMIC read on the I2C bus.
+  * @param  none
+  * @retval none
+  */
+void OPENBL_PMIC_Refresh(void)
+{
+  pmic_refresh = true;
+}
+
+/**
+  * @brief  Interface for OpenBootloader to apply a PMIC refresh record.
+  * @param  pRecord : pointer to the received PMIC block
+  * @param  Length : size of the received block
+  * @retval PMIC_ERROR_NONE if the block is a refresh record, it is then applied
+  *
+  * The record is sent in place of the NVM image: the "SPR1" magic word only.
+  * It is shorter than any NVM image, so it cannot be mistaken for one.
+  */
+uint32_t OPENBL_PMIC_RefreshRecord(const uint8_t *pRecord, uint32_t Length)
+{
+  uint32_t magic;
+
+  if ((Length < 4U) || (Length >= PMIC_PROTOCOL_HEADER_SIZE))
+  {
+    return PMIC_ERROR_INVALID_ARG;
+  }
+
+  magic = ((uint32_t)pRecord[3] << 24) | ((uint32_t)pRecord[2] << 16) | ((uint32_t)pRecord[1] << 8) | (uint32_t)pRecord[0];
+
+  if (magic != PMIC_REFRESH_MAGIC)
+  {
+    return PMIC_ERROR_INVALID_ARG;
+  }
+
+  OPENBL_PMIC_Refresh();
+
+  return PMIC_ERROR_NONE;
+}
+
+/**
+  * @brief  Interface for OpenBootloader to Get the PMIC NVM generation.
+  * @param  none
+  * @retval Number of NVM writes since boot, plus one
+  */
+uint32_t OPENBL_PMIC_Get_Generation(void)
+{
+  return pmic_generation;
+}
+
+/**
+  * @brief  Interface for OpenBootloader to Get the expected PMIC write duration.
+  * @param  none
+  * @retval Duration of the last NVM programming, in ms
+  */
+uint32_t OPENBL_PMIC_Get_Busy_Time(void)
+{
+  return PMIC_Util_GetProgTime();
 }
 
 /**
   * @brief  Interface for OpenBootloader to Get PMIC NVM size.
   * @param  none
-  * @retval Size of identified PMIC NVM
+  * @retval Size of identified PMIC NVM, the largest supported one until the PMIC is detected
   */
 uint32_t OPENBL_PMIC_Get_NVM_Size(void)
 {
-  if (PMIC_Initialized == 0)
+  /* No I2C access here, this is called from the USB descriptor requests */
+  if (pmic_ctx == NULL)
   {
-    OPENBL_PMIC_Init();
+    return MAX_PMIC_NVM_SIZE;
   }
 
-  return (identified_pmic.NVMSize);
+  return (pmic_ctx->Pmic.NVMSize);
 }
 
@@ -28,13 +28,18 @@ extern "C" {
 #include "pmic_util.h"
 /* Exported types ------------------------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
+#define PMIC_REFRESH_MAGIC                     0x31525053U  /* "SPR1", next NVM read done on the bus */
 /* Exported variables --------------------------------------------------------*/
 /* Exported macros -----------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
 void OPENBL_PMIC_Init(void);
-void OPENBL_PMIC_Read(uint8_t *pDest);
-void OPENBL_PMIC_Write(uint8_t *pSource);
+uint32_t OPENBL_PMIC_Read(uint8_t *pDest);
+uint32_t OPENBL_PMIC_Write(uint8_t *pSource);
 uint32_t OPENBL_PMIC_Get_NVM_Size(void);
+uint32_t OPENBL_PMIC_Get_Busy_Time(void);
+void OPENBL_PMIC_Refresh(void);
+uint32_t OPENBL_PMIC_RefreshRecord(const uint8_t *pRecord, uint32_t Length);
+uint32_t OPENBL_PMIC_Get_Generation(void);
 
 #ifdef __cplusplus
 }
@@ -37,6 +37,7 @@ OPENBL_MemoryTypeDef RAM_Descriptor =
   RAM_AREA,
   NULL,
   OPENBL_RAM_Read,
+  OPENBL_RAM_ReadBlock,
   OPENBL_RAM_Write,
   OPENBL_RAM_JumpToAddress,
   NULL,
@@ -56,6 +57,18 @@ uint8_t OPENBL_RAM_Read(uint32_t Address)
   return (*(uint8_t *)(Address));
 }
 
+/**
+  * @brief  This function is used to read a block of data from RAM memory.
+  * @param  Address The address where the data will be read.
+  * @param  Data Pointer to the buffer receiving the data.
+  * @param  DataLength The length of the data to be read.
+  * @retval None.
+  */
+void OPENBL_RAM_ReadBlock(uint32_t Address, uint8_t *Data, uint32_t DataLength)
+{
+  memcpy(Data, (uint8_t *)Address, DataLength);
+}
+
 /**
   * @brief  This function is used to write data in RAM memory.
   * @param  Address The address where that data will be written.
@@ -20,7 +20,9 @@
 #include "main.h"
 #include "pmic_interface_cli.h"
 #include "console_util.h"
+#include "crc32_util.h"
 #include "pmic_util.h"
+#include "pmic_emul.h"
 #include <limits.h>
 #include <errno.h>
 #include <stdbool.h>
@@ -34,6 +36,8 @@ typedef enum
   PMIC_CMD_DISPL,
   PMIC_CMD_WRITE,
   PMIC_CMD_UPDATE,
+  PMIC_CMD_DETECT,
+  PMIC_CMD_IMAGE,
   PMIC_CMD_EXIT,
   PMIC_CMD_MAX,
 } pmic_cmd_id;
@@ -68,7 +72,7 @@ static bool auto_conf;
 static uint8_t nvm_buffer[MAX_PMIC_NVM_SIZE] = {0};
 uint32_t prev_pmic_cmd;
 static bool once_nvm_read_in_buffer = false;
-static pmic_data_t identified_pmic;
+static pmic_data_t *identified_pmic;
 
 /* Private function prototypes -----------------------------------------------*/
 static void print_help(void);
@@ -81,6 +85,11 @@ static void print_command_error(void);
 static void print_outofrange_error(uint8_t num);
 static void print_modified_values(void);
 static void read_nvm_in_buffer(void);
+static bool pmic_detect(pmic_context_t *pmic_ctx);
+static void program_nvm_buffer(void);
+static void print_image(int argc, char *argv[]);
+static int image_parse_hex(const char *hex, uint8_t *image);
+static int image_receive_bin(uint8_t *image, uint32_t length, uint32_t crc);
 
 /* Exported variables --------------------------------------------------------*/
 
@@ -102,7 +111,17 @@ static void print_help(void)
   printf("                             (i.e. write addr=0 value=0xff addr=2 value=0x2F)\n\r");
   printf(">update                    : This command starts programming of PMIC NVM with shadow registers\n\r");
   printf("                             %d bytes starting from 0x%x at the same command line\n\r",
-         identified_pmic.NVMSize, identified_pmic.NVMStartAddress);
+         identified_pmic->NVMSize, identified_pmic->NVMStartAddress);
+  printf(">detect                    : This command detects the PMIC again and discards\n\r");
+  printf("                             the local copy\n\r");
+  printf(">image                     : This command programs a whole NVM image of %d bytes\n\r",
+         identified_pmic->NVMSize);
+  printf("                             in one step with a single confirmation\n\r");
+  printf(" [-y]                      : {Optional} enable auto confirmation\n\r");
+  printf(" [<hex>]                   : Register values from 0x%x as %d hex digits\n\r",
+         identified_pmic->NVMStartAddress, 2 * identified_pmic->NVMSize);
+  printf(" [bin <length> <crc>]      : Receive instead <length> raw bytes of register values\n\r");
+  printf("                             checked with their CRC-32 <crc>\n\r");
   printf(">exit                      : This command return to the Main menu\n\r");
 }
 
@@ -117,16 +136,20 @@ static void print_displ(int argc, char *argv[])
   errno = 0;
   once = true;
   uint8_t idx;
-  uint8_t pmic_nvm_shadow[identified_pmic.NVMSize];
+  uint8_t pmic_nvm_shadow[identified_pmic->NVMSize];
 
-  PMIC_Util_ReadWrite(pmic_nvm_shadow, PMIC_SHADOW_READ, &identified_pmic);
+  if (PMIC_Util_ReadWrite(pmic_nvm_shadow, PMIC_SHADOW_READ, identified_pmic) != PMIC_ERROR_NONE)
+  {
+    printf("\n\rError: PMIC I2C access failed\n\r");
+    return;
+  }
 
   printf("address | value\n\r");
   printf("----------------\n\r");
 
-  for (idx = 0; idx < identified_pmic.NVMSize; idx++)
+  for (idx = 0; idx < identified_pmic->NVMSize; idx++)
   {
-    printf(" 0x%x   | 0x%x \n\r", (identified_pmic.NVMStartAddress + idx), pmic_nvm_shadow[idx]);
+    printf(" 0x%x   | 0x%x \n\r", (identified_pmic->NVMStartAddress + idx), pmic_nvm_shadow[idx]);
     printf("----------------\n\r");
   }
 }
@@ -200,8 +223,8 @@ static void print_write(int argc, char *argv[])
         }
 
         /* if value is in NVM address range */
-        if ((val >= identified_pmic.NVMStartAddress)
-            && (val <= (identified_pmic.NVMStartAddress + identified_pmic.NVMSize) - 1U))
+        if ((val >= identified_pmic->NVMStartAddress)
+            && (val <= (identified_pmic->NVMStartAddress + identified_pmic->NVMSize) - 1U))
         {
           nvm_reg_addr = val;
 
@@ -225,7 +248,7 @@ static void print_write(int argc, char *argv[])
               }
               else
               {
-                nvm_buffer[nvm_reg_addr - identified_pmic.NVMStartAddress] = val;
+                nvm_buffer[nvm_reg_addr - identified_pmic->NVMStartAddress] = val;
                 show_notification = true;
               }
             }
@@ -266,7 +289,6 @@ static void print_update(int argc, char *argv[])
 {
   printf("\n\rPlease verify the data below..?\n\r");
   print_modified_values();
-  uint8_t tmp[identified_pmic.NVMSize];
 
   printf("\n\rWarning: Do you confirm?  [y/n]\n\r");
   /* Get the user entry */
@@ -283,17 +305,7 @@ static void print_update(int argc, char *argv[])
   if ((entry[0] == 'y') || (entry[0] == 'Y'))
   {
     printf("\n\rThe operation was confirmed...\n\r");
-    PMIC_Util_ReadWrite(nvm_buffer, PMIC_SHADOW_WRITE, &identified_pmic);
-    PMIC_Util_ReadWrite(tmp, PMIC_SHADOW_READ, &identified_pmic);
-    if (memcmp((const void *) nvm_buffer, (const void *)tmp, identified_pmic.NVMSize) == 0U)
-    {
-      printf("\n\rThe operation was success...\n\r");
-    }
-    else
-    {
-      printf("\n\rThe operation Failed...\n\r");
-    }
-
+    program_nvm_buffer();
   }
   else /* if entry is no */
   {
@@ -314,9 +326,245 @@ static void print_update(int argc, char *argv[])
     if ((entry[0] == 'y') || (entry[0] == 'Y'))
     {
       /* Clear the buffer by reading nvm */
-      PMIC_Util_ReadWrite((uint8_t *)&nvm_buffer, PMIC_SHADOW_READ, &identified_pmic);
+      read_nvm_in_buffer();
+    }
+  }
+}
+
+/**
+  * @brief program the local copy in the PMIC NVM and print the result
+  * @param None
+  * @retval None
+  */
+static void program_nvm_buffer(void)
+{
+  pmic_write_result_t result;
+  uint32_t status;
+  uint8_t idx;
+#if defined(USE_PMIC_EMULATION)
+  PMIC_Emul_StatsTypeDef stats;
+
+  PMIC_Emul_ResetStats();
+#endif /* USE_PMIC_EMULATION */
+  status = PMIC_Util_ReadWrite(nvm_buffer, PMIC_SHADOW_WRITE, identified_pmic);
+  PMIC_Util_GetWriteResult(&result);
+#if defined(USE_PMIC_EMULATION)
+  PMIC_Emul_GetStats(&stats);
+  printf("\n\rBus: %lu read(s) of %lu byte(s), %lu write(s) of %lu byte(s), %lu NACK(s), %lu busy poll(s)\n\r",
+         stats.ReadCount, stats.ReadBytes, stats.WriteCount, stats.WriteBytes, stats.NackCount, stats.BusyPolls);
+#endif /* USE_PMIC_EMULATION */
+  if (status == PMIC_ERROR_I2C)
+  {
+    printf("\n\rError: PMIC I2C access failed\n\r");
+    printf("\n\rThe operation Failed...\n\r");
+  }
+  else if (status == PMIC_ERROR_NVM_TIMEOUT)
+  {
+    printf("\n\rError: NVM still busy after %lu ms\n\r", result.ProgTime);
+    printf("\n\rThe operation Failed...\n\r");
+  }
+  else if (status == PMIC_ERROR_VERIFY)
+  {
+    for (idx = 0; idx < identified_pmic->NVMSize; idx++)
+    {
+      if ((result.ErrorMap & (1ULL << idx)) != 0U)
+      {
+        printf("Register 0x%02X not updated\n\r", identified_pmic->NVMStartAddress + idx);
+      }
+    }
+    printf("\n\rNVM not programmed\n\r");
+    printf("\n\rThe operation Failed...\n\r");
+  }
+  else
+  {
+    printf("\n\r%d register(s) written in %d I2C transaction(s), NVM programmed in %lu ms\n\r",
+           result.DirtyCount, result.WriteCount, result.ProgTime);
+    printf("\n\rThe operation was success...\n\r");
+  }
+}
+
+/**
+  * @brief get the image from its hex digits
+  * @param hex: two hex digits per register, from the first NVM register
+  *      image: pointer to the register values
+  * @retval 0: if the image is valid
+  *         -1: if the image is not valid
+  */
+static int image_parse_hex(const char *hex, uint8_t *image)
+{
+  char digits[3] = {0};
+  uint8_t idx;
+
+  if (strlen(hex) != (2U * identified_pmic->NVMSize))
+  {
+    printf("Error: %d hex digits expected, %d received\n\r", 2 * identified_pmic->NVMSize, (int)strlen(hex));
+    return -1;
+  }
+
+  for (idx = 0; idx < identified_pmic->NVMSize; idx++)
+  {
+    digits[0] = hex[2 * idx];
+    digits[1] = hex[(2 * idx) + 1];
+    image[idx] = (uint8_t)strtoul(digits, &end_ptr, 16);
+
+    if (*end_ptr != '\0')
+    {
+      printf("Error: invalid hex digit at offset %d\n\r", 2 * idx);
+      return -1;
     }
   }
+
+  return 0;
+}
+
+/**
+  * @brief get the binary image
+  * @param image: pointer to the register values
+  *      length: number of bytes of the image
+  *      crc: CRC-32 of the image
+  * @retval 0: if the image is valid
+  *         -1: if the image is not valid
+  */
+static int image_receive_bin(uint8_t *image, uint32_t length, uint32_t crc)
+{
+  uint32_t running_crc;
+  uint32_t idx;
+
+  if (length != identified_pmic->NVMSize)
+  {
+    printf("Error: %d bytes expected\n\r", identified_pmic->NVMSize);
+    return -1;
+  }
+
+  printf("Send the %lu bytes of the image\n\r", length);
+
+  for (idx = 0U; idx < length; idx++)
+  {
+    image[idx] = (uint8_t)Serial_Scanf(255);
+  }
+
+  running_crc = CRC32_Util_Compute(0U, image, length);
+  if (running_crc != crc)
+  {
+    printf("Error: CRC-32 0x%08lX does not match 0x%08lX\n\r", running_crc, crc);
+    return -1;
+  }
+
+  return 0;
+}
+
+/**
+  * @brief get a whole NVM image, check it against the local copy and program it
+  * @param argc:
+  *      argv:
+  * @retval None
+  */
+static void print_image(int argc, char *argv[])
+{
+  uint8_t image[MAX_PMIC_NVM_SIZE];
+  pmic_context_t *pmic_ctx;
+  uint32_t length;
+  uint32_t crc;
+  uint8_t count = 0;
+  uint8_t idx;
+  int ret;
+
+  auto_conf = false;
+  prev_pmic_cmd = 0;
+  errno = 0;
+
+  /* if auto confirmation is enabled */
+  if ((argc >= 2) && !strcmp(argv[0], "-y"))
+  {
+    auto_conf = true;
+    prev_pmic_cmd++;
+    printf("Warning: Auto confirmation is enabled.\n\r");
+  }
+
+  /* if the image is a binary one */
+  if (((argc - 1 - prev_pmic_cmd) == 3) && !strcmp(argv[prev_pmic_cmd], "bin"))
+  {
+    length = strtoul(argv[prev_pmic_cmd + 1], &end_ptr, 0);
+    if ((end_ptr == argv[prev_pmic_cmd + 1]) || (*end_ptr != '\0'))
+    {
+      print_command_error();
+      return;
+    }
+
+    crc = strtoul(argv[prev_pmic_cmd + 2], &end_ptr, 0);
+    if ((end_ptr == argv[prev_pmic_cmd + 2]) || (*end_ptr != '\0') || (errno == ERANGE))
+    {
+      print_command_error();
+      return;
+    }
+
+    ret = image_receive_bin(image, length, crc);
+  }
+  else if ((argc - 1 - prev_pmic_cmd) == 1)
+  {
+    ret = image_parse_hex(argv[prev_pmic_cmd], image);
+  }
+  else
+  {
+    /* print command error message */
+    print_command_error();
+    return;
+  }
+
+  if (ret != 0)
+  {
+    printf("Error: invalid image, the NVM is not programmed\n\r");
+    return;
+  }
+
+  /* One summary of the registers changed by the image */
+  printf("address | value\n\r");
+  printf("----------------\n\r");
+  for (idx = 0; idx < identified_pmic->NVMSize; idx++)
+  {
+    if (image[idx] != nvm_buffer[idx])
+    {
+      printf(" 0x%x   | 0x%x -> (0x%x)\n\r", (identified_pmic->NVMStartAddress + idx), nvm_buffer[idx], image[idx]);
+      count++;
+    }
+  }
+  printf("----------------\n\r");
+  printf("%d of %d register(s) changed by the image\n\r", count, identified_pmic->NVMSize);
+
+  /* Nothing to do if the PMIC already holds the image */
+  pmic_ctx = PMIC_Util_GetContext();
+  if (pmic_ctx->NVMValid && (memcmp(pmic_ctx->NVM, image, identified_pmic->NVMSize) == 0))
+  {
+    memcpy(nvm_buffer, image, identified_pmic->NVMSize);
+    printf("\n\rThe NVM already holds the image, nothing to program\n\r");
+    return;
+  }
+
+  if (auto_conf == false)
+  {
+    printf("\n\rWarning: Do you confirm?  [y/n]\n\r");
+    /* Get the user entry */
+    get_entry_string(entry);
+
+    /* while the entry is not the expected one */
+    while ((entry[0] != 'y') && (entry[0] != 'Y') && (entry[0] != 'n') && (entry[0] != 'N'))
+    {
+      printf("Error: type 'y' or 'Y' for yes and type 'n' or 'N' for no\n\r");
+      /* Get the user entry */
+      get_entry_string(entry);
+    }
+
+    /* if entry is no */
+    if ((entry[0] == 'n') || (entry[0] == 'N'))
+    {
+      printf("\n\rWarning: The operation was cancelled...\n\r");
+      return;
+    }
+  }
+
+  printf("\n\rThe operation was confirmed...\n\r");
+  memcpy(nvm_buffer, image, identified_pmic->NVMSize);
+  program_nvm_buffer();
 }
 
 static bool print_exit(int argc, char *argv[])
@@ -328,21 +576,25 @@ static bool print_exit(int argc, char *argv[])
 static void print_modified_values(void)
 {
   uint8_t idx;
-  uint8_t pmic_nvm_shadow[identified_pmic.NVMSize];
+  uint8_t pmic_nvm_shadow[identified_pmic->NVMSize];
 
-  PMIC_Util_ReadWrite(pmic_nvm_shadow, PMIC_SHADOW_READ, &identified_pmic);
+  if (PMIC_Util_ReadWrite(pmic_nvm_shadow, PMIC_SHADOW_READ, identified_pmic) != PMIC_ERROR_NONE)
+  {
+    printf("\n\rError: PMIC I2C access failed\n\r");
+    return;
+  }
 
   printf("address | value\n\r");
   printf("----------------\n\r");
-  for (idx = 0; idx < identified_pmic.NVMSize; idx++)
+  for (idx = 0; idx < identified_pmic->NVMSize; idx++)
   {
     if (nvm_buffer[idx] == pmic_nvm_shadow[idx])
     {
-      printf(" 0x%x   | 0x%x \n\r", (identified_pmic.NVMStartAddress + idx), pmic_nvm_shadow[idx]);
+      printf(" 0x%x   | 0x%x \n\r", (identified_pmic->NVMStartAddress + idx), pmic_nvm_shadow[idx]);
     }
     else
     {
-      printf(" 0x%x   | 0x%x -> (0x%x)\n\r", (identified_pmic.NVMStartAddress + idx), pmic_nvm_shadow[idx],
+      printf(" 0x%x   | 0x%x -> (0x%x)\n\r", (identified_pmic->NVMStartAddress + idx), pmic_nvm_shadow[idx],
              nvm_buffer[idx]);
     }
     printf("----------------\n\r");
@@ -371,10 +623,6 @@ static void free_args(int argc, char *argv[])
   */
 static void get_entry_string(char *entry)
 {
-  uint8_t user_entry_valid = 0;
-  char user_entry_value = 0;
-  int i = 0;
-
 #ifndef __TERMINAL_IO__
   Serial_Putchar(0xd);
   Serial_Putchar('U');
@@ -386,42 +634,8 @@ static void get_entry_string(char *entry)
   printf("\rUser>\n\r");
 #endif /* __TERMINAL_IO__ */
 
-  while (user_entry_valid == 0)
-  {
-    /* Scan for user entry */
-    user_entry_value = Serial_Scanf(255);
-
-#ifndef __TERMINAL_IO__
-    /* Print the entry character */
-    Serial_Putchar(user_entry_value);
-
-    /* if carriage return is detected */
-    if (user_entry_value == 0xd)
-    {
-      entry[i] = '\0';
-      printf("\r\n");
-      user_entry_valid = 1;
-    }
-    /* if cancel or delete is detected */
-    else if (user_entry_value == 0x18 || user_entry_value == 0x7f)
-    {
-      i--;
-    }
-#else
-    /* if new line is detected */
-    if ((user_entry_value == 0xa) || (user_entry_value == 0xd))
-    {
-      entry[i] = '\0';
-      printf("\r\n");
-      user_entry_valid = 1;
-      fflush(stdin);
-    }
-#endif /* __TERMINAL_IO__  */
-    else /* if user keep writing */
-    {
-      entry[i++] = user_entry_value;
-    }
-  }
+  /* Echo, line editing and length bound are handled by the line discipline */
+  (void)Serial_GetLine(entry, CMD_MAX_LEN);
 }
 
 /**
@@ -539,7 +753,75 @@ static int parse_entry_string(char *entry, size_t size, int *command, char *argv
   */
 static void read_nvm_in_buffer(void)
 {
-  PMIC_Util_ReadWrite((uint8_t *)&nvm_buffer, PMIC_SHADOW_READ, &identified_pmic);
+  if (PMIC_Util_ReadWrite((uint8_t *)&nvm_buffer, PMIC_SHADOW_READ, identified_pmic) != PMIC_ERROR_NONE)
+  {
+    printf("\n\rError: PMIC I2C access failed, the buffer is not updated\n\r");
+  }
+}
+
+/**
+  * @brief start a console session on the detected pmic
+  * @param pmic_ctx: pmic context
+  * @retval bool: true if the pmic can be used
+  */
+static bool pmic_detect(pmic_context_t *pmic_ctx)
+{
+  once_nvm_read_in_buffer = false;
+
+  if (pmic_ctx->Status != PMIC_ERROR_NONE)
+  {
+    printf("\n\r ERROR!!: Unable to detect PMIC \n\r");
+    return false;
+  }
+
+  identified_pmic = &pmic_ctx->Pmic;
+
+  printf("\n\r----------------------------------\n\r");
+  printf("*** PMIC Detected : STPMIC%s ***\n\r", identified_pmic->DisplayString);
+  printf("*** NVM SIZE: %d ***\n\r", identified_pmic->NVMSize);
+  printf("*** I2C Address Configured: 0x%x ***\n\r", (PMIC_I2C_ADDRESS >> 1));
+  printf("*** I2C Bus Speed: %lu kHz ***\n\r", (unsigned long)pmic_ctx->BusFreq);
+  printf("----------------------------------\n\r");
+  if (identified_pmic->Supported == PMIC_NOT_SUPPORTED)
+  {
+    printf("\n\r ERROR!!: This PMIC is currently not supported \n\r");
+    return false;
+  }
+
+  /* Start from the cached shadow registers when they are known */
+  if (pmic_ctx->NVMValid)
+  {
+    memcpy(nvm_buffer, pmic_ctx->NVM, identified_pmic->NVMSize);
+  }
+  else
+  {
+    read_nvm_in_buffer();
+  }
+  once_nvm_read_in_buffer = true;
+
+  pmic_cmd[PMIC_CMD_HELP].str       = "help";
+  pmic_cmd[PMIC_CMD_HELP].param_min = 0;
+  pmic_cmd[PMIC_CMD_HELP].param_max = 0;
+  pmic_cmd[PMIC_CMD_DISPL].str  = "displ";
+  pmic_cmd[PMIC_CMD_DISPL].param_min  = 0;
+  pmic_cmd[PMIC_CMD_DISPL].param_max  = 0;
+  pmic_cmd[PMIC_CMD_WRITE].str  = "write";
+  pmic_cmd[PMIC_CMD_WRITE].param_min  = 2;
+  pmic_cmd[PMIC_CMD_WRITE].param_max  = ((2 * identified_pmic->NVMSize) + 2);
+  pmic_cmd[PMIC_CMD_UPDATE].str = "update";
+  pmic_cmd[PMIC_CMD_UPDATE].param_min = 0;
+  pmic_cmd[PMIC_CMD_UPDATE].param_max = 0;
+  pmic_cmd[PMIC_CMD_DETECT].str = "detect";
+  pmic_cmd[PMIC_CMD_DETECT].param_min = 0;
+  pmic_cmd[PMIC_CMD_DETECT].param_max = 0;
+  pmic_cmd[PMIC_CMD_IMAGE].str  = "image";
+  pmic_cmd[PMIC_CMD_IMAGE].param_min  = 1;
+  pmic_cmd[PMIC_CMD_IMAGE].param_max  = 4;
+  pmic_cmd[PMIC_CMD_EXIT].str         =  "exit";
+  pmic_cmd[PMIC_CMD_EXIT].param_min   = 0;
+  pmic_cmd[PMIC_CMD_EXIT].param_max   = 0;
+
+  return true;
 }
 
 /* Exported functions --------------------------------------------------------*/
@@ -557,48 +839,11 @@ bool pmic_commands_interactive(void)
   int cmd;
   bool ret = false;
 
-  /* Init the PMIC */
-  PMIC_Util_Init();
-
+  /* The PMIC is detected once, its context is kept between the commands */
   if (once_nvm_read_in_buffer == false)
   {
-    if (PMIC_Util_Detect_PMIC(&identified_pmic) == PMIC_ERROR_NONE)
-    {
-      printf("\n\r----------------------------------\n\r");
-      printf("*** PMIC Detected : STPMIC%s ***\n\r", identified_pmic.DisplayString);
-      printf("*** NVM SIZE: %d ***\n\r", identified_pmic.NVMSize);
-      printf("*** I2C Address Configured: 0x%x ***\n\r", (PMIC_I2C_ADDRESS >> 1));
-      printf("----------------------------------\n\r");
-      if (identified_pmic.Supported == PMIC_NOT_SUPPORTED)
-      {
-        printf("\n\r ERROR!!: This PMIC is currently not supported \n\r");
-        ret = true;
-        return ret;
-      }
-
-      read_nvm_in_buffer();
-      once_nvm_read_in_buffer = true;
-
-      pmic_cmd[PMIC_CMD_HELP].str       = "help";
-      pmic_cmd[PMIC_CMD_HELP].param_min = 0;
-      pmic_cmd[PMIC_CMD_HELP].param_max = 0;
-      pmic_cmd[PMIC_CMD_DISPL].str  = "displ";
-      pmic_cmd[PMIC_CMD_DISPL].param_min  = 0;
-      pmic_cmd[PMIC_CMD_DISPL].param_max  = 0;
-      pmic_cmd[PMIC_CMD_WRITE].str  = "write";
-      pmic_cmd[PMIC_CMD_WRITE].param_min  = 2;
-      pmic_cmd[PMIC_CMD_WRITE].param_max  = ((2 * identified_pmic.NVMSize) + 2);
-      pmic_cmd[PMIC_CMD_UPDATE].str = "update";
-      pmic_cmd[PMIC_CMD_UPDATE].param_min = 0;
-      pmic_cmd[PMIC_CMD_UPDATE].param_max = 0;
-      pmic_cmd[PMIC_CMD_EXIT].str         =  "exit";
-      pmic_cmd[PMIC_CMD_EXIT].param_min   = 0;
-      pmic_cmd[PMIC_CMD_EXIT].param_max   = 0;
-
-    }
-    else
+    if (pmic_detect(PMIC_Util_GetContext()) == false)
     {
-      printf("\n\r ERROR!!: Unable to detect PMIC \n\r");
       ret = true;
       return ret;
     }
@@ -635,6 +880,14 @@ bool pmic_commands_interactive(void)
       print_update(argc, argv);
       break;
 
+    case PMIC_CMD_DETECT:
+      ret = !pmic_detect(PMIC_Util_Redetect());
+      break;
+
+    case PMIC_CMD_IMAGE:
+      print_image(argc, argv);
+      break;
+
     case PMIC_CMD_EXIT:
       ret = print_exit(argc, argv);
     default:
@@ -655,4 +908,7 @@ bool pmic_commands_interactive(void)
 void pmic_print_header(void)
 {
   printf("\n\r=========== PMIC Command Line interface ===========\n\r");
+#if defined(USE_PMIC_EMULATION)
+  printf("\n\rWarning: PMIC emulation, no PMIC is accessed\n\r");
+#endif /* USE_PMIC_EMULATION */
 }
@@ -0,0 +1,38 @@
+/**
+  ******************************************************************************
+  * @file    main.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in of the project main.h, for the utilities built in
+  *          the host tests: the HAL is the host one.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __MAIN_H
+#define __MAIN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Private includes ----------------------------------------------------------*/
+#include "string.h"
+#include "stdlib.h"
+#include "stm32mp13xx_hal.h"
+#include "app_openbootloader.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MAIN_H */
@@ -0,0 +1,226 @@
+/**
+  ******************************************************************************
+  * @file    stm32mp13xx_hal.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in of the STM32MP13xx HAL, used by the host tests to
+  *          build the otp and pmic utilities on the emulated fuses and
+  *          PMIC. It only declares the HAL types, constants and functions
+  *          referenced by these utilities, the functions are implemented
+  *          in hal_host.c.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32MP13xx_HAL_H
+#define STM32MP13xx_HAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum
+{
+  HAL_OK       = 0x00U,
+  HAL_ERROR    = 0x01U,
+  HAL_BUSY     = 0x02U,
+  HAL_TIMEOUT  = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum
+{
+  RESET = 0U,
+  SET = !RESET
+} FlagStatus, ITStatus;
+
+typedef enum
+{
+  SUCCESS = 0U,
+  ERROR = !SUCCESS
+} ErrorStatus;
+
+/* BSEC, the fuses are emulated: only the handle is used */
+typedef struct
+{
+  uint32_t Reserved;
+} BSEC_TypeDef;
+
+typedef enum
+{
+  BSEC_ERROR_NONE                    = 0x00,
+  BSEC_ERROR_INVALID_PARAMETER       = 0x01,
+  BSEC_ERROR_TIMEOUT                 = 0x04,
+  BSEC_ERROR_PERM_LOCK_PROG          = 0x10,
+  BSEC_ERROR_STICKY_LOCK_PROG        = 0x20
+} BSEC_ErrorTypeDef;
+
+typedef enum
+{
+  BSEC_NOTLOCKED  = 0x00,
+  BSEC_LOCKED     = 0x01
+} BSEC_LockStatusTypeDef;
+
+typedef enum
+{
+  BSEC_INVALID_STATE         = 0x00,
+  BSEC_SECURED_OPEN_STATE    = 0x01,
+  BSEC_SECURED_CLOSE_STATE   = 0x02
+} BSEC_ChipSecurityTypeDef;
+
+typedef enum
+{
+  BSEC_SAFMEM_CLK_RANGE_MAX  = 0x00
+} BSEC_SafMemClkRangeTypeDef;
+
+typedef struct
+{
+  BSEC_TypeDef      * Instance;
+  uint32_t            State;
+  BSEC_ErrorTypeDef   Error;
+} BSEC_HandleTypeDef;
+
+/* GPIO, the pins only drive the I2C bus recovery */
+typedef struct
+{
+  uint32_t IDR;       /* Input level of the pins */
+  uint32_t ODR;       /* Output level of the pins */
+} GPIO_TypeDef;
+
+typedef enum
+{
+  GPIO_PIN_RESET = 0U,
+  GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef struct
+{
+  uint32_t Pin;
+  uint32_t Mode;
+  uint32_t Pull;
+  uint32_t Speed;
+  uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+/* I2C, the transfers are emulated: the handle and the control register are used */
+typedef struct
+{
+  uint32_t CR1;
+} I2C_TypeDef;
+
+typedef struct
+{
+  uint32_t Timing;
+  uint32_t OwnAddress1;
+  uint32_t AddressingMode;
+  uint32_t DualAddressMode;
+  uint32_t OwnAddress2;
+  uint32_t OwnAddress2Masks;
+  uint32_t GeneralCallMode;
+  uint32_t NoStretchMode;
+} I2C_InitTypeDef;
+
+typedef struct
+{
+  I2C_TypeDef        * Instance;
+  I2C_InitTypeDef      Init;
+  uint32_t             State;
+  uint32_t             Mode;
+  uint32_t             ErrorCode;
+} I2C_HandleTypeDef;
+
+/* Exported constants --------------------------------------------------------*/
+extern BSEC_TypeDef HostBsec;
+#define BSEC                            (&HostBsec)
+
+extern GPIO_TypeDef HostGpioB;
+extern GPIO_TypeDef HostGpioE;
+#define GPIOB                           (&HostGpioB)
+#define GPIOE                           (&HostGpioE)
+
+#define GPIO_PIN_9                      (1U << 9)
+#define GPIO_PIN_15                     (1U << 15)
+#define GPIO_MODE_OUTPUT_OD             0x00000011U
+#define GPIO_MODE_AF_OD                 0x00000012U
+#define GPIO_NOPULL                     0x00000000U
+#define GPIO_SPEED_FREQ_HIGH            0x00000002U
+#define GPIO_AF6_I2C4                   0x06U
+
+extern I2C_TypeDef HostI2c4;
+#define I2C4                            (&HostI2c4)
+
+#define I2C_CR1_ANFOFF                  (1U << 12)
+#define I2C_TIMINGR_SCLL_Pos            0U
+#define I2C_TIMINGR_SCLL                (0xFFU << I2C_TIMINGR_SCLL_Pos)
+#define I2C_TIMINGR_SCLH_Pos            8U
+#define I2C_TIMINGR_SCLH                (0xFFU << I2C_TIMINGR_SCLH_Pos)
+#define I2C_TIMINGR_SDADEL_Pos          16U
+#define I2C_TIMINGR_SCLDEL_Pos          20U
+#define I2C_TIMINGR_PRESC_Pos           28U
+#define I2C_TIMINGR_PRESC               (0xFU << I2C_TIMINGR_PRESC_Pos)
+
+#define I2C_ADDRESSINGMODE_7BIT         0x00000001U
+#define I2C_DUALADDRESS_DISABLE         0x00000000U
+#define I2C_OA2_NOMASK                  0x00U
+#define I2C_GENERALCALL_DISABLE         0x00000000U
+#define I2C_NOSTRETCH_DISABLE           0x00000000U
+#define I2C_MEMADD_SIZE_8BIT            0x00000001U
+#define I2C_ANALOGFILTER_ENABLE         0x00000000U
+#define I2C_ANALOGFILTER_DISABLE        I2C_CR1_ANFOFF
+
+#define HAL_I2C_ERROR_NONE              0x00000000U
+#define HAL_I2C_ERROR_BERR              0x00000001U
+#define HAL_I2C_ERROR_ARLO              0x00000002U
+#define HAL_I2C_ERROR_AF                0x00000004U
+#define HAL_I2C_ERROR_SIZE              0x00000040U
+#define HAL_I2C_STATE_READY             0x20U
+#define HAL_I2C_MODE_NONE               0x00U
+
+#define RCC_PERIPHCLK_I2C4              0x00000004ULL
+
+/* Exported macro ------------------------------------------------------------*/
+#define UNUSED(X)                       (void)(X)
+
+#define __HAL_RCC_BSEC_CLK_ENABLE()     do { } while (0)
+#define __HAL_RCC_BSEC_CLK_DISABLE()    do { } while (0)
+#define __HAL_RCC_GPIOB_CLK_ENABLE()    do { } while (0)
+#define __HAL_RCC_GPIOE_CLK_ENABLE()    do { } while (0)
+#define __HAL_RCC_I2C4_CLK_ENABLE()     do { } while (0)
+#define __HAL_RCC_I2C4_FORCE_RESET()    do { } while (0)
+#define __HAL_RCC_I2C4_RELEASE_RESET()  do { } while (0)
+
+/* Exported variables --------------------------------------------------------*/
+extern uint32_t SystemCoreClock;
+
+/* Exported functions ------------------------------------------------------- */
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+void HAL_PWR_EnableBkUpAccess(void);
+void HAL_BSEC_Init(BSEC_HandleTypeDef *hBsec);
+void HAL_BSEC_DeInit(BSEC_HandleTypeDef *hBsec);
+HAL_StatusTypeDef HAL_BSEC_SafMemPwrUp(BSEC_HandleTypeDef *hBsec, BSEC_SafMemClkRangeTypeDef ClkRange);
+void HAL_BSEC_SafMemPwrDown(BSEC_HandleTypeDef *hBsec);
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+uint32_t HAL_RCCEx_GetPeriphCLKFreq(uint64_t PeriphClk);
+HAL_StatusTypeDef HAL_I2CEx_ConfigAnalogFilter(I2C_HandleTypeDef *hi2c, uint32_t AnalogFilter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32MP13xx_HAL_H */
@@ -0,0 +1,24 @@
+/**
+  ******************************************************************************
+  * @file    stm32mp13xx_ll_usart.h
+  * @author  MCD Application Team
+  * @brief   Host stand-in of the STM32MP13xx USART LL driver, nothing is used by
+  *          the utilities built in the host tests.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32MP13xx_LL_USART_H
+#define STM32MP13xx_LL_USART_H
+
+#endif /* STM32MP13xx_LL_USART_H */
@@ -0,0 +1,163 @@
+/**
+  ******************************************************************************
+  * @file    bench_otp.c
+  * @author  MCD Application Team
+  * @brief   Host cost of the otp utilities on emulated fuses without delay:
+  *          otp image read and programming in blocks as received by the
+  *          interfaces, and cache plan of all the otp words. The fuse
+  *          durations are not included, only the software overhead.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <time.h>
+#include "otp_interface.h"
+#include "otp_emul.h"
+
+/* Private define ------------------------------------------------------------*/
+#define BENCH_IMAGE_SIZE        ((uint32_t)sizeof(OPENBL_Otp_TypeDef))
+#define BENCH_BLOCK_SIZE        1024U       /* Block size of the interfaces */
+#define BENCH_LOOPS             2000U
+
+/* Private variables ---------------------------------------------------------*/
+static OPENBL_Otp_TypeDef bench_otp;
+static uint8_t bench_block[BENCH_BLOCK_SIZE];
+static clock_t bench_start;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Print the duration of a run.
+  * @param  pName: name of the run
+  * @param  Words: number of otp words handled per loop
+  * @retval None.
+  */
+static void Bench_Report(const char *pName, uint32_t Words)
+{
+  double seconds = (double)(clock() - bench_start) / CLOCKS_PER_SEC;
+
+  if (seconds <= 0.0)
+  {
+    seconds = 1.0 / CLOCKS_PER_SEC;
+  }
+
+  printf("%-28s %8.2f us per loop, %8.2f Mwords/s\n", pName, (seconds * 1000000.0) / BENCH_LOOPS,
+         ((double)Words * BENCH_LOOPS) / (seconds * 1000000.0));
+}
+
+/**
+  * @brief  Read the otp image and its statistics as uploaded.
+  * @param  None
+  * @retval None.
+  */
+static void Bench_ReadImage(void)
+{
+  uint32_t loop;
+  uint32_t offset;
+
+  bench_start = clock();
+
+  for (loop = 0U; loop < BENCH_LOOPS; loop++)
+  {
+    for (offset = 0U; offset < BENCH_IMAGE_SIZE; offset += BENCH_BLOCK_SIZE)
+    {
+      (void)OPENBL_OTP_ReadImage(offset, bench_block, BENCH_BLOCK_SIZE);
+    }
+  }
+
+  Bench_Report("otp image read", OTP_VALUE_SIZE);
+}
+
+/**
+  * @brief  Program a full otp image as downloaded, fuses blanked each loop.
+  * @param  None
+  * @retval None.
+  */
+static void Bench_WriteImage(void)
+{
+  uint32_t loop;
+  uint32_t offset;
+  uint32_t length;
+  uint32_t word;
+
+  for (word = 0U; word < OTP_VALUE_SIZE; word++)
+  {
+    bench_otp.OtpPart[2U * word] = (word * 0x9E3779B9U) | 1U;
+    bench_otp.OtpPart[(2U * word) + 1U] = OTP_REQUEST_UPDATE_MASK;
+  }
+
+  bench_start = clock();
+
+  for (loop = 0U; loop < BENCH_LOOPS; loop++)
+  {
+    OTP_Emul_Erase();
+
+    for (offset = 0U; offset < BENCH_IMAGE_SIZE; offset += length)
+    {
+      length = (BENCH_BLOCK_SIZE < (BENCH_IMAGE_SIZE - offset)) ? BENCH_BLOCK_SIZE : (BENCH_IMAGE_SIZE - offset);
+      (void)OPENBL_OTP_WriteImage(offset, ((const uint8_t *)&bench_otp) + offset, length);
+    }
+  }
+
+  Bench_Report("otp image programming", OTP_VALUE_SIZE);
+}
+
+/**
+  * @brief  Plan of a cache holding every otp word.
+  * @param  None
+  * @retval None.
+  */
+static void Bench_CacheDiff(void)
+{
+  Otp_PlanTypeDef plan;
+  uint32_t loop;
+  uint32_t word;
+
+  OTP_Emul_Erase();
+
+  bench_start = clock();
+
+  for (loop = 0U; loop < BENCH_LOOPS; loop++)
+  {
+    for (word = 0U; word < OTP_VALUE_SIZE; word++)
+    {
+      (void)OTP_Util_CacheSet(word, bench_otp.OtpPart[2U * word], 0U);
+    }
+
+    (void)OTP_Util_CacheDiff(&plan);
+    OTP_Util_CacheReset();
+  }
+
+  Bench_Report("otp cache plan", OTP_VALUE_SIZE);
+}
+
+/**
+  * @brief  Run the otp utilities benchmark.
+  * @param  None
+  * @retval 0.
+  */
+int main(void)
+{
+  OTP_Emul_ConfigTypeDef config = { 0U, 0U, 0U, OTP_EMUL_NO_ERROR_WORD, NULL };
+
+  OPENBL_OTP_Init();
+  OTP_Emul_Config(&config);
+
+  Bench_ReadImage();
+  Bench_WriteImage();
+  Bench_CacheDiff();
+
+  OPENBL_OTP_DeInit();
+
+  return 0;
+}
@@ -0,0 +1,124 @@
+/**
+  ******************************************************************************
+  * @file    bench_sha256.c
+  * @author  MCD Application Team
+  * @brief   Throughput of the software SHA-256 on full otp images, hashed
+  *          word per word as the otp hash is computed without the HASH
+  *          peripheral, and in one byte buffer for reference.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <time.h>
+#include "sha256_util.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  const char *Name;
+  uint32_t Words;       /* Number of otp values hashed */
+} Bench_ImageTypeDef;
+
+/* Private define ------------------------------------------------------------*/
+#define BENCH_WORDS_MAX         376U        /* Otp values hashed on STM32MP25 */
+#define BENCH_BYTES_MIN         (64UL << 20) /* Bytes hashed per run */
+
+/* Private variables ---------------------------------------------------------*/
+static const Bench_ImageTypeDef Images[] =
+{
+  {"STM32MP13/15 otp image", 96U},
+  {"STM32MP25 otp image", BENCH_WORDS_MAX},
+};
+
+static uint32_t Words[BENCH_WORDS_MAX];
+static uint8_t Bytes[4U * BENCH_WORDS_MAX];
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Hash an otp image repeatedly and print the throughput.
+  * @param  pImage: otp image description
+  * @param  ByWord: 1 to feed the values word per word, 0 to feed one buffer
+  * @retval None.
+  */
+static void Bench_Run(const Bench_ImageTypeDef *pImage, int ByWord)
+{
+  SHA256_Util_ContextTypeDef ctx;
+  uint8_t digest[SHA256_DIGEST_SIZE];
+  uint32_t size = 4U * pImage->Words;
+  uint32_t loops = (uint32_t)((BENCH_BYTES_MIN + size - 1U) / size);
+  uint32_t loop;
+  uint32_t idx;
+  uint8_t check = 0U;
+  clock_t start;
+  double seconds;
+
+  start = clock();
+
+  for (loop = 0U; loop < loops; loop++)
+  {
+    SHA256_Util_Init(&ctx);
+    if (ByWord != 0)
+    {
+      for (idx = 0U; idx < pImage->Words; idx++)
+      {
+        SHA256_Util_UpdateWord(&ctx, Words[idx]);
+      }
+    }
+    else
+    {
+      SHA256_Util_Update(&ctx, Bytes, size);
+    }
+    SHA256_Util_Final(&ctx, digest);
+
+    /* Keep the digests alive */
+    check ^= digest[0];
+  }
+
+  seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+  if (seconds <= 0.0)
+  {
+    seconds = 1.0 / CLOCKS_PER_SEC;
+  }
+
+  printf("%-24s %-6s %5lu bytes: %8.2f MB/s, %6.2f us per image (%02x)\n", pImage->Name,
+         (ByWord != 0) ? "words" : "bytes", (unsigned long)size,
+         ((double)size * loops) / (seconds * 1000000.0), (seconds * 1000000.0) / loops, check);
+}
+
+/**
+  * @brief  Run the SHA-256 benchmark.
+  * @param  None
+  * @retval 0.
+  */
+int main(void)
+{
+  uint32_t idx;
+
+  for (idx = 0U; idx < BENCH_WORDS_MAX; idx++)
+  {
+    Words[idx] = (idx * 0x9E3779B9U) ^ 0xA5A5A5A5U;
+    Bytes[(4U * idx) + 0U] = (uint8_t)(Words[idx] >> 24);
+    Bytes[(4U * idx) + 1U] = (uint8_t)(Words[idx] >> 16);
+    Bytes[(4U * idx) + 2U] = (uint8_t)(Words[idx] >> 8);
+    Bytes[(4U * idx) + 3U] = (uint8_t)(Words[idx] >> 0);
+  }
+
+  for (idx = 0U; idx < (sizeof(Images) / sizeof(Images[0])); idx++)
+  {
+    Bench_Run(&Images[idx], 1);
+    Bench_Run(&Images[idx], 0);
+  }
+
+  return 0;
+}
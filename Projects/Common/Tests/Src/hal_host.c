@@ -0,0 +1,178 @@
+/**
+  ******************************************************************************
+  * @file    hal_host.c
+  * @author  MCD Application Team
+  * @brief   Host stand-in of the HAL functions referenced by the utilities
+  *          built in the host tests. The HAL tick is virtual: it only
+  *          advances with HAL_Delay, so the durations measured by the
+  *          utilities are the ones of the emulated devices. The GPIO pins
+  *          are released, as pulled up on the I2C bus.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32mp13xx_hal.h"
+
+/* Private define ------------------------------------------------------------*/
+#define HOST_I2C_KERNEL_CLOCK   64000000U   /* HSI, I2C kernel clock in Hz */
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t host_tick;
+
+/* Exported variables --------------------------------------------------------*/
+BSEC_TypeDef HostBsec;
+GPIO_TypeDef HostGpioB = { 0xFFFFFFFFU, 0xFFFFFFFFU };
+GPIO_TypeDef HostGpioE = { 0xFFFFFFFFU, 0xFFFFFFFFU };
+I2C_TypeDef HostI2c4;
+uint32_t SystemCoreClock = 650000000U;
+
+/* Functions Definition ------------------------------------------------------*/
+/**
+  * @brief  Get the virtual HAL tick.
+  * @param  None
+  * @retval Tick, in ms.
+  */
+uint32_t HAL_GetTick(void)
+{
+  return host_tick;
+}
+
+/**
+  * @brief  Advance the virtual HAL tick.
+  * @param  Delay: duration, in ms.
+  * @retval None.
+  */
+void HAL_Delay(uint32_t Delay)
+{
+  host_tick += Delay;
+}
+
+/**
+  * @brief  Backup domain access, nothing to do on the host.
+  * @param  None
+  * @retval None.
+  */
+void HAL_PWR_EnableBkUpAccess(void)
+{
+}
+
+/**
+  * @brief  BSEC initialization, the fuses are emulated.
+  * @param  hBsec: pointer to the BSEC handle
+  * @retval None.
+  */
+void HAL_BSEC_Init(BSEC_HandleTypeDef *hBsec)
+{
+  hBsec->Error = BSEC_ERROR_NONE;
+}
+
+/**
+  * @brief  BSEC de-initialization, the fuses are emulated.
+  * @param  hBsec: pointer to the BSEC handle
+  * @retval None.
+  */
+void HAL_BSEC_DeInit(BSEC_HandleTypeDef *hBsec)
+{
+  UNUSED(hBsec);
+}
+
+/**
+  * @brief  Fuses power up, the fuses are emulated.
+  * @param  hBsec: pointer to the BSEC handle
+  * @param  ClkRange: BSEC clock range
+  * @retval HAL status.
+  */
+HAL_StatusTypeDef HAL_BSEC_SafMemPwrUp(BSEC_HandleTypeDef *hBsec, BSEC_SafMemClkRangeTypeDef ClkRange)
+{
+  UNUSED(hBsec);
+  UNUSED(ClkRange);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Fuses power down, the fuses are emulated.
+  * @param  hBsec: pointer to the BSEC handle
+  * @retval None.
+  */
+void HAL_BSEC_SafMemPwrDown(BSEC_HandleTypeDef *hBsec)
+{
+  UNUSED(hBsec);
+}
+
+/**
+  * @brief  GPIO configuration, nothing to do on the host.
+  * @param  GPIOx: GPIO port
+  * @param  GPIO_Init: pointer to the pins configuration
+  * @retval None.
+  */
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+  UNUSED(GPIOx);
+  UNUSED(GPIO_Init);
+}
+
+/**
+  * @brief  Read an input pin.
+  * @param  GPIOx: GPIO port
+  * @param  GPIO_Pin: pin mask
+  * @retval Pin level.
+  */
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+  return ((GPIOx->IDR & GPIO_Pin) != 0U) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+/**
+  * @brief  Drive an output pin.
+  * @param  GPIOx: GPIO port
+  * @param  GPIO_Pin: pin mask
+  * @param  PinState: pin level
+  * @retval None.
+  */
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+  if (PinState == GPIO_PIN_SET)
+  {
+    GPIOx->ODR |= GPIO_Pin;
+  }
+  else
+  {
+    GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+  }
+}
+
+/**
+  * @brief  Get a peripheral kernel clock.
+  * @param  PeriphClk: peripheral
+  * @retval Kernel clock, in Hz.
+  */
+uint32_t HAL_RCCEx_GetPeriphCLKFreq(uint64_t PeriphClk)
+{
+  UNUSED(PeriphClk);
+
+  return HOST_I2C_KERNEL_CLOCK;
+}
+
+/**
+  * @brief  Configure the I2C analog noise filter.
+  * @param  hi2c: pointer to the I2C handle
+  * @param  AnalogFilter: I2C_ANALOGFILTER_ENABLE or I2C_ANALOGFILTER_DISABLE
+  * @retval HAL status.
+  */
+HAL_StatusTypeDef HAL_I2CEx_ConfigAnalogFilter(I2C_HandleTypeDef *hi2c, uint32_t AnalogFilter)
+{
+  hi2c->Instance->CR1 = (hi2c->Instance->CR1 & ~I2C_CR1_ANFOFF) | AnalogFilter;
+
+  return HAL_OK;
+}
@@ -0,0 +1,72 @@
+/**
+  ******************************************************************************
+  * @file    test_crc32.c
+  * @author  MCD Application Team
+  * @brief   Known answer tests of the shared CRC-32
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "crc32_util.h"
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Compare a CRC-32 with the expected one.
+  * @param  pName: name of the test
+  * @param  Crc: computed CRC-32
+  * @param  Expected: expected CRC-32
+  * @retval 0 if equal, 1 otherwise.
+  */
+static int Test_Check(const char *pName, uint32_t Crc, uint32_t Expected)
+{
+  if (Crc != Expected)
+  {
+    printf("FAIL %s: 0x%08X instead of 0x%08X\n", pName, (unsigned int)Crc, (unsigned int)Expected);
+    return 1;
+  }
+
+  printf("PASS %s\n", pName);
+  return 0;
+}
+
+/**
+  * @brief  Run the CRC-32 tests.
+  * @param  None
+  * @retval 0 if all the tests passed.
+  */
+int main(void)
+{
+  static const uint8_t check[] = "123456789";
+  uint8_t zeros[32];
+  uint32_t crc;
+  uint32_t pos;
+  int fail = 0;
+
+  fail += Test_Check("empty", CRC32_Util_Compute(0U, check, 0U), 0x00000000U);
+  fail += Test_Check("check", CRC32_Util_Compute(0U, check, 9U), 0xCBF43926U);
+
+  memset(zeros, 0, sizeof(zeros));
+  fail += Test_Check("zeros", CRC32_Util_Compute(0U, zeros, sizeof(zeros)), 0x190A55ADU);
+
+  /* Chained calls over the split buffer */
+  crc = 0U;
+  for (pos = 0U; pos < 9U; pos++)
+  {
+    crc = CRC32_Util_Compute(crc, &check[pos], 1U);
+  }
+  fail += Test_Check("chained", crc, 0xCBF43926U);
+
+  return (fail == 0) ? 0 : 1;
+}
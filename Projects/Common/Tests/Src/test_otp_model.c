@@ -0,0 +1,200 @@
+/**
+  ******************************************************************************
+  * @file    test_otp_model.c
+  * @author  MCD Application Team
+  * @brief   Tests of the OTP fuses model behind the BSEC emulation
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "otp_model.h"
+
+/* Private macro -------------------------------------------------------------*/
+#define TEST_CHECK(cond)                                                        \
+  do                                                                            \
+  {                                                                             \
+    if (!(cond))                                                                \
+    {                                                                           \
+      printf("FAIL %s:%d: %s\n", __func__, __LINE__, #cond);                    \
+      fail++;                                                                   \
+    }                                                                           \
+  } while (0)
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t test_time;     /* Emulated time, in ms */
+static int fail;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Delay callback of the model, the time only advances.
+  * @param  Delay: duration in ms
+  * @retval None
+  */
+static void Test_Delay(uint32_t Delay)
+{
+  test_time += Delay;
+}
+
+/**
+  * @brief  Start from blank fuses with the given durations.
+  * @param  ProgramDelay: fuse programming duration in ms
+  * @param  ReadDelay: fuse reload duration in ms
+  * @param  ErrorWord: fuse failing on reload
+  * @retval None
+  */
+static void Test_Setup(uint32_t ProgramDelay, uint32_t ReadDelay, uint32_t ErrorWord)
+{
+  OTP_Model_ConfigTypeDef config = { ProgramDelay, ReadDelay, 0U, ErrorWord, Test_Delay };
+
+  OTP_Model_Config(&config);
+  OTP_Model_Erase();
+  test_time = 0U;
+}
+
+/**
+  * @brief  Bits are only programmed to 1 and read back after reload.
+  * @param  None
+  * @retval None
+  */
+static void Test_Program(void)
+{
+  uint32_t value;
+
+  Test_Setup(0U, 0U, OTP_MODEL_NO_ERROR_WORD);
+
+  TEST_CHECK(OTP_Model_Read(5U, &value) == OTP_MODEL_OK);
+  TEST_CHECK(value == 0U);
+
+  TEST_CHECK(OTP_Model_Program(5U, 0x0000F00FU) == OTP_MODEL_OK);
+  TEST_CHECK(OTP_Model_ReadShadow(5U, &value) == OTP_MODEL_OK);
+  TEST_CHECK(value == 0U);
+  TEST_CHECK(OTP_Model_Read(5U, &value) == OTP_MODEL_OK);
+  TEST_CHECK(value == 0x0000F00FU);
+
+  /* More bits, then a blown bit to clear */
+  TEST_CHECK(OTP_Model_Program(5U, 0x0000FF0FU) == OTP_MODEL_OK);
+  TEST_CHECK(OTP_Model_Program(5U, 0x00000F0FU) == OTP_MODEL_PROG_ERROR);
+  TEST_CHECK(OTP_Model_Read(5U, &value) == OTP_MODEL_OK);
+  TEST_CHECK(value == 0x0000FF0FU);
+
+  TEST_CHECK(OTP_Model_Program(OTP_MODEL_WORD_NUMBER, 1U) == OTP_MODEL_PARAM_ERROR);
+  TEST_CHECK(OTP_Model_Read(OTP_MODEL_WORD_NUMBER, &value) == OTP_MODEL_PARAM_ERROR);
+}
+
+/**
+  * @brief  Sticky locks last until reset, permanent locks forever.
+  * @param  None
+  * @retval None
+  */
+static void Test_Locks(void)
+{
+  uint32_t value;
+  uint32_t lock;
+
+  Test_Setup(0U, 0U, OTP_MODEL_NO_ERROR_WORD);
+
+  TEST_CHECK(OTP_Model_Lock(1U, OTP_MODEL_STICKY_PROG) == OTP_MODEL_OK);
+  TEST_CHECK(OTP_Model_Program(1U, 1U) == OTP_MODEL_STICKY_LOCKED);
+  TEST_CHECK(OTP_Model_Lock(2U, OTP_MODEL_PERM) == OTP_MODEL_OK);
+  TEST_CHECK(OTP_Model_Program(2U, 1U) == OTP_MODEL_PERM_LOCKED);
+
+  /* Reload locked: the shadow keeps its value */
+  TEST_CHECK(OTP_Model_Program(3U, 0x3U) == OTP_MODEL_OK);
+  TEST_CHECK(OTP_Model_Lock(3U, OTP_MODEL_STICKY_RELOAD) == OTP_MODEL_OK);
+  TEST_CHECK(OTP_Model_Read(3U, &value) == OTP_MODEL_STICKY_LOCKED);
+  TEST_CHECK(value == 0U);
+
+  OTP_Model_Reset();
+
+  TEST_CHECK(OTP_Model_GetLock(1U, &lock) == OTP_MODEL_OK);
+  TEST_CHECK(lock == 0U);
+  TEST_CHECK(OTP_Model_Program(1U, 1U) == OTP_MODEL_OK);
+  TEST_CHECK(OTP_Model_GetLock(2U, &lock) == OTP_MODEL_OK);
+  TEST_CHECK(lock == OTP_MODEL_PERM);
+  TEST_CHECK(OTP_Model_Program(2U, 1U) == OTP_MODEL_PERM_LOCKED);
+  TEST_CHECK(OTP_Model_Read(3U, &value) == OTP_MODEL_OK);
+  TEST_CHECK(value == 0x3U);
+}
+
+/**
+  * @brief  The configured fuse fails on reload and flags its shadow.
+  * @param  None
+  * @retval None
+  */
+static void Test_ReadError(void)
+{
+  uint32_t value;
+  uint32_t lock;
+
+  Test_Setup(0U, 0U, 7U);
+
+  TEST_CHECK(OTP_Model_Program(7U, 0x70U) == OTP_MODEL_OK);
+  TEST_CHECK(OTP_Model_Read(7U, &value) == OTP_MODEL_READ_ERROR);
+  TEST_CHECK(OTP_Model_GetLock(7U, &lock) == OTP_MODEL_OK);
+  TEST_CHECK((lock & OTP_MODEL_SHADOW_ERROR) != 0U);
+  TEST_CHECK(OTP_Model_Read(6U, &value) == OTP_MODEL_OK);
+}
+
+/**
+  * @brief  Durations are waited through the delay callback only.
+  * @param  None
+  * @retval None
+  */
+static void Test_Timing(void)
+{
+  OTP_Model_ConfigTypeDef config = { 10U, 1U, 0U, OTP_MODEL_NO_ERROR_WORD, NULL };
+  uint32_t value;
+
+  Test_Setup(10U, 1U, OTP_MODEL_NO_ERROR_WORD);
+
+  TEST_CHECK(OTP_Model_Program(0U, 1U) == OTP_MODEL_OK);
+  TEST_CHECK(OTP_Model_Read(0U, &value) == OTP_MODEL_OK);
+  TEST_CHECK(test_time == 11U);
+
+  /* Sticky locks are register writes, the permanent lock a programming */
+  TEST_CHECK(OTP_Model_Lock(0U, OTP_MODEL_STICKY_PROG) == OTP_MODEL_OK);
+  TEST_CHECK(test_time == 11U);
+  TEST_CHECK(OTP_Model_Lock(0U, OTP_MODEL_PERM) == OTP_MODEL_OK);
+  TEST_CHECK(test_time == 21U);
+
+  /* A locked fuse fails at once */
+  TEST_CHECK(OTP_Model_Program(0U, 1U) == OTP_MODEL_PERM_LOCKED);
+  TEST_CHECK(test_time == 21U);
+
+  /* A reset reloads every fuse */
+  OTP_Model_Reset();
+  TEST_CHECK(test_time == (21U + OTP_MODEL_WORD_NUMBER));
+
+  /* Without callback nothing is waited */
+  OTP_Model_Config(&config);
+  TEST_CHECK(OTP_Model_Program(1U, 1U) == OTP_MODEL_OK);
+  TEST_CHECK(test_time == (21U + OTP_MODEL_WORD_NUMBER));
+}
+
+/**
+  * @brief  Run the OTP fuses model tests.
+  * @param  None
+  * @retval 0 if all the tests passed.
+  */
+int main(void)
+{
+  Test_Program();
+  Test_Locks();
+  Test_ReadError();
+  Test_Timing();
+
+  printf("%s otp model\n", (fail == 0) ? "PASS" : "FAIL");
+
+  return (fail == 0) ? 0 : 1;
+}
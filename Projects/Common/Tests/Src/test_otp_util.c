@@ -0,0 +1,487 @@
+/**
+  ******************************************************************************
+  * @file    test_otp_util.c
+  * @author  MCD Application Team
+  * @brief   Tests of the otp utilities and of the otp interface records on
+  *          the emulated fuses: fuse programming and locks, cache plan,
+  *          otp image split in blocks, delta, read mode and statistics
+  *          records, durations measured on the emulated fuses.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "otp_interface.h"
+#include "otp_emul.h"
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_IMAGE_SIZE         ((uint32_t)sizeof(OPENBL_Otp_TypeDef))
+#define TEST_STATS_SIZE         (OTP_STATS_RECORD_SIZE * 4U)
+#define TEST_DELTA_ENTRIES      4U
+
+/* Private macro -------------------------------------------------------------*/
+#define TEST_CHECK(cond)                                                        \
+  do                                                                            \
+  {                                                                             \
+    if (!(cond))                                                                \
+    {                                                                           \
+      printf("FAIL %s:%d: %s\n", __func__, __LINE__, #cond);                    \
+      fail++;                                                                   \
+    }                                                                           \
+  } while (0)
+
+/* Private variables ---------------------------------------------------------*/
+static OPENBL_Otp_TypeDef test_otp;
+static uint8_t test_image[TEST_IMAGE_SIZE + TEST_STATS_SIZE];
+static uint8_t test_record[OTP_DELTA_HEADER_SIZE + (TEST_DELTA_ENTRIES * OTP_DELTA_ENTRY_SIZE)];
+static int fail;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Start from blank fuses with the given durations.
+  * @param  ProgramDelay: fuse programming duration in ms
+  * @param  ReadDelay: fuse reload duration in ms
+  * @param  ErrorWord: fuse failing on reload
+  * @retval None
+  */
+static void Test_Setup(uint32_t ProgramDelay, uint32_t ReadDelay, uint32_t ErrorWord)
+{
+  OTP_Emul_ConfigTypeDef config = { ProgramDelay, ReadDelay, 0U, ErrorWord, NULL };
+
+  OTP_Emul_Config(&config);
+  OTP_Emul_Erase();
+  OTP_Util_CacheReset();
+  OTP_Util_ResetProgStats();
+  OTP_Util_SetReadMode(OTP_READ_RELOAD);
+}
+
+/**
+  * @brief  Read one otp word and its status through the otp utilities.
+  * @param  Word: otp word number
+  * @param  pStat: pointer to the otp status
+  * @retval Otp value.
+  */
+static uint32_t Test_Read(uint32_t Word, uint32_t *pStat)
+{
+  (void)OTP_Util_ReadRange(Word, 1U, &test_otp);
+  *pStat = test_otp.OtpPart[(2U * Word) + 1U];
+
+  return test_otp.OtpPart[2U * Word];
+}
+
+/**
+  * @brief  Store a little endian word in a record.
+  * @param  pDest: pointer to the record bytes
+  * @param  Value: word value
+  * @retval None
+  */
+static void Test_Put(uint8_t *pDest, uint32_t Value)
+{
+  pDest[0] = (uint8_t)(Value >> 0);
+  pDest[1] = (uint8_t)(Value >> 8);
+  pDest[2] = (uint8_t)(Value >> 16);
+  pDest[3] = (uint8_t)(Value >> 24);
+}
+
+/**
+  * @brief  Build an otp delta record header.
+  * @param  Flags: record flags
+  * @param  Entries: number of entries announced
+  * @retval None
+  */
+static void Test_DeltaHeader(uint32_t Flags, uint32_t Entries)
+{
+  Test_Put(&test_record[0], OTP_DELTA_MAGIC);
+  Test_Put(&test_record[4], Flags);
+  Test_Put(&test_record[8], Entries);
+}
+
+/**
+  * @brief  Set an otp delta record entry.
+  * @param  Index: entry number
+  * @param  Word: otp word number
+  * @param  Value: target value
+  * @param  Stat: requested lock bits
+  * @retval None
+  */
+static void Test_DeltaEntry(uint32_t Index, uint32_t Word, uint32_t Value, uint32_t Stat)
+{
+  uint8_t *pEntry = &test_record[OTP_DELTA_HEADER_SIZE + (Index * OTP_DELTA_ENTRY_SIZE)];
+
+  Test_Put(&pEntry[0], Word);
+  Test_Put(&pEntry[4], Value);
+  Test_Put(&pEntry[8], Stat);
+}
+
+/**
+  * @brief  Bits are only programmed to 1, a 1 to 0 transition is rejected.
+  * @param  None
+  * @retval None
+  */
+static void Test_Program(void)
+{
+  uint32_t stat;
+
+  Test_Setup(0U, 0U, OTP_EMUL_NO_ERROR_WORD);
+
+  TEST_CHECK(OTP_Util_WriteWord(5U, 0x0000F00FU, 0U) == OTP_OK);
+  TEST_CHECK(Test_Read(5U, &stat) == 0x0000F00FU);
+  TEST_CHECK(stat == 0U);
+
+  /* More bits can be blown */
+  TEST_CHECK(OTP_Util_WriteWord(5U, 0x0000FF0FU, 0U) == OTP_OK);
+  TEST_CHECK(Test_Read(5U, &stat) == 0x0000FF0FU);
+
+  /* A blown bit cannot be cleared, the fuse is unchanged */
+  TEST_CHECK(OTP_Util_WriteWord(5U, 0x000000F0U, 0U) == OTP_ERROR);
+  TEST_CHECK(Test_Read(5U, &stat) == 0x0000FF0FU);
+
+  /* Out of the otp area */
+  TEST_CHECK(OTP_Util_WriteWord(OTP_VALUE_SIZE, 1U, 0U) == OTP_ERROR);
+  TEST_CHECK(OTP_Util_ReadRange(OTP_VALUE_SIZE - 1U, 2U, &test_otp) == OTP_ERROR);
+}
+
+/**
+  * @brief  Sticky locks last until reset, the permanent lock forever.
+  * @param  None
+  * @retval None
+  */
+static void Test_Locks(void)
+{
+  uint32_t stat;
+
+  Test_Setup(0U, 0U, OTP_EMUL_NO_ERROR_WORD);
+
+  /* Value and sticky programming lock */
+  TEST_CHECK(OTP_Util_WriteWord(10U, 0x1U, OTP_STICKY_PROG_LOCK_MASK) == OTP_OK);
+  TEST_CHECK(Test_Read(10U, &stat) == 0x1U);
+  TEST_CHECK(stat == OTP_STICKY_PROG_LOCK_MASK);
+  TEST_CHECK(OTP_Util_WriteWord(10U, 0x3U, 0U) == OTP_ERROR);
+
+  /* Value and permanent lock */
+  TEST_CHECK(OTP_Util_WriteWord(11U, 0x2U, OTP_PERM_LOCK_MASK) == OTP_OK);
+  TEST_CHECK(Test_Read(11U, &stat) == 0x2U);
+  TEST_CHECK(stat == OTP_PERM_LOCK_MASK);
+  TEST_CHECK(OTP_Util_WriteWord(11U, 0x3U, 0U) == OTP_ERROR);
+
+  /* A reset only releases the sticky lock */
+  OTP_Emul_Reset();
+  TEST_CHECK(OTP_Util_WriteWord(10U, 0x3U, 0U) == OTP_OK);
+  TEST_CHECK(Test_Read(10U, &stat) == 0x3U);
+  TEST_CHECK(stat == 0U);
+  TEST_CHECK(OTP_Util_WriteWord(11U, 0x3U, 0U) == OTP_ERROR);
+  TEST_CHECK(Test_Read(11U, &stat) == 0x2U);
+  TEST_CHECK(stat == OTP_PERM_LOCK_MASK);
+}
+
+/**
+  * @brief  The cache plan drops what is done and rejects what is impossible.
+  * @param  None
+  * @retval None
+  */
+static void Test_Cache(void)
+{
+  Otp_PlanTypeDef plan;
+  uint32_t stat;
+
+  Test_Setup(0U, 0U, OTP_EMUL_NO_ERROR_WORD);
+  TEST_CHECK(OTP_Util_WriteWord(1U, 0x00FFU, 0U) == OTP_OK);
+  TEST_CHECK(OTP_Util_WriteWord(2U, 0x0F00U, 0U) == OTP_OK);
+  TEST_CHECK(OTP_Util_WriteWord(3U, 0x1U, OTP_PERM_LOCK_MASK) == OTP_OK);
+
+  /* Already done, bits to blow, lock only, 1 to 0 and locked word */
+  TEST_CHECK(OTP_Util_CacheSet(1U, 0x00FFU, 0U) == OTP_OK);
+  TEST_CHECK(OTP_Util_CacheSet(2U, 0x0FF0U, 0U) == OTP_OK);
+  TEST_CHECK(OTP_Util_CacheSet(4U, 0U, OTP_STICKY_WRITE_LOCK_MASK) == OTP_OK);
+  TEST_CHECK(OTP_Util_CacheSet(40U, 0x8U, 0U) == OTP_OK);
+  TEST_CHECK(OTP_Util_CacheSet(OTP_VALUE_SIZE, 0x1U, 0U) == OTP_ERROR);
+
+  TEST_CHECK(OTP_Util_CacheDiff(&plan) == OTP_OK);
+  TEST_CHECK(plan.SkipCount == 1U);
+  TEST_CHECK(plan.ProgramCount == 2U);
+  TEST_CHECK(plan.LockCount == 1U);
+  TEST_CHECK(plan.ErrorCount == 0U);
+
+  /* One impossible word rejects the whole plan, nothing is blown */
+  TEST_CHECK(OTP_Util_CacheSet(2U, 0x00F0U, 0U) == OTP_OK);
+  TEST_CHECK(OTP_Util_CacheSet(3U, 0x3U, 0U) == OTP_OK);
+  TEST_CHECK(OTP_Util_CacheApply(&plan) == OTP_ERROR);
+  TEST_CHECK(plan.ErrorCount == 2U);
+  TEST_CHECK(plan.FirstError == 2U);
+  TEST_CHECK(Test_Read(2U, &stat) == 0x0F00U);
+  TEST_CHECK(Test_Read(40U, &stat) == 0U);
+  TEST_CHECK(Test_Read(4U, &stat) == 0U);
+  TEST_CHECK(stat == 0U);
+
+  /* The rejected plan is dropped, a new one is applied */
+  TEST_CHECK(OTP_Util_CacheDiff(&plan) == OTP_OK);
+  TEST_CHECK((plan.ProgramCount + plan.LockCount + plan.SkipCount) == 0U);
+  TEST_CHECK(OTP_Util_CacheSet(2U, 0x0FF0U, 0U) == OTP_OK);
+  TEST_CHECK(OTP_Util_CacheSet(4U, 0U, OTP_STICKY_WRITE_LOCK_MASK) == OTP_OK);
+  TEST_CHECK(OTP_Util_CacheApply(&plan) == OTP_OK);
+  TEST_CHECK(plan.ProgramCount == 1U);
+  TEST_CHECK(plan.LockCount == 1U);
+  TEST_CHECK(Test_Read(2U, &stat) == 0x0FF0U);
+  TEST_CHECK(Test_Read(4U, &stat) == 0U);
+  TEST_CHECK(stat == OTP_STICKY_WRITE_LOCK_MASK);
+}
+
+/**
+  * @brief  Delta records are cached until commit, malformed ones rejected.
+  * @param  None
+  * @retval None
+  */
+static void Test_Delta(void)
+{
+  uint32_t size = OTP_DELTA_HEADER_SIZE + (2U * OTP_DELTA_ENTRY_SIZE);
+  uint32_t stat;
+
+  Test_Setup(0U, 0U, OTP_EMUL_NO_ERROR_WORD);
+
+  /* Not a delta record */
+  TEST_CHECK(OPENBL_OTP_DeltaRecord(test_record, OTP_DELTA_HEADER_SIZE - 1U) == OTP_RECORD_NONE);
+  Test_Put(&test_record[0], OTP_STATS_MAGIC);
+  TEST_CHECK(OPENBL_OTP_DeltaRecord(test_record, sizeof(test_record)) == OTP_RECORD_NONE);
+
+  /* Cached, then programmed by an empty commit record */
+  Test_DeltaHeader(0U, 2U);
+  Test_DeltaEntry(0U, 20U, 0x12U, 0U);
+  Test_DeltaEntry(1U, 21U, 0U, OTP_STICKY_PROG_LOCK_MASK);
+  TEST_CHECK(OPENBL_OTP_DeltaRecord(test_record, size) == OTP_OK);
+  TEST_CHECK(Test_Read(20U, &stat) == 0U);
+
+  Test_DeltaHeader(OTP_DELTA_COMMIT, 0U);
+  TEST_CHECK(OPENBL_OTP_DeltaRecord(test_record, OTP_DELTA_HEADER_SIZE) == OTP_OK);
+  TEST_CHECK(Test_Read(20U, &stat) == 0x12U);
+  TEST_CHECK(Test_Read(21U, &stat) == 0U);
+  TEST_CHECK(stat == OTP_STICKY_PROG_LOCK_MASK);
+
+  /* More entries announced than received, the cache is dropped */
+  Test_DeltaHeader(0U, 1U);
+  Test_DeltaEntry(0U, 22U, 0x1U, 0U);
+  TEST_CHECK(OPENBL_OTP_DeltaRecord(test_record, size - OTP_DELTA_ENTRY_SIZE) == OTP_OK);
+  Test_DeltaHeader(OTP_DELTA_COMMIT, 2U);
+  TEST_CHECK(OPENBL_OTP_DeltaRecord(test_record, size - 1U) == OTP_RECORD_INVALID);
+  Test_DeltaHeader(OTP_DELTA_COMMIT, 0U);
+  TEST_CHECK(OPENBL_OTP_DeltaRecord(test_record, OTP_DELTA_HEADER_SIZE) == OTP_OK);
+  TEST_CHECK(Test_Read(22U, &stat) == 0U);
+
+  /* Word out of the otp area */
+  Test_DeltaHeader(OTP_DELTA_COMMIT, 1U);
+  Test_DeltaEntry(0U, OTP_VALUE_SIZE, 0x1U, 0U);
+  TEST_CHECK(OPENBL_OTP_DeltaRecord(test_record, size) == OTP_RECORD_INVALID);
+
+  /* Commit of an impossible plan, nothing is programmed */
+  Test_DeltaHeader(OTP_DELTA_COMMIT, 2U);
+  Test_DeltaEntry(0U, 23U, 0x1U, 0U);
+  Test_DeltaEntry(1U, 20U, 0x01U, 0U);
+  TEST_CHECK(OPENBL_OTP_DeltaRecord(test_record, size) == OTP_ERROR);
+  TEST_CHECK(Test_Read(23U, &stat) == 0U);
+  TEST_CHECK(Test_Read(20U, &stat) == 0x12U);
+}
+
+/**
+  * @brief  The otp image is programmed and read in blocks of any size.
+  * @param  None
+  * @retval None
+  */
+static void Test_Image(void)
+{
+  static const uint32_t blocks[] = { 1U, 7U, 8U, 13U, 64U, 255U, 512U };
+  OPENBL_Otp_TypeDef image;
+  uint32_t offset;
+  uint32_t length;
+  uint32_t total;
+  uint32_t word;
+  uint32_t idx;
+  uint32_t stat;
+  int ret;
+
+  for (idx = 0U; idx < (sizeof(blocks) / sizeof(blocks[0])); idx++)
+  {
+    Test_Setup(0U, 0U, OTP_EMUL_NO_ERROR_WORD);
+
+    /* Every third word requests an update, the others must be left blank */
+    memset(&image, 0, sizeof(image));
+    for (word = 0U; word < OTP_VALUE_SIZE; word++)
+    {
+      image.OtpPart[2U * word] = (word * 0x9E3779B9U) | 1U;
+      image.OtpPart[(2U * word) + 1U] = ((word % 3U) == 0U) ? OTP_REQUEST_UPDATE_MASK : 0U;
+    }
+    image.OtpPart[(2U * 9U) + 1U] |= OTP_STICKY_PROG_LOCK_MASK;
+
+    ret = OTP_OK;
+    for (offset = 0U; offset < TEST_IMAGE_SIZE; offset += length)
+    {
+      length = (blocks[idx] < (TEST_IMAGE_SIZE - offset)) ? blocks[idx] : (TEST_IMAGE_SIZE - offset);
+      ret = OPENBL_OTP_WriteImage(offset, ((const uint8_t *)&image) + offset, length);
+    }
+    TEST_CHECK(ret == OTP_OK);
+
+    /* Image and statistics read back in blocks of the same size */
+    total = 0U;
+    for (offset = 0U; offset < sizeof(test_image); offset += length)
+    {
+      length = (blocks[idx] < (sizeof(test_image) - offset)) ? blocks[idx] : (sizeof(test_image) - offset);
+      total += OPENBL_OTP_ReadImage(offset, &test_image[offset], length);
+    }
+    TEST_CHECK(total == sizeof(test_image));
+
+    OTP_Util_Read(&test_otp);
+    TEST_CHECK(memcmp(test_image, &test_otp, TEST_IMAGE_SIZE) == 0);
+    TEST_CHECK(test_otp.Version == OPENBL_OTP_VERSION);
+    TEST_CHECK(test_otp.GlobalState == BSEC_SEC_OTP_OPEN);
+
+    for (word = 0U; word < OTP_VALUE_SIZE; word++)
+    {
+      TEST_CHECK(Test_Read(word, &stat) == (((word % 3U) == 0U) ? image.OtpPart[2U * word] : 0U));
+    }
+    TEST_CHECK(Test_Read(9U, &stat) == image.OtpPart[2U * 9U]);
+    TEST_CHECK(stat == OTP_STICKY_PROG_LOCK_MASK);
+
+    /* Statistics record after the image */
+    TEST_CHECK(memcmp(&test_image[TEST_IMAGE_SIZE], "SOS1", 4U) == 0);
+    TEST_CHECK(test_image[TEST_IMAGE_SIZE + 4U] == ((OTP_VALUE_SIZE + 2U) / 3U));
+  }
+
+  /* A failing word fails the image, the sticky locked word 9 cannot be programmed again */
+  image.OtpPart[2U * 9U] |= 0x80000000U;
+  ret = OTP_OK;
+  for (offset = 0U; offset < TEST_IMAGE_SIZE; offset += length)
+  {
+    length = (100U < (TEST_IMAGE_SIZE - offset)) ? 100U : (TEST_IMAGE_SIZE - offset);
+    ret = OPENBL_OTP_WriteImage(offset, ((const uint8_t *)&image) + offset, length);
+  }
+  TEST_CHECK(ret == OTP_ERROR);
+
+  /* The next image starts without error */
+  memset(&image, 0, sizeof(image));
+  TEST_CHECK(OPENBL_OTP_WriteImage(0U, (const uint8_t *)&image, TEST_IMAGE_SIZE) == OTP_OK);
+}
+
+/**
+  * @brief  Read mode and statistics records.
+  * @param  None
+  * @retval None
+  */
+static void Test_Records(void)
+{
+  uint32_t stats[OTP_STATS_RECORD_SIZE];
+  uint8_t record[8];
+  Otp_ReadStatsTypeDef read;
+
+  Test_Setup(0U, 0U, OTP_EMUL_NO_ERROR_WORD);
+
+  /* Read mode record */
+  Test_Put(&record[0], OTP_READ_MODE_MAGIC);
+  Test_Put(&record[4], OTP_READ_SHADOW);
+  TEST_CHECK(OPENBL_OTP_ReadModeRecord(record, 7U) == OTP_ERROR);
+  TEST_CHECK(OPENBL_OTP_ReadModeRecord(record, 8U) == OTP_OK);
+  TEST_CHECK(OTP_Util_GetReadMode() == OTP_READ_SHADOW);
+
+  /* Shadow reads need the new BSEC API, every fuse is reloaded */
+  OTP_Util_Read(&test_otp);
+  OTP_Util_GetReadStats(&read);
+  TEST_CHECK(read.ShadowCount == 0U);
+  TEST_CHECK(read.ReloadCount == OTP_VALUE_SIZE);
+
+  Test_Put(&record[4], 0x1234U);
+  TEST_CHECK(OPENBL_OTP_ReadModeRecord(record, 8U) == OTP_OK);
+  TEST_CHECK(OTP_Util_GetReadMode() == OTP_READ_RELOAD);
+  Test_Put(&record[0], OTP_DELTA_MAGIC);
+  TEST_CHECK(OPENBL_OTP_ReadModeRecord(record, 8U) == OTP_ERROR);
+
+  /* Failing fuses are listed once */
+  TEST_CHECK(OTP_Util_WriteWord(30U, 0x1U, OTP_PERM_LOCK_MASK) == OTP_OK);
+  TEST_CHECK(OTP_Util_WriteWord(30U, 0x2U, 0U) == OTP_ERROR);
+  TEST_CHECK(OTP_Util_WriteWord(30U, 0x2U, 0U) == OTP_ERROR);
+  OPENBL_OTP_GetStats(stats);
+  TEST_CHECK(stats[0] == OTP_STATS_MAGIC);
+  TEST_CHECK(stats[1U + (OTP_OP_PROGRAM * OTP_STATS_OP_SIZE)] == 3U);
+  TEST_CHECK(stats[1U + (OTP_OP_PROGRAM * OTP_STATS_OP_SIZE) + 4U] == 2U);
+  TEST_CHECK(stats[1U + (OTP_OP_PERM_LOCK * OTP_STATS_OP_SIZE)] == 1U);
+  TEST_CHECK(stats[1U + (OTP_OP_NUMBER * OTP_STATS_OP_SIZE)] == 1U);
+  TEST_CHECK(stats[2U + (OTP_OP_NUMBER * OTP_STATS_OP_SIZE)] == 30U);
+
+  /* Statistics record resets them */
+  Test_Put(&record[0], OTP_STATS_MAGIC);
+  TEST_CHECK(OPENBL_OTP_StatsRecord(record, 3U) == OTP_ERROR);
+  TEST_CHECK(OPENBL_OTP_StatsRecord(record, 4U) == OTP_OK);
+  OPENBL_OTP_GetStats(stats);
+  TEST_CHECK(stats[1U + (OTP_OP_PROGRAM * OTP_STATS_OP_SIZE)] == 0U);
+  TEST_CHECK(stats[1U + (OTP_OP_NUMBER * OTP_STATS_OP_SIZE)] == 0U);
+}
+
+/**
+  * @brief  Durations of the emulated fuses are measured and reported.
+  * @param  None
+  * @retval None
+  */
+static void Test_Timing(void)
+{
+  Otp_ProgStatsTypeDef stats;
+  Otp_ReadStatsTypeDef read;
+  uint32_t start;
+  uint32_t stat;
+
+  Test_Setup(2U, 1U, 50U);
+
+  start = HAL_GetTick();
+  TEST_CHECK(OTP_Util_WriteWord(1U, 0x1U, OTP_PERM_LOCK_MASK) == OTP_OK);
+  TEST_CHECK(OTP_Util_WriteWord(2U, 0x1U, OTP_STICKY_PROG_LOCK_MASK) == OTP_OK);
+  TEST_CHECK((HAL_GetTick() - start) == 6U);
+
+  OTP_Util_GetProgStats(&stats);
+  TEST_CHECK(stats.Op[OTP_OP_PROGRAM].Count == 2U);
+  TEST_CHECK(stats.Op[OTP_OP_PROGRAM].Min == 2000U);
+  TEST_CHECK(stats.Op[OTP_OP_PROGRAM].Max == 2000U);
+  TEST_CHECK(stats.Op[OTP_OP_PERM_LOCK].Total == 2000U);
+  TEST_CHECK(stats.Op[OTP_OP_STICKY_LOCK].Total == 0U);
+
+  /* A full read reloads each fuse, the failing one is reported */
+  OTP_Util_Read(&test_otp);
+  OTP_Util_GetReadStats(&read);
+  TEST_CHECK(read.Ticks == OTP_VALUE_SIZE);
+  TEST_CHECK(Test_Read(50U, &stat) == 0U);
+  TEST_CHECK(stat == OTP_READ_ERROR);
+
+  OTP_Util_GetProgStats(&stats);
+  TEST_CHECK(stats.Op[OTP_OP_READ].Max == 1000U);
+  TEST_CHECK(stats.Op[OTP_OP_READ].Errors == 2U);
+  TEST_CHECK(stats.FailCount == 1U);
+  TEST_CHECK(stats.FailWord[0] == 50U);
+}
+
+/**
+  * @brief  Run the otp utilities tests.
+  * @param  None
+  * @retval 0 if all the tests passed.
+  */
+int main(void)
+{
+  OPENBL_OTP_Init();
+
+  Test_Program();
+  Test_Locks();
+  Test_Cache();
+  Test_Delta();
+  Test_Image();
+  Test_Records();
+  Test_Timing();
+
+  OPENBL_OTP_DeInit();
+
+  printf("%s otp utilities\n", (fail == 0) ? "PASS" : "FAIL");
+
+  return (fail == 0) ? 0 : 1;
+}
@@ -0,0 +1,254 @@
+/**
+  ******************************************************************************
+  * @file    test_pmic_model.c
+  * @author  GPM Application Team
+  * @brief   Tests of the STPMIC register map model behind the PMIC emulation
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "pmic_model.h"
+
+/* Private define ------------------------------------------------------------*/
+/* STPMIC25 register map */
+#define TEST_NVM_START        0x90U
+#define TEST_NVM_SIZE         40U
+#define TEST_NVM_SR           0x8EU
+#define TEST_NVM_CR           0x8FU
+
+/* Private macro -------------------------------------------------------------*/
+#define TEST_CHECK(cond)                                                        \
+  do                                                                            \
+  {                                                                             \
+    if (!(cond))                                                                \
+    {                                                                           \
+      printf("FAIL %s:%d: %s\n", __func__, __LINE__, #cond);                    \
+      fail++;                                                                   \
+    }                                                                           \
+  } while (0)
+
+/* Private variables ---------------------------------------------------------*/
+static uint32_t test_time;     /* Emulated time, in us */
+static int fail;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Time callback of the model.
+  * @param  None
+  * @retval Emulated time, in us
+  */
+static uint32_t Test_Time(void)
+{
+  return test_time;
+}
+
+/**
+  * @brief  Start from a blank NVM.
+  * @param  Type: modeled PMIC
+  * @param  ProgramDelay: NVM programming duration in ms
+  * @param  NackCount: number of transfers not acknowledged
+  * @retval None
+  */
+static void Test_Setup(uint32_t Type, uint32_t ProgramDelay, uint32_t NackCount)
+{
+  PMIC_Model_ConfigTypeDef config = { Type, ProgramDelay, NackCount, Test_Time };
+
+  PMIC_Model_Erase();
+  PMIC_Model_Config(&config);
+  PMIC_Model_ResetStats();
+  test_time = 0U;
+}
+
+/**
+  * @brief  The product ID identifies the PMIC, its absence is a NACK.
+  * @param  None
+  * @retval None
+  */
+static void Test_Detect(void)
+{
+  PMIC_Model_StatsTypeDef stats;
+  uint8_t id = 0U;
+
+  Test_Setup(PMIC_MODEL_STPMIC25, 0U, 0U);
+  TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, PMIC_MODEL_PRODUCT_ID_ADDR, &id, 1U) == PMIC_MODEL_OK);
+  TEST_CHECK(id == 0x21U);
+
+  Test_Setup(PMIC_MODEL_STPMIC1, 0U, 0U);
+  TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, PMIC_MODEL_PRODUCT_ID_ADDR, &id, 1U) == PMIC_MODEL_OK);
+  TEST_CHECK(id == 0x01U);
+
+  /* Wrong address, no PMIC, then the configured NACKs */
+  TEST_CHECK(PMIC_Model_Read(0x10U, PMIC_MODEL_PRODUCT_ID_ADDR, &id, 1U) == PMIC_MODEL_NACK);
+
+  Test_Setup(PMIC_MODEL_NONE, 0U, 0U);
+  TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, PMIC_MODEL_PRODUCT_ID_ADDR, &id, 1U) == PMIC_MODEL_NACK);
+
+  Test_Setup(PMIC_MODEL_STPMIC25, 0U, 2U);
+  TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, PMIC_MODEL_PRODUCT_ID_ADDR, &id, 1U) == PMIC_MODEL_NACK);
+  TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, PMIC_MODEL_PRODUCT_ID_ADDR, &id, 1U) == PMIC_MODEL_NACK);
+  TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, PMIC_MODEL_PRODUCT_ID_ADDR, &id, 1U) == PMIC_MODEL_OK);
+
+  PMIC_Model_GetStats(&stats);
+  TEST_CHECK(stats.NackCount == 2U);
+  TEST_CHECK(stats.ReadCount == 1U);
+  TEST_CHECK(stats.ReadBytes == 1U);
+
+  /* Registers out of the map */
+  TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, 0xFFU, &id, 2U) == PMIC_MODEL_PARAM_ERROR);
+  TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, 0x00U, &id, 0U) == PMIC_MODEL_PARAM_ERROR);
+}
+
+/**
+  * @brief  Shadow registers are only kept over a reset once programmed.
+  * @param  None
+  * @retval None
+  */
+static void Test_Program(void)
+{
+  PMIC_Model_StatsTypeDef stats;
+  uint8_t image[TEST_NVM_SIZE];
+  uint8_t shadow[TEST_NVM_SIZE];
+  uint8_t cmd = PMIC_MODEL_NVM_CMD_PROGRAM;
+  uint8_t status;
+  uint8_t idx;
+
+  for (idx = 0U; idx < TEST_NVM_SIZE; idx++)
+  {
+    image[idx] = (uint8_t)(idx + 1U);
+  }
+
+  Test_Setup(PMIC_MODEL_STPMIC25, 0U, 0U);
+  TEST_CHECK(PMIC_Model_Write(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_START, image, TEST_NVM_SIZE) == PMIC_MODEL_OK);
+
+  /* Not programmed: lost on reset */
+  PMIC_Model_Reset();
+  TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_START, shadow, TEST_NVM_SIZE) == PMIC_MODEL_OK);
+  TEST_CHECK(shadow[0] == 0U);
+  TEST_CHECK(shadow[TEST_NVM_SIZE - 1U] == 0U);
+
+  TEST_CHECK(PMIC_Model_Write(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_START, image, TEST_NVM_SIZE) == PMIC_MODEL_OK);
+  TEST_CHECK(PMIC_Model_Write(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_CR, &cmd, 1U) == PMIC_MODEL_OK);
+  TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_SR, &status, 1U) == PMIC_MODEL_OK);
+  TEST_CHECK((status & PMIC_MODEL_NVM_BUSY_MSK) == 0U);
+
+  /* Programmed: reloaded on reset */
+  PMIC_Model_Reset();
+  TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_START, shadow, TEST_NVM_SIZE) == PMIC_MODEL_OK);
+  TEST_CHECK(memcmp(shadow, image, TEST_NVM_SIZE) == 0);
+
+  /* Reload command restores the NVM over modified shadow registers */
+  memset(shadow, 0xA5, sizeof(shadow));
+  TEST_CHECK(PMIC_Model_Write(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_START, shadow, TEST_NVM_SIZE) == PMIC_MODEL_OK);
+  cmd = PMIC_MODEL_NVM_CMD_READ;
+  TEST_CHECK(PMIC_Model_Write(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_CR, &cmd, 1U) == PMIC_MODEL_OK);
+  TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_START, shadow, TEST_NVM_SIZE) == PMIC_MODEL_OK);
+  TEST_CHECK(memcmp(shadow, image, TEST_NVM_SIZE) == 0);
+
+  /* Product ID and NVM status are read only */
+  status = 0xFFU;
+  TEST_CHECK(PMIC_Model_Write(PMIC_MODEL_I2C_ADDRESS, PMIC_MODEL_PRODUCT_ID_ADDR, &status, 1U) == PMIC_MODEL_OK);
+  TEST_CHECK(PMIC_Model_Write(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_SR, &status, 1U) == PMIC_MODEL_OK);
+  TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, PMIC_MODEL_PRODUCT_ID_ADDR, &status, 1U) == PMIC_MODEL_OK);
+  TEST_CHECK(status == 0x21U);
+  TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_SR, &status, 1U) == PMIC_MODEL_OK);
+  TEST_CHECK(status == 0U);
+
+  PMIC_Model_GetStats(&stats);
+  TEST_CHECK(stats.ProgCount == 1U);
+  TEST_CHECK(stats.BusyPolls == 0U);
+}
+
+/**
+  * @brief  The NVM status stays busy for the programming duration.
+  * @param  None
+  * @retval None
+  */
+static void Test_Busy(void)
+{
+  PMIC_Model_StatsTypeDef stats;
+  uint8_t image[TEST_NVM_SIZE];
+  uint8_t shadow[TEST_NVM_SIZE];
+  uint8_t cmd = PMIC_MODEL_NVM_CMD_PROGRAM;
+  uint8_t status;
+  uint32_t polls = 0U;
+
+  memset(image, 0x5A, sizeof(image));
+
+  Test_Setup(PMIC_MODEL_STPMIC25, 30U, 0U);
+  TEST_CHECK(PMIC_Model_Write(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_START, image, TEST_NVM_SIZE) == PMIC_MODEL_OK);
+  TEST_CHECK(PMIC_Model_Write(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_CR, &cmd, 1U) == PMIC_MODEL_OK);
+
+  /* Polled every ms until ready */
+  do
+  {
+    TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_SR, &status, 1U) == PMIC_MODEL_OK);
+    polls++;
+    test_time += 1000U;
+  } while (((status & PMIC_MODEL_NVM_BUSY_MSK) != 0U) && (polls < 100U));
+
+  TEST_CHECK(polls == 31U);
+
+  /* A second command while busy is ignored */
+  Test_Setup(PMIC_MODEL_STPMIC25, 30U, 0U);
+  TEST_CHECK(PMIC_Model_Write(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_START, image, TEST_NVM_SIZE) == PMIC_MODEL_OK);
+  TEST_CHECK(PMIC_Model_Write(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_CR, &cmd, 1U) == PMIC_MODEL_OK);
+  test_time = 29999U;
+  TEST_CHECK(PMIC_Model_Write(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_CR, &cmd, 1U) == PMIC_MODEL_OK);
+  TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_SR, &status, 1U) == PMIC_MODEL_OK);
+  TEST_CHECK((status & PMIC_MODEL_NVM_BUSY_MSK) != 0U);
+  test_time = 30000U;
+  TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_SR, &status, 1U) == PMIC_MODEL_OK);
+  TEST_CHECK((status & PMIC_MODEL_NVM_BUSY_MSK) == 0U);
+
+  PMIC_Model_GetStats(&stats);
+  TEST_CHECK(stats.ProgCount == 1U);
+  TEST_CHECK(stats.BusyPolls == 1U);
+
+  /* A power cycle while busy loses the programming */
+  Test_Setup(PMIC_MODEL_STPMIC25, 30U, 0U);
+  TEST_CHECK(PMIC_Model_Write(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_START, image, TEST_NVM_SIZE) == PMIC_MODEL_OK);
+  TEST_CHECK(PMIC_Model_Write(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_CR, &cmd, 1U) == PMIC_MODEL_OK);
+  PMIC_Model_Reset();
+  test_time = 30000U;
+  TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_START, shadow, TEST_NVM_SIZE) == PMIC_MODEL_OK);
+  TEST_CHECK(shadow[0] == 0U);
+
+  /* The time wraps around */
+  Test_Setup(PMIC_MODEL_STPMIC25, 30U, 0U);
+  test_time = 0xFFFFFFFFU - 10000U;
+  TEST_CHECK(PMIC_Model_Write(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_CR, &cmd, 1U) == PMIC_MODEL_OK);
+  test_time += 29999U;
+  TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_SR, &status, 1U) == PMIC_MODEL_OK);
+  TEST_CHECK((status & PMIC_MODEL_NVM_BUSY_MSK) != 0U);
+  test_time += 1U;
+  TEST_CHECK(PMIC_Model_Read(PMIC_MODEL_I2C_ADDRESS, TEST_NVM_SR, &status, 1U) == PMIC_MODEL_OK);
+  TEST_CHECK((status & PMIC_MODEL_NVM_BUSY_MSK) == 0U);
+}
+
+/**
+  * @brief  Run the PMIC model tests.
+  * @param  None
+  * @retval 0 if all the tests passed.
+  */
+int main(void)
+{
+  Test_Detect();
+  Test_Program();
+  Test_Busy();
+
+  printf("%s pmic model\n", (fail == 0) ? "PASS" : "FAIL");
+
+  return (fail == 0) ? 0 : 1;
+}
@@ -0,0 +1,332 @@
+/**
+  ******************************************************************************
+  * @file    test_pmic_util.c
+  * @author  MCD Application Team
+  * @brief   Tests of the pmic utilities and of the pmic interface on the
+  *          emulated PMIC: bus transactions of the NVM burst read, of the
+  *          coalesced shadow write and of the cached read, bus speed fall
+  *          back on NACK, NVM programming wait and its timeout.
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include "pmic_interface.h"
+#include "pmic_emul.h"
+
+/* Private define ------------------------------------------------------------*/
+#define TEST_NVM_SIZE           40U   /* STPMIC25 NVM shadow registers */
+#define TEST_PROG_TIME          30U   /* NVM programming duration, in ms */
+
+/* Private macro -------------------------------------------------------------*/
+#define TEST_CHECK(cond)                                                        \
+  do                                                                            \
+  {                                                                             \
+    if (!(cond))                                                                \
+    {                                                                           \
+      printf("FAIL %s:%d: %s\n", __func__, __LINE__, #cond);                    \
+      fail++;                                                                   \
+    }                                                                           \
+  } while (0)
+
+/* Global variables ----------------------------------------------------------*/
+/* DFU PMIC partition descriptor, patched with the NVM image size */
+int8_t pmic_nvm_str[] = "@PMIC /0xF4/1*72Be";
+
+/* Private variables ---------------------------------------------------------*/
+static uint8_t test_image[PMIC_PROTOCOL_HEADER_SIZE + MAX_PMIC_NVM_SIZE];
+static uint8_t test_nvm[TEST_NVM_SIZE];
+static PMIC_Emul_StatsTypeDef test_stats;
+static int fail;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Configure the emulated PMIC, its NVM is kept.
+  * @param  Type: emulated PMIC
+  * @param  ProgramDelay: NVM programming duration in ms
+  * @param  NackCount: number of next transfers not acknowledged
+  * @retval None
+  */
+static void Test_Setup(uint32_t Type, uint32_t ProgramDelay, uint32_t NackCount)
+{
+  PMIC_Emul_ConfigTypeDef config = { Type, ProgramDelay, NackCount };
+
+  PMIC_Emul_Config(&config);
+  PMIC_Emul_ResetStats();
+}
+
+/**
+  * @brief  Get the bus transfers since the last call.
+  * @param  None
+  * @retval None
+  */
+static void Test_Stats(void)
+{
+  PMIC_Emul_GetStats(&test_stats);
+  PMIC_Emul_ResetStats();
+}
+
+/**
+  * @brief  No bus access until the PMIC partition is used.
+  * @param  None
+  * @retval None
+  */
+static void Test_Lazy(void)
+{
+  PMIC_Emul_Erase();
+  Test_Setup(PMIC_STPMIC25, TEST_PROG_TIME, 0U);
+
+  TEST_CHECK(OPENBL_PMIC_Get_NVM_Size() == MAX_PMIC_NVM_SIZE);
+  TEST_CHECK(memcmp(pmic_nvm_str, "@PMIC /0xF4/1*72Be", sizeof(pmic_nvm_str)) == 0);
+
+  Test_Stats();
+  TEST_CHECK((test_stats.ReadCount + test_stats.WriteCount + test_stats.NackCount) == 0U);
+}
+
+/**
+  * @brief  The NVM image is read in one burst, then served from the cache.
+  * @param  None
+  * @retval None
+  */
+static void Test_Read(void)
+{
+  pmic_context_t *ctx;
+
+  /* Detection, speed negotiation then the NVM burst read */
+  TEST_CHECK(OPENBL_PMIC_Read(test_image) == PMIC_ERROR_NONE);
+  Test_Stats();
+  TEST_CHECK(test_stats.ReadCount == 3U);
+  TEST_CHECK(test_stats.ReadBytes == (1U + 1U + TEST_NVM_SIZE));
+  TEST_CHECK(test_stats.WriteCount == 0U);
+
+  ctx = PMIC_Util_GetContext();
+  TEST_CHECK(ctx->Status == PMIC_ERROR_NONE);
+  TEST_CHECK(ctx->BusSpeed == PMIC_I2C_FAST_PLUS);
+  TEST_CHECK(OPENBL_PMIC_Get_NVM_Size() == TEST_NVM_SIZE);
+  TEST_CHECK(memcmp(pmic_nvm_str, "@PMIC /0xF4/1*48Be", sizeof(pmic_nvm_str)) == 0);
+
+  TEST_CHECK(test_image[0] == PMIC_PROTOCOL_VERSION);
+  TEST_CHECK(test_image[1] == 0x2U);
+  TEST_CHECK(test_image[3] == 0x1U);
+  TEST_CHECK(test_image[4] == (PMIC_I2C_ADDRESS >> 1));
+
+  /* Same image without bus access */
+  TEST_CHECK(OPENBL_PMIC_Read(test_image) == PMIC_ERROR_NONE);
+  Test_Stats();
+  TEST_CHECK((test_stats.ReadCount + test_stats.WriteCount) == 0U);
+
+  /* Refresh: one burst read again */
+  OPENBL_PMIC_Refresh();
+  TEST_CHECK(OPENBL_PMIC_Read(test_image) == PMIC_ERROR_NONE);
+  Test_Stats();
+  TEST_CHECK(test_stats.ReadCount == 1U);
+  TEST_CHECK(test_stats.ReadBytes == TEST_NVM_SIZE);
+
+  /* Refresh record received in place of an NVM image */
+  TEST_CHECK(OPENBL_PMIC_RefreshRecord((const uint8_t *)"SPR0", 4U) == PMIC_ERROR_INVALID_ARG);
+  TEST_CHECK(OPENBL_PMIC_RefreshRecord((const uint8_t *)"SPR1", 4U) == PMIC_ERROR_NONE);
+  TEST_CHECK(OPENBL_PMIC_Read(test_image) == PMIC_ERROR_NONE);
+  Test_Stats();
+  TEST_CHECK(test_stats.ReadCount == 1U);
+}
+
+/**
+  * @brief  Runs of changed registers are written in one transaction each.
+  * @param  None
+  * @retval None
+  */
+static void Test_Write(void)
+{
+  pmic_write_result_t result;
+
+  memset(test_nvm, 0, sizeof(test_nvm));
+  test_nvm[0] = 0x11U;
+  test_nvm[1] = 0x22U;
+  test_nvm[2] = 0x33U;
+  test_nvm[5] = 0x55U;
+  test_nvm[TEST_NVM_SIZE - 1U] = 0x99U;
+
+  TEST_CHECK(OPENBL_PMIC_Write(test_nvm) == PMIC_ERROR_NONE);
+  Test_Stats();
+
+  /* Shadow read, 3 runs, NVM program command, then read back and status polls */
+  TEST_CHECK(test_stats.WriteCount == 4U);
+  TEST_CHECK(test_stats.WriteBytes == (3U + 1U + 1U + 1U));
+  TEST_CHECK(test_stats.ProgCount == 1U);
+  TEST_CHECK(test_stats.ReadBytes == ((2U * TEST_NVM_SIZE) + (test_stats.ReadCount - 2U)));
+
+  PMIC_Util_GetWriteResult(&result);
+  TEST_CHECK(result.WriteCount == 3U);
+  TEST_CHECK(result.DirtyCount == 5U);
+  TEST_CHECK(result.DirtyMap == (0x27ULL | (1ULL << (TEST_NVM_SIZE - 1U))));
+  TEST_CHECK(result.ErrorMap == 0U);
+
+  /* The written image is read from the cache */
+  TEST_CHECK(OPENBL_PMIC_Read(test_image) == PMIC_ERROR_NONE);
+  Test_Stats();
+  TEST_CHECK((test_stats.ReadCount + test_stats.WriteCount) == 0U);
+  TEST_CHECK(memcmp(&test_image[PMIC_PROTOCOL_HEADER_SIZE], test_nvm, TEST_NVM_SIZE) == 0);
+
+  /* Nothing to write, only the NVM programming */
+  TEST_CHECK(OPENBL_PMIC_Write(test_nvm) == PMIC_ERROR_NONE);
+  Test_Stats();
+  TEST_CHECK(test_stats.WriteCount == 1U);
+  PMIC_Util_GetWriteResult(&result);
+  TEST_CHECK(result.WriteCount == 0U);
+
+  /* The NVM is kept over a power cycle */
+  PMIC_Emul_Reset();
+  OPENBL_PMIC_Refresh();
+  memset(test_image, 0, sizeof(test_image));
+  TEST_CHECK(OPENBL_PMIC_Read(test_image) == PMIC_ERROR_NONE);
+  TEST_CHECK(memcmp(&test_image[PMIC_PROTOCOL_HEADER_SIZE], test_nvm, TEST_NVM_SIZE) == 0);
+}
+
+/**
+  * @brief  The NVM programming is waited from its last measured duration.
+  * @param  None
+  * @retval None
+  */
+static void Test_Program(void)
+{
+  pmic_write_result_t result;
+  uint32_t start;
+  uint32_t run;
+
+  for (run = 0U; run < 3U; run++)
+  {
+    test_nvm[10]++;
+    start = PMIC_Emul_GetTime();
+    TEST_CHECK(OPENBL_PMIC_Write(test_nvm) == PMIC_ERROR_NONE);
+    Test_Stats();
+
+    /* Few status reads after 3/4 of the estimate, the duration is measured */
+    PMIC_Util_GetWriteResult(&result);
+    TEST_CHECK(test_stats.BusyPolls <= 4U);
+    TEST_CHECK(result.ProgTime >= TEST_PROG_TIME);
+    TEST_CHECK(result.ProgTime <= ((PMIC_Emul_GetTime() - start + 999U) / 1000U));
+    TEST_CHECK(OPENBL_PMIC_Get_Busy_Time() == result.ProgTime);
+  }
+
+  /* The estimate follows the NVM */
+  TEST_CHECK(OPENBL_PMIC_Get_Busy_Time() <= (TEST_PROG_TIME + 2U));
+}
+
+/**
+  * @brief  A NACK steps the bus speed down, a PMIC never answering fails.
+  * @param  None
+  * @retval None
+  */
+static void Test_FallBack(void)
+{
+  pmic_context_t *ctx = PMIC_Util_GetContext();
+
+  /* One NACK: the burst read is done again in Fast-mode */
+  Test_Setup(PMIC_STPMIC25, TEST_PROG_TIME, 1U);
+  OPENBL_PMIC_Refresh();
+  TEST_CHECK(OPENBL_PMIC_Read(test_image) == PMIC_ERROR_NONE);
+  Test_Stats();
+  TEST_CHECK(test_stats.NackCount == 1U);
+  TEST_CHECK(test_stats.ReadCount == 1U);
+  TEST_CHECK(ctx->BusSpeed == PMIC_I2C_FAST);
+  TEST_CHECK(memcmp(&test_image[PMIC_PROTOCOL_HEADER_SIZE], test_nvm, TEST_NVM_SIZE) == 0);
+
+  /* One more NACK: the write is done in Standard-mode */
+  Test_Setup(PMIC_STPMIC25, TEST_PROG_TIME, 1U);
+  test_nvm[20] = 0xA5U;
+  TEST_CHECK(OPENBL_PMIC_Write(test_nvm) == PMIC_ERROR_NONE);
+  Test_Stats();
+  TEST_CHECK(test_stats.NackCount == 1U);
+  TEST_CHECK(test_stats.ProgCount == 1U);
+  TEST_CHECK(ctx->BusSpeed == PMIC_I2C_STANDARD);
+
+  /* Always NACK: the read fails in Standard-mode, reported in the header */
+  Test_Setup(PMIC_STPMIC25, TEST_PROG_TIME, 1000U);
+  OPENBL_PMIC_Refresh();
+  TEST_CHECK(OPENBL_PMIC_Read(test_image) == PMIC_ERROR_I2C);
+  TEST_CHECK(test_image[1] == 0xFFU);
+  TEST_CHECK(ctx->BusSpeed == PMIC_I2C_STANDARD);
+  TEST_CHECK(OPENBL_PMIC_Write(test_nvm) == PMIC_ERROR_I2C);
+
+  /* Back to the fastest speed once detected again */
+  Test_Setup(PMIC_STPMIC25, TEST_PROG_TIME, 0U);
+  ctx = PMIC_Util_Redetect();
+  TEST_CHECK(ctx->Status == PMIC_ERROR_NONE);
+  TEST_CHECK(ctx->BusSpeed == PMIC_I2C_FAST_PLUS);
+}
+
+/**
+  * @brief  An NVM still busy after PMIC_SR_REG_TIMEOUT ms fails the write.
+  * @param  None
+  * @retval None
+  */
+static void Test_Timeout(void)
+{
+  pmic_write_result_t result;
+  uint32_t busy_time = OPENBL_PMIC_Get_Busy_Time();
+  uint32_t start;
+
+  Test_Setup(PMIC_STPMIC25, 2U * PMIC_SR_REG_TIMEOUT, 0U);
+  test_nvm[11]++;
+  start = PMIC_Emul_GetTime();
+  TEST_CHECK(OPENBL_PMIC_Write(test_nvm) == PMIC_ERROR_NVM_TIMEOUT);
+  Test_Stats();
+
+  /* Given up after the timeout, the polls back off */
+  PMIC_Util_GetWriteResult(&result);
+  TEST_CHECK(result.ProgTime >= PMIC_SR_REG_TIMEOUT);
+  TEST_CHECK((PMIC_Emul_GetTime() - start) < ((PMIC_SR_REG_TIMEOUT * 1000U) + PMIC_NVM_POLL_MAX_US + 1000U));
+  TEST_CHECK(test_stats.BusyPolls <= ((PMIC_SR_REG_TIMEOUT * 1000U) / PMIC_NVM_POLL_MAX_US) + 8U);
+
+  /* The estimate is only updated by a successful programming */
+  TEST_CHECK(OPENBL_PMIC_Get_Busy_Time() == busy_time);
+}
+
+/**
+  * @brief  Without PMIC the header reports it, the write fails.
+  * @param  None
+  * @retval None
+  */
+static void Test_NoPmic(void)
+{
+  pmic_context_t *ctx;
+
+  Test_Setup(PMIC_MAX, TEST_PROG_TIME, 0U);
+  ctx = PMIC_Util_Redetect();
+  TEST_CHECK(ctx->Status == PMIC_ERROR_NO_PMIC);
+  TEST_CHECK(ctx->BusSpeed == PMIC_I2C_STANDARD);
+
+  TEST_CHECK(OPENBL_PMIC_Read(test_image) == PMIC_ERROR_NONE);
+  TEST_CHECK(test_image[0] == PMIC_PROTOCOL_VERSION);
+  TEST_CHECK(test_image[1] == 0xFFU);
+}
+
+/**
+  * @brief  Run the pmic utilities tests.
+  * @param  None
+  * @retval 0 if all the tests passed.
+  */
+int main(void)
+{
+  Test_Lazy();
+  Test_Read();
+  Test_Write();
+  Test_Program();
+  Test_FallBack();
+  Test_Timeout();
+  Test_NoPmic();
+
+  printf("%s pmic utilities\n", (fail == 0) ? "PASS" : "FAIL");
+
+  return (fail == 0) ? 0 : 1;
+}
@@ -0,0 +1,185 @@
+/**
+  ******************************************************************************
+  * @file    test_sha256.c
+  * @author  MCD Application Team
+  * @brief   Known answer tests of the software SHA-256 (FIPS 180-4 vectors)
+  ******************************************************************************
+  * @attention
+  *
+  * Copyright (c) 2024 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include "sha256_util.h"
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  const char *Name;
+  const char *Message;
+  uint32_t Repeat;      /* Number of times the message is fed */
+  uint8_t Digest[SHA256_DIGEST_SIZE];
+} Test_Sha256VectorTypeDef;
+
+/* Private variables ---------------------------------------------------------*/
+static const Test_Sha256VectorTypeDef Vectors[] =
+{
+  {
+    "empty", "", 1U,
+    {
+      0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+      0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55
+    }
+  },
+  {
+    "abc", "abc", 1U,
+    {
+      0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+      0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad
+    }
+  },
+  {
+    "448 bits", "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1U,
+    {
+      0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+      0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1
+    }
+  },
+  {
+    "896 bits", "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqr"
+    "lmnopqrsmnopqrstnopqrstu", 1U,
+    {
+      0xcf, 0x5b, 0x16, 0xa7, 0x78, 0xaf, 0x83, 0x80, 0x03, 0x6c, 0xe5, 0x9e, 0x7b, 0x04, 0x92, 0x37,
+      0x0b, 0x24, 0x9b, 0x11, 0xe8, 0xf0, 0x7a, 0x51, 0xaf, 0xac, 0x45, 0x03, 0x7a, 0xfe, 0xe9, 0xd1
+    }
+  },
+  {
+    "million a", "aaaaaaaaaa", 100000U,
+    {
+      0xcd, 0xc7, 0x6e, 0x5c, 0x99, 0x14, 0xfb, 0x92, 0x81, 0xa1, 0xc7, 0xe2, 0x84, 0xd7, 0x3e, 0x67,
+      0xf1, 0x80, 0x9a, 0x48, 0xa4, 0x97, 0x20, 0x0e, 0x04, 0x6d, 0x39, 0xcc, 0xc7, 0x11, 0x2c, 0xd0
+    }
+  }
+};
+
+/* Private functions ---------------------------------------------------------*/
+/**
+  * @brief  Compare a digest with the expected one.
+  * @param  pName: name of the test
+  * @param  pDigest: computed digest
+  * @param  pExpected: expected digest
+  * @retval 0 if equal, 1 otherwise.
+  */
+static int Test_Check(const char *pName, const uint8_t *pDigest, const uint8_t *pExpected)
+{
+  if (memcmp(pDigest, pExpected, SHA256_DIGEST_SIZE) != 0)
+  {
+    printf("FAIL %s\n", pName);
+    return 1;
+  }
+
+  printf("PASS %s\n", pName);
+  return 0;
+}
+
+/**
+  * @brief  Known answer tests fed in one piece, then byte per byte.
+  * @param  None
+  * @retval Number of failures.
+  */
+static int Test_Vectors(void)
+{
+  SHA256_Util_ContextTypeDef ctx;
+  uint8_t digest[SHA256_DIGEST_SIZE];
+  uint32_t size;
+  uint32_t idx;
+  uint32_t rep;
+  int fail = 0;
+
+  for (idx = 0U; idx < (sizeof(Vectors) / sizeof(Vectors[0])); idx++)
+  {
+    size = (uint32_t)strlen(Vectors[idx].Message);
+
+    SHA256_Util_Init(&ctx);
+    for (rep = 0U; rep < Vectors[idx].Repeat; rep++)
+    {
+      SHA256_Util_Update(&ctx, (const uint8_t *)Vectors[idx].Message, size);
+    }
+    SHA256_Util_Final(&ctx, digest);
+    fail += Test_Check(Vectors[idx].Name, digest, Vectors[idx].Digest);
+
+    /* Same message split on every byte boundary */
+    if (Vectors[idx].Repeat == 1U)
+    {
+      uint32_t pos;
+
+      SHA256_Util_Init(&ctx);
+      for (pos = 0U; pos < size; pos++)
+      {
+        SHA256_Util_Update(&ctx, (const uint8_t *)&Vectors[idx].Message[pos], 1U);
+      }
+      SHA256_Util_Final(&ctx, digest);
+      fail += Test_Check(Vectors[idx].Name, digest, Vectors[idx].Digest);
+    }
+  }
+
+  return fail;
+}
+
+/**
+  * @brief  Word feed, as done for the otp values, against the byte feed.
+  * @param  None
+  * @retval Number of failures.
+  */
+static int Test_Words(void)
+{
+  SHA256_Util_ContextTypeDef ctx;
+  uint8_t digest[SHA256_DIGEST_SIZE];
+  uint8_t expected[SHA256_DIGEST_SIZE];
+  uint8_t bytes[4U * 97U];
+  uint32_t word;
+  uint32_t idx;
+
+  /* The words are hashed most significant byte first, as the HASH peripheral without swap */
+  SHA256_Util_Init(&ctx);
+  for (idx = 0U; idx < 97U; idx++)
+  {
+    word = (idx * 0x9E3779B9U) ^ 0xA5A5A5A5U;
+    bytes[(4U * idx) + 0U] = (uint8_t)(word >> 24);
+    bytes[(4U * idx) + 1U] = (uint8_t)(word >> 16);
+    bytes[(4U * idx) + 2U] = (uint8_t)(word >> 8);
+    bytes[(4U * idx) + 3U] = (uint8_t)(word >> 0);
+    SHA256_Util_UpdateWord(&ctx, word);
+  }
+  SHA256_Util_Final(&ctx, digest);
+
+  SHA256_Util_Init(&ctx);
+  SHA256_Util_Update(&ctx, bytes, sizeof(bytes));
+  SHA256_Util_Final(&ctx, expected);
+
+  return Test_Check("words", digest, expected);
+}
+
+/**
+  * @brief  Run the SHA-256 tests.
+  * @param  None
+  * @retval 0 if all the tests passed.
+  */
+int main(void)
+{
+  int fail = 0;
+
+  fail += Test_Vectors();
+  fail += Test_Words();
+
+  return (fail == 0) ? 0 : 1;
+}
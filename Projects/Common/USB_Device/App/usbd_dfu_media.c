@@ -24,6 +24,7 @@
 #include "openbl_mem.h"
 #include "usbd_dfu_media.h"
 /* USER CODE BEGIN Includes */
+#include "pmic_interface.h"
 
 /* USER CODE END Includes */
 
@@ -32,7 +33,8 @@
 #define VIRTUAL_DESC_STR    "@virtual /0xF1/1*512Be"
 #define VIRTUAL_DESC_SIZE    (512)
 extern USBD_HandleTypeDef hUsbDeviceHS;
-int8_t pmic_nvm_str[] = "@PMIC /0xF4/1*08Be";
+/* Largest NVM image (MAX_PMIC_NVM_SIZE + PMIC_PROTOCOL_HEADER_SIZE) until the PMIC is detected on its first use */
+int8_t pmic_nvm_str[] = "@PMIC /0xF4/1*72Be";
 
 /* USER CODE END PV */
 
@@ -42,6 +44,7 @@ static uint16_t USB_DFU_If_Init(void);
 static uint16_t USB_DFU_If_Write(uint8_t *pSrc, uint32_t alt, uint32_t Len, uint32_t BlockNumber);
 static uint8_t *USB_DFU_If_Read(uint32_t alt, uint8_t *pDest, uint32_t Len, uint32_t BlockNumber);
 static uint16_t USB_DFU_If_DeInit(void);
+static uint16_t USB_DFU_If_GetStatus(uint32_t alt, uint8_t Cmd, uint8_t *buffer);
 static inline uint32_t USBD_DFU_GetPartSize(uint8_t alt, uint32_t blocknumber);
 USBD_DFU_MediaTypeDef USBD_DFU_MEDIA_fops =
 {
@@ -51,7 +54,7 @@ USBD_DFU_MediaTypeDef USBD_DFU_MEDIA_fops =
   NULL,
   USB_DFU_If_Write,
   USB_DFU_If_Read,
-  NULL
+  USB_DFU_If_GetStatus
 
 };
 
@@ -60,13 +63,11 @@ USBD_DFU_MediaTypeDef USBD_DFU_MEDIA_fops =
   * @param  src: Pointer to the source buffer. Address to be written to.
   * @param  dest: Pointer to the destination buffer.
   * @param  Len: Number of data to be written (in bytes).
-  * @retval USBD_OK if operation is successful, MAL_FAIL else.
+  * @retval USBD_OK if operation is successful, the DFU error status else.
   */
 uint16_t USB_DFU_If_Write(uint8_t *pSrc, uint32_t alt, uint32_t Len, uint32_t BlockNumber)
 {
-  OPENBL_USB_Download(pSrc, alt, Len, BlockNumber);
-
-  return 0;
+  return OPENBL_USB_Download(pSrc, alt, Len, BlockNumber);
 }
 
 /**
@@ -90,6 +91,40 @@ uint8_t *USB_DFU_If_Read(uint32_t alt, uint8_t *pDest, uint32_t Len, uint32_t Bl
   return OPENBL_USB_ReadMemory(alt, pDest, Len, BlockNumber);
 }
 
+/**
+  * @brief  Get the expected duration of the memory operation.
+  * @param  alt: USB Alternate.
+  * @param  Cmd: DFU_MEDIA_PROGRAM or DFU_MEDIA_ERASE.
+  * @param  buffer: DFU status, bytes 1 to 3 get the poll timeout in ms.
+  * @retval USBD_OK if operation is successful, MAL_FAIL else.
+  */
+uint16_t USB_DFU_If_GetStatus(uint32_t alt, uint8_t Cmd, uint8_t *buffer)
+{
+  USBD_DFU_HandleTypeDef *hdfu = (USBD_DFU_HandleTypeDef *)hUsbDeviceHS.pClassDataCmsit[0];
+  uint32_t timeout = 0U;
+
+  if (Cmd == DFU_MEDIA_PROGRAM)
+  {
+    /* The received block is processed after this status */
+    timeout = OPENBL_USB_GetBusyTime(alt, hdfu->buffer.d8, hdfu->wlength, hdfu->wblock_num);
+  }
+
+  buffer[1] = (uint8_t)timeout;
+  buffer[2] = (uint8_t)(timeout >> 8);
+  buffer[3] = (uint8_t)(timeout >> 16);
+
+  return 0;
+}
+
+/**
+  * @brief  PMIC partition descriptor string, sized once the PMIC is detected.
+  * @retval Pointer to the descriptor string.
+  */
+int8_t *USBD_DFU_GetPmicDescStr(void)
+{
+  return pmic_nvm_str;
+}
+
 /**
   * @brief  Memory initialization routine.
   * @retval USBD_OK if operation is successful, MAL_FAIL else.
@@ -130,7 +165,10 @@ static inline uint32_t USBD_DFU_GetPartSize(uint8_t alt, uint32_t blocknumber)
 					  part_size = OTP_DESC_PARTSIZE;
 					  break;
 				  case 5:
-					  part_size = ((pmic_nvm_str[14] - 0x30) * 10) + (pmic_nvm_str[15] - 0x30);
+					  part_size = OPENBL_PMIC_Get_NVM_Size() + PMIC_PROTOCOL_HEADER_SIZE;
+					  break;
+				  case 6:
+					  part_size = STREAM_DESC_PARTSIZE;
 					  break;
 
 				  default:
@@ -76,6 +76,7 @@
  /** @defgroup USBD_MEDIA_Exported_FunctionsPrototype
    * @{
    */
+ int8_t *USBD_DFU_GetPmicDescStr(void);
 
 
  /**
@@ -19,6 +19,9 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "stm32mp13xx_it.h"
+#if defined(__CONSOLE__)
+#include "console_util.h"
+#endif /* __CONSOLE__ */
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
@@ -85,3 +88,15 @@ void OTG_IRQHandler(void)
   HAL_PCD_IRQHandler(&hpcd);
 }
 #endif
+
+#if defined(__CONSOLE__)
+/**
+  * @brief  This function handles the console UART interrupt request.
+  * @param  None
+  * @retval None
+  */
+void USARTx_IRQHandler(void)
+{
+  Serial_IRQHandler();
+}
+#endif /* __CONSOLE__ */
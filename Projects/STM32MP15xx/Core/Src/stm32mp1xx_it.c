@@ -19,6 +19,9 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "stm32mp1xx_it.h"
+#if defined(__CONSOLE__)
+#include "console_util.h"
+#endif /* __CONSOLE__ */
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
@@ -86,4 +89,16 @@ void OTG_IRQHandler(void)
 }
 #endif
 
+#if defined(__CONSOLE__)
+/**
+  * @brief  This function handles the console UART interrupt request.
+  * @param  None
+  * @retval None
+  */
+void USARTx_IRQHandler(void)
+{
+  Serial_IRQHandler();
+}
+#endif /* __CONSOLE__ */
+
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -19,6 +19,9 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "stm32mp2xx_it.h"
+#if defined(__CONSOLE__)
+#include "console_util.h"
+#endif /* __CONSOLE__ */
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
@@ -83,4 +86,16 @@ void USB3DR_IRQHandler(void)
 }
 #endif
 
+#if defined(__CONSOLE__)
+/**
+  * @brief  This function handles the console UART interrupt request.
+  * @param  None
+  * @retval None
+  */
+void USARTx_IRQHandler(void)
+{
+  Serial_IRQHandler();
+}
+#endif /* __CONSOLE__ */
+
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
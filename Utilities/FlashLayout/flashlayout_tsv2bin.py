@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 STMicroelectronics.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Convert a TSV flashlayout into the binary flashlayout format loaded by the
+# OpenBootloader without text parsing (see load_flash_layout_bin()).
+#
+# Layout, little-endian:
+#   header : magic "SFL1" (u32), version (u8), entry count (u8),
+#            reserved (u16), CRC-32 of the entries (u32)
+#   entry  : id (u8), opt flags (u8), type index (u8), ip index (u8),
+#            offset (u32), name (8 bytes, null padded)
+import argparse
+import struct
+import sys
+import zlib
+
+FLASHLAYOUT_BIN_MAGIC = 0x314C4653
+FLASHLAYOUT_BIN_VERSION = 0x01
+FLASHLAYOUT_BIN_NAME_SIZE = 8
+FLASHLAYOUT_MAX_ENTRIES = 0x0F
+
+OPT_FLAGS = {'P': 0x01, 'D': 0x02, 'E': 0x04}
+TYPES = ['Binary', 'System', 'FileSystem', 'RawImage', 'ENV']
+IPS = ['none', 'nor', 'nand', 'spi-nand', 'mmc0', 'mmc1', 'mmc2']
+
+
+def _parse_opt(opt):
+    flags = 0
+    if opt == '-':
+        return flags
+    for c in opt:
+        if c not in OPT_FLAGS:
+            raise ValueError("unsupported option '%s'" % opt)
+        flags |= OPT_FLAGS[c]
+    return flags
+
+
+def _parse_index(value, table, what):
+    if value not in table:
+        raise ValueError("unsupported %s '%s'" % (what, value))
+    return table.index(value)
+
+
+def convert(tsv_lines):
+    entries = b''
+    count = 0
+    for lineno, line in enumerate(tsv_lines, 1):
+        line = line.rstrip('\r\n')
+        if not line or line.startswith('#'):
+            continue
+        fields = line.split('\t')
+        if len(fields) < 6:
+            raise ValueError("line %d: expected at least 6 columns" % lineno)
+        opt, pid, name, ptype, ip, offset = fields[:6]
+        name = name.encode('ascii')
+        if len(name) > FLASHLAYOUT_BIN_NAME_SIZE:
+            print("line %d: name '%s' truncated to %d characters"
+                  % (lineno, name.decode(), FLASHLAYOUT_BIN_NAME_SIZE), file=sys.stderr)
+            name = name[:FLASHLAYOUT_BIN_NAME_SIZE]
+        try:
+            entries += struct.pack('<BBBBI8s',
+                                   int(pid, 0),
+                                   _parse_opt(opt),
+                                   _parse_index(ptype, TYPES, 'type'),
+                                   _parse_index(ip, IPS, 'ip'),
+                                   int(offset, 0),
+                                   name)
+        except (ValueError, struct.error) as err:
+            raise ValueError("line %d: %s" % (lineno, err))
+        count += 1
+
+    if count > FLASHLAYOUT_MAX_ENTRIES:
+        raise ValueError("too many entries (%d, max %d)" % (count, FLASHLAYOUT_MAX_ENTRIES))
+
+    header = struct.pack('<IBBHI', FLASHLAYOUT_BIN_MAGIC, FLASHLAYOUT_BIN_VERSION,
+                         count, 0, zlib.crc32(entries) & 0xFFFFFFFF)
+    return header + entries
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a TSV flashlayout into a binary flashlayout")
+    parser.add_argument('-i', '--tsv_file', help='input TSV flashlayout', required=True)
+    parser.add_argument('-o', '--out_file', help='output binary flashlayout', required=True)
+    args = parser.parse_args()
+
+    with open(args.tsv_file, 'r') as f:
+        lines = f.readlines()
+
+    try:
+        data = convert(lines)
+    except ValueError as err:
+        print("%s: %s" % (args.tsv_file, err), file=sys.stderr)
+        return 1
+
+    with open(args.out_file, 'wb') as f:
+        f.write(data)
+
+    print("%s: %d bytes written" % (args.out_file, len(data)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())